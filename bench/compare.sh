@@ -0,0 +1,18 @@
+# Compares two tables written by ising-bench, e.g. from the builds before and after a change:
+#   bench/compare.sh old.dat new.dat
+# Prints the operations per second of every benchmark in both tables and their ratio, marking ratios
+# below 0.9 as regressions.
+
+if [ $# -ne 2 ]
+then
+	echo "Usage: $0 OLD NEW"
+	exit 1
+fi
+
+# Read the rates of the old table indexed by benchmark, size and parameter, then print each new line with them.
+awk 'FNR == NR && !/^#/ { old[$1" "$2" "$3] = $7; next }
+	 /^#/ { next }
+	 ($1" "$2" "$3) in old {
+		 ratio = $7 / old[$1" "$2" "$3]
+		 printf "%-26s %10s %10s %14.4g %14.4g %8.3f%s\n", $1, $2, $3, old[$1" "$2" "$3], $7, ratio, (ratio < 0.9 ? "  REGRESSION" : "")
+	 }' "$1" "$2"
@@ -0,0 +1,555 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include "SpinLattice2D.hpp"
+#include "PackedSpinLattice2D.hpp"
+#include "ByteSpinLattice2D.hpp"
+#include "BoltzmannTable.hpp"
+#include "glauberDynamics.hpp"
+#include "KawasakiDynamics.hpp"
+#include "NFoldWayDynamics.hpp"
+#include "CheckerboardSweeper.hpp"
+#include "TiledSweeper.hpp"
+#include "DataArray.hpp"
+#include "Susceptibility.hpp"
+#include "jackKnife.hpp"
+#include "bootstrap.hpp"
+#include "randomEngines.hpp"
+#include "Timer.hpp"
+
+/**
+ *\file
+ *\brief Microbenchmarks of the lattice updates and the analysis of the samples.
+ *
+ * Every benchmark is repeated until it has run for at least the minimum time and is written as one line of a
+ * whitespace separated table, so the tables of two builds can be compared with bench/compare.sh. The updates
+ * are run on square lattices from ones that fit in the L1 cache to ones that only fit in main memory, below,
+ * at and above the critical temperature. The lattices start ordered below the critical temperature and random
+ * above it, from the same seed every time, so the numbers of accepted flips are reproducible. The analysis is
+ * run on synthetic correlated samples of increasing length.
+ *
+ * With --tiles only the tiled sweeps are run, at the critical temperature for every tile size on lattices from
+ * 64 to 16384 sites each way, next to random site Glauber and random bond Kawasaki updates of the same lattices.
+ *
+ * ising-bench [--quick] [--tiles] [--rng minstd|xoshiro|philox] [--min-time SECONDS]
+ */
+namespace
+{
+	/// Critical temperature of the square lattice Ising model with J = K_B = 1.
+	const double criticalTemperature = 2.0 / std::log(1.0 + std::sqrt(2.0));
+
+	/// Seed of every engine, fixed so the work done is the same in every build.
+	const unsigned int seed = 1;
+
+	/**
+	 *\brief The choices made on the command line.
+	 */
+	struct Options
+	{
+		/// Lattice sizes (rows and columns) of the update benchmarks.
+		std::vector<int> sizes;
+
+		/// Largest lattice size for dynamics that keep per site lists, which would not fit in memory beyond it.
+		int largestListedSize;
+
+		/// Temperatures of the update benchmarks.
+		std::vector<double> temperatures;
+
+		/// Whether only the tiled sweeps are compared with random updates.
+		bool tiles;
+
+		/// Tile sizes of the tiled sweeps compared with --tiles, the whole lattice is always added.
+		std::vector<int> tileSizes;
+
+		/// Numbers of samples of the analysis benchmarks.
+		std::vector<int> sampleCounts;
+
+		/// Minimum time each benchmark runs for in seconds.
+		double minTime;
+
+		/// Name of the engine used by the updates.
+		std::string engineName;
+	};
+
+	/**
+	 *\brief Prints the header of the table.
+	 *\param out the stream to print to.
+	 *\param options the options the benchmarks were run with.
+	 */
+	void printHeader(std::ostream &out, const Options &options)
+	{
+		out << "# Random-Engine: " << options.engineName << '\n';
+		out << "# Minimum-Time(s): " << options.minTime << '\n';
+		out << "# size is the number of rows and columns of the lattice or the number of samples. parameter is the\n";
+		out << "# temperature of the updates (the tile size with --tiles, 0 for random updates), the block length of\n";
+		out << "# bootstrap, the bins of jack-knife or the last lag of auto-correlation. operations are attempted flips\n";
+		out << "# or swaps for the updates and sites or samples otherwise.\n";
+		out << "# benchmark size parameter operations accepted seconds operations/s accepted/s\n";
+	}
+
+	/**
+	 *\brief Runs a benchmark until it has taken at least the minimum time and prints its line of the table.
+	 *\param out the stream to print to.
+	 *\param name the name of the benchmark.
+	 *\param size the lattice size or number of samples.
+	 *\param parameter the temperature or other parameter of the benchmark.
+	 *\param minTime the minimum time to run for in seconds.
+	 *\param step callable performing one step of the benchmark, adding the operations it did and the flips it
+	 * accepted to its two long long reference arguments.
+	 */
+	template<class Step>
+	void measure(std::ostream &out, const std::string &name, long long size, double parameter, double minTime, Step step)
+	{
+		long long operations = 0;
+		long long accepted = 0;
+		Timer timer;
+		do
+		{
+			step(operations, accepted);
+		}
+		while(timer.elapsed() < minTime);
+		double seconds = timer.elapsed();
+
+		out << name << ' ' << size << ' ' << parameter << ' ' << operations << ' ' << accepted << ' '
+			<< seconds << ' ' << operations / seconds << ' ' << accepted / seconds << std::endl;
+	}
+
+	/**
+	 *\brief Creates the starting lattice of the update benchmarks.
+	 *\param size the number of rows and columns.
+	 *\param temperature the temperature, the lattice is random above the critical temperature.
+	 *\return the lattice.
+	 */
+	SpinLattice2D startingLattice(int size, double temperature)
+	{
+		SpinLattice2D lattice(size, size);
+		if(temperature > criticalTemperature)
+		{
+			std::default_random_engine generator(seed);
+			lattice.randomise(generator);
+		}
+		return lattice;
+	}
+
+	/**
+	 *\brief Benchmarks every update of the ordinary lattice and the multi-spin and vector kernels.
+	 *\param out the stream to print to.
+	 *\param options the options the benchmarks are run with.
+	 */
+	template<class Engine>
+	void benchmarkUpdates(std::ostream &out, const Options &options)
+	{
+		for(const auto& size : options.sizes)
+		{
+			for(const auto& temperature : options.temperatures)
+			{
+				BoltzmannTable boltzmannTable(1.0, 1.0, temperature);
+				int sites = size * size;
+
+				// Random site updates are timed in chunks of at most 2^16 so small and large lattices are
+				// measured alike.
+				int chunk = std::min(sites, 1 << 16);
+				{
+					SpinLattice2D lattice = startingLattice(size, temperature);
+					Engine generator(seed);
+					measure(out, "glauber", size, temperature, options.minTime, [&](long long &operations, long long &accepted)
+					{
+						for(int update = 0; update < chunk; ++update)
+						{
+							accepted += glauberDynamics(lattice, generator, boltzmannTable);
+						}
+						operations += chunk;
+					});
+				}
+
+				// The conserved dynamics start from a random lattice at every temperature, an ordered one has
+				// no opposite spins to swap.
+				for(int local = 0; local < 2 && size <= options.largestListedSize; ++local)
+				{
+					SpinLattice2D lattice(size, size);
+					std::default_random_engine startGenerator(seed);
+					lattice.randomise(startGenerator);
+					KawasakiDynamics kawasakiDynamics(lattice, local, 1.0, 1.0, temperature);
+					Engine generator(seed);
+					measure(out, local ? "kawasaki-local" : "kawasaki", size, temperature, options.minTime, [&](long long &operations, long long &accepted)
+					{
+						for(int update = 0; update < chunk; ++update)
+						{
+							accepted += kawasakiDynamics.update(lattice, generator, boltzmannTable);
+						}
+						operations += chunk;
+					});
+				}
+
+				// Tiled sweeps with the default tile size, the Kawasaki sweeps propose a swap across the two bonds
+				// to the right of and below every site.
+				{
+					SpinLattice2D lattice = startingLattice(size, temperature);
+					TiledSweeper sweeper(TiledSweeper::defaultTileSize);
+					Engine generator(seed);
+					measure(out, "tiled", size, temperature, options.minTime, [&](long long &operations, long long &accepted)
+					{
+						accepted += sweeper.glauberSweep(lattice, generator, boltzmannTable);
+						operations += sites;
+					});
+				}
+				{
+					SpinLattice2D lattice(size, size);
+					std::default_random_engine startGenerator(seed);
+					lattice.randomise(startGenerator);
+					TiledSweeper sweeper(TiledSweeper::defaultTileSize);
+					Engine generator(seed);
+					measure(out, "kawasaki-tiled", size, temperature, options.minTime, [&](long long &operations, long long &accepted)
+					{
+						accepted += sweeper.kawasakiSweep(lattice, generator, boltzmannTable);
+						operations += 2LL * sites;
+					});
+				}
+
+				// The n-fold way is rejection-free, its operations are the flips ordinary Glauber dynamics would
+				// have attempted in the same physical time.
+				if(size <= options.largestListedSize)
+				{
+					SpinLattice2D lattice = startingLattice(size, temperature);
+					NFoldWayDynamics nFoldWayDynamics(lattice, boltzmannTable);
+					Engine generator(seed);
+					double time = 0;
+					measure(out, "n-fold-way", size, temperature, options.minTime, [&](long long &operations, long long &accepted)
+					{
+						time += 1.0;
+						accepted += nFoldWayDynamics.advance(lattice, generator, time);
+						operations += sites;
+					});
+				}
+
+				{
+					SpinLattice2D lattice = startingLattice(size, temperature);
+					CheckerboardSweeper<Engine> sweeper(size, seed, 1);
+					measure(out, "checkerboard", size, temperature, options.minTime, [&](long long &operations, long long &accepted)
+					{
+						accepted += sweeper.sweep(lattice, boltzmannTable);
+						operations += sites;
+					});
+				}
+
+				{
+					PackedSpinLattice2D lattice(startingLattice(size, temperature));
+					Engine generator(seed);
+					measure(out, "multi-spin", size, temperature, options.minTime, [&](long long &operations, long long &accepted)
+					{
+						accepted += lattice.sweep(generator, boltzmannTable);
+						operations += sites;
+					});
+				}
+
+				const ByteSpinLattice2D::Kernel kernels[] = {ByteSpinLattice2D::Scalar, ByteSpinLattice2D::Avx2, ByteSpinLattice2D::Avx512};
+				for(const auto& kernel : kernels)
+				{
+					if(!ByteSpinLattice2D::kernelSupported(kernel))
+					{
+						continue;
+					}
+
+					ByteSpinLattice2D lattice(size, size, kernel);
+					if(temperature > criticalTemperature)
+					{
+						std::default_random_engine startGenerator(seed);
+						lattice.randomise(startGenerator);
+					}
+					Engine generator(seed);
+					measure(out, std::string("simd-") + ByteSpinLattice2D::kernelName(kernel), size, temperature, options.minTime,
+							[&](long long &operations, long long &accepted)
+					{
+						accepted += lattice.sweep(generator, boltzmannTable);
+						operations += sites;
+					});
+				}
+			}
+		}
+	}
+
+	/**
+	 *\brief Compares tiled sweeps of every tile size with random site Glauber and random bond Kawasaki updates.
+	 *
+	 * Every lattice starts random, as the Kawasaki dynamics need opposite spins, and is updated at the first
+	 * temperature. The random updates are written with tile size 0.
+	 *
+	 *\param out the stream to print to.
+	 *\param options the options the benchmarks are run with.
+	 */
+	template<class Engine>
+	void benchmarkTiles(std::ostream &out, const Options &options)
+	{
+		double temperature = options.temperatures.front();
+		BoltzmannTable boltzmannTable(1.0, 1.0, temperature);
+		for(const auto& size : options.sizes)
+		{
+			SpinLattice2D startLattice(size, size);
+			std::default_random_engine startGenerator(seed);
+			startLattice.randomise(startGenerator);
+			int sites = size * size;
+			int chunk = std::min(sites, 1 << 16);
+
+			{
+				SpinLattice2D lattice = startLattice;
+				Engine generator(seed);
+				measure(out, "random-glauber", size, 0, options.minTime, [&](long long &operations, long long &accepted)
+				{
+					for(int update = 0; update < chunk; ++update)
+					{
+						accepted += glauberDynamics(lattice, generator, boltzmannTable);
+					}
+					operations += chunk;
+				});
+			}
+
+			if(size <= options.largestListedSize)
+			{
+				SpinLattice2D lattice = startLattice;
+				KawasakiDynamics kawasakiDynamics(lattice, true, 1.0, 1.0, temperature);
+				Engine generator(seed);
+				measure(out, "random-kawasaki-local", size, 0, options.minTime, [&](long long &operations, long long &accepted)
+				{
+					for(int update = 0; update < chunk; ++update)
+					{
+						accepted += kawasakiDynamics.update(lattice, generator, boltzmannTable);
+					}
+					operations += chunk;
+				});
+			}
+
+			// A tile as large as the lattice is an ordinary sequential checkerboard sweep.
+			std::vector<int> tileSizes;
+			for(const auto& tileSize : options.tileSizes)
+			{
+				if(tileSize < size)
+				{
+					tileSizes.push_back(tileSize);
+				}
+			}
+			tileSizes.push_back(size);
+
+			for(const auto& tileSize : tileSizes)
+			{
+				TiledSweeper sweeper(tileSize);
+				{
+					SpinLattice2D lattice = startLattice;
+					Engine generator(seed);
+					measure(out, "tiled-glauber", size, tileSize, options.minTime, [&](long long &operations, long long &accepted)
+					{
+						accepted += sweeper.glauberSweep(lattice, generator, boltzmannTable);
+						operations += sites;
+					});
+				}
+				{
+					SpinLattice2D lattice = startLattice;
+					Engine generator(seed);
+					measure(out, "tiled-kawasaki", size, tileSize, options.minTime, [&](long long &operations, long long &accepted)
+					{
+						accepted += sweeper.kawasakiSweep(lattice, generator, boltzmannTable);
+						operations += 2LL * sites;
+					});
+				}
+			}
+		}
+	}
+
+	/**
+	 *\brief Runs the update benchmarks chosen by the options with an engine.
+	 *\param out the stream to print to.
+	 *\param options the options the benchmarks are run with.
+	 */
+	template<class Engine>
+	void benchmarkEngine(std::ostream &out, const Options &options)
+	{
+		if(options.tiles)
+		{
+			benchmarkTiles<Engine>(out, options);
+		}
+		else
+		{
+			benchmarkUpdates<Engine>(out, options);
+		}
+	}
+
+	/**
+	 *\brief Benchmarks the observables of the ordinary lattice, the running totals and the full passes checking them.
+	 *\param out the stream to print to.
+	 *\param options the options the benchmarks are run with.
+	 */
+	void benchmarkObservables(std::ostream &out, const Options &options)
+	{
+		// The sums stop the calls being optimised away.
+		volatile double sink = 0;
+		for(const auto& size : options.sizes)
+		{
+			SpinLattice2D lattice = startingLattice(size, 2.0 * criticalTemperature);
+			int sites = size * size;
+			measure(out, "lattice-energy", size, 0, options.minTime, [&](long long &operations, long long &)
+			{
+				for(int call = 0; call < 1024; ++call)
+				{
+					sink = sink + lattice.latticeEnergy(1.0);
+				}
+				operations += 1024;
+			});
+			measure(out, "total-mag", size, 0, options.minTime, [&](long long &operations, long long &)
+			{
+				for(int call = 0; call < 1024; ++call)
+				{
+					sink = sink + lattice.totalMag();
+				}
+				operations += 1024;
+			});
+			measure(out, "recompute-lattice-energy", size, 0, options.minTime, [&](long long &operations, long long &)
+			{
+				sink = sink + lattice.recomputeLatticeEnergy(1.0);
+				operations += sites;
+			});
+			measure(out, "recompute-total-mag", size, 0, options.minTime, [&](long long &operations, long long &)
+			{
+				sink = sink + lattice.recomputeTotalMag();
+				operations += sites;
+			});
+		}
+	}
+
+	/**
+	 *\brief Creates correlated samples like those of a simulation, an AR(1) process with autocorrelation time around 10.
+	 *\param count the number of samples.
+	 *\return the samples.
+	 */
+	DataArray correlatedSamples(int count)
+	{
+		std::default_random_engine generator(seed);
+		std::normal_distribution<double> distribution(0.0, 1.0);
+		DataArray samples;
+		samples.reserve(count);
+		double sample = 0;
+		for(int index = 0; index < count; ++index)
+		{
+			sample = 0.9 * sample + distribution(generator);
+			samples.push_back(sample - 1000.0);
+		}
+		return samples;
+	}
+
+	/**
+	 *\brief Benchmarks the auto-correlation, jack-knife and bootstrap analysis used by calculateResults.
+	 *\param out the stream to print to.
+	 *\param options the options the benchmarks are run with.
+	 */
+	void benchmarkAnalysis(std::ostream &out, const Options &options)
+	{
+		volatile double sink = 0;
+		Susceptibility susceptibilityFcn(1.0, criticalTemperature);
+		for(const auto& count : options.sampleCounts)
+		{
+			DataArray samples = correlatedSamples(count);
+			measure(out, "auto-correlation", count, 100, options.minTime, [&](long long &operations, long long &)
+			{
+				sink = sink + samples.autoCorrelation(0, 100).back();
+				operations += count;
+			});
+
+			const int binCounts[] = {0, 50};
+			for(const auto& bins : binCounts)
+			{
+				measure(out, "jack-knife", count, bins, options.minTime, [&](long long &operations, long long &)
+				{
+					sink = sink + jackKnife(static_cast<const DataArray::IMomentFunctor&>(susceptibilityFcn), samples, bins);
+					operations += count;
+				});
+			}
+
+			// calculateResults re-samples 100 times.
+			const int blockLengths[] = {1, 100};
+			for(const auto& blockLength : blockLengths)
+			{
+				measure(out, "bootstrap", count, blockLength, options.minTime, [&](long long &operations, long long &)
+				{
+					sink = sink + bootstrap(static_cast<const DataArray::IMomentFunctor&>(susceptibilityFcn), samples, seed, 100, blockLength, 1);
+					operations += count;
+				});
+			}
+		}
+	}
+}
+
+int main(int argc, char const *argv[])
+{
+	Options options;
+	options.sizes = {32, 128, 512, 2048, 8192};
+	options.largestListedSize = 2048;
+	options.temperatures = {1.5, criticalTemperature, 3.5};
+	options.sampleCounts = {10000, 100000, 1000000};
+	options.tiles = false;
+	options.tileSizes = {8, 16, 32, 64, 128, 256, 1024};
+	options.minTime = 0.2;
+	options.engineName = "minstd";
+
+	for(int arg = 1; arg < argc; ++arg)
+	{
+		if(std::strcmp(argv[arg], "--quick") == 0)
+		{
+			// Enough to see that everything runs and spot large regressions.
+			options.sizes = {32, 512};
+			options.temperatures = {criticalTemperature};
+			options.sampleCounts = {10000, 100000};
+			options.minTime = 0.05;
+		}
+		else if(std::strcmp(argv[arg], "--tiles") == 0)
+		{
+			// The random bond sets of the largest lattice would need several GiB.
+			options.tiles = true;
+			options.sizes = {64, 256, 1024, 4096, 16384};
+			options.largestListedSize = 4096;
+			options.temperatures = {criticalTemperature};
+		}
+		else if(std::strcmp(argv[arg], "--rng") == 0 && arg + 1 < argc)
+		{
+			options.engineName = argv[++arg];
+		}
+		else if(std::strcmp(argv[arg], "--min-time") == 0 && arg + 1 < argc)
+		{
+			options.minTime = std::atof(argv[++arg]);
+		}
+		else
+		{
+			std::cerr << "Usage: " << argv[0] << " [--quick] [--tiles] [--rng minstd|xoshiro|philox] [--min-time SECONDS]" << '\n';
+			return 1;
+		}
+	}
+
+	std::cout << std::setprecision(6);
+	printHeader(std::cout, options);
+	if(options.engineName == "minstd")
+	{
+		benchmarkEngine<std::default_random_engine>(std::cout, options);
+	}
+	else if(options.engineName == "xoshiro")
+	{
+		benchmarkEngine<Xoshiro256StarStar>(std::cout, options);
+	}
+	else if(options.engineName == "philox")
+	{
+		benchmarkEngine<Philox4x32>(std::cout, options);
+	}
+	else
+	{
+		std::cerr << "Unknown random number engine " << options.engineName << ", choose minstd, xoshiro or philox." << '\n';
+		return 1;
+	}
+	if(!options.tiles)
+	{
+		benchmarkObservables(std::cout, options);
+		benchmarkAnalysis(std::cout, options);
+	}
+	return 0;
+}
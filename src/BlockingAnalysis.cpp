@@ -0,0 +1,149 @@
+#include "BlockingAnalysis.hpp"
+#include <cmath>
+
+namespace
+{
+	/**
+	 *\brief Gets the 99% quantile of the chi squared distribution.
+	 *\param degreesOfFreedom integer number of degrees of freedom, at least 1.
+	 *\return floating point value representing the quantile.
+	 */
+	double chiSquaredQuantile(int degreesOfFreedom)
+	{
+		static const double quantiles[] =
+		{
+			6.634897, 9.210340, 11.344867, 13.276704, 15.086272, 16.811894, 18.475307, 20.090235, 21.665994, 23.209251,
+			24.724970, 26.216967, 27.688250, 29.141238, 30.577914, 31.999927, 33.408664, 34.805306, 36.190869, 37.566235,
+			38.932173, 40.289360, 41.638398, 42.979820, 44.314105, 45.641683, 46.962942, 48.278236, 49.587884, 50.892181
+		};
+		if(degreesOfFreedom <= 30)
+		{
+			return quantiles[degreesOfFreedom-1];
+		}
+
+		// Wilson-Hilferty approximation with the 99% quantile of the normal distribution.
+		double k = degreesOfFreedom;
+		double term = 2.0 / (9.0 * k);
+		return k * std::pow(1.0 - term + 2.326348 * std::sqrt(term), 3);
+	}
+}
+
+BlockingAnalysis::BlockingAnalysis(const DataArray &data)
+{
+	std::vector<double> blocks(data.getSize());
+	for(int i = 0; i < data.getSize(); ++i)
+	{
+		blocks[i] = data[i];
+	}
+
+	// Each level is summarised then halved in place, the sizes halve so the whole pass is O(N).
+	while(blocks.size() >= 2)
+	{
+		long long n = static_cast<long long>(blocks.size());
+		double mean = 0;
+		for(const auto& block : blocks)
+		{
+			mean += block;
+		}
+		mean /= n;
+
+		double variance = 0;
+		double lagCovariance = 0;
+		for(long long i = 0; i < n; ++i)
+		{
+			variance += (blocks[i] - mean) * (blocks[i] - mean);
+			if(i + 1 < n)
+			{
+				lagCovariance += (blocks[i] - mean) * (blocks[i+1] - mean);
+			}
+		}
+		m_levels.push_back(Level{n, variance / n, lagCovariance / n});
+
+		// An odd block at the end is dropped.
+		for(long long i = 0; i < n / 2; ++i)
+		{
+			blocks[i] = 0.5 * (blocks[2*i] + blocks[2*i+1]);
+		}
+		blocks.resize(n / 2);
+	}
+
+	findPlateau();
+}
+
+BlockingAnalysis::BlockingAnalysis(const std::vector<Level> &levels) : m_levels(levels)
+{
+	findPlateau();
+}
+
+void BlockingAnalysis::findPlateau()
+{
+	int levels = getLevels();
+	m_plateauLevel = levels - 1;
+	m_converged = false;
+
+	// M_j = Sum_{k >= j} n_k (gamma_k / sigma_k^2)^2 is chi squared with one degree of freedom per level if the
+	// block means from level j on are uncorrelated, take the first level where this can't be rejected.
+	std::vector<double> statistic(levels + 1, 0.0);
+	for(int level = levels - 1; level >= 0; --level)
+	{
+		const Level &summary = m_levels[level];
+		double ratio = summary.variance > 0 ? summary.lagCovariance / summary.variance : 0.0;
+		statistic[level] = statistic[level + 1] + summary.blocks * ratio * ratio;
+	}
+
+	for(int level = 0; level < levels; ++level)
+	{
+		if(statistic[level] < chiSquaredQuantile(levels - level))
+		{
+			m_plateauLevel = level;
+			m_converged = (level < levels - 1);
+			break;
+		}
+	}
+}
+
+int BlockingAnalysis::getLevels() const
+{
+	return static_cast<int>(m_levels.size());
+}
+
+long long BlockingAnalysis::getBlocks(int level) const
+{
+	return m_levels[level].blocks;
+}
+
+double BlockingAnalysis::error(int level) const
+{
+	return std::sqrt(m_levels[level].variance / (m_levels[level].blocks - 1));
+}
+
+double BlockingAnalysis::errorOfError(int level) const
+{
+	return error(level) / std::sqrt(2.0 * (m_levels[level].blocks - 1));
+}
+
+int BlockingAnalysis::getPlateauLevel() const
+{
+	return m_plateauLevel;
+}
+
+double BlockingAnalysis::error() const
+{
+	return m_plateauLevel < 0 ? std::nan("") : error(m_plateauLevel);
+}
+
+double BlockingAnalysis::errorOfError() const
+{
+	return m_plateauLevel < 0 ? std::nan("") : errorOfError(m_plateauLevel);
+}
+
+double BlockingAnalysis::effectiveSamples() const
+{
+	double plateauError = error();
+	return m_levels.empty() ? std::nan("") : m_levels[0].variance / (plateauError * plateauError);
+}
+
+bool BlockingAnalysis::converged() const
+{
+	return m_converged;
+}
@@ -0,0 +1,131 @@
+#ifndef BlockingAnalysis_hpp
+#define BlockingAnalysis_hpp
+#include <vector>
+#include "DataArray.hpp"
+
+/**
+ *\file
+ *\class BlockingAnalysis
+ *\brief Estimates the error of the mean of a correlated time series by blocking (Flyvbjerg-Petersen).
+ *
+ * The series is repeatedly replaced by the means of neighbouring pairs, so level k holds block means of 2^k
+ * samples. The naive error of the mean calculated at each level grows with the block size until the blocks
+ * are longer than the autocorrelation time and then stays on a plateau, which is the honest error. The plateau
+ * is found automatically with the test of Jonsson (Phys. Rev. E 98, 043304), which picks the smallest block size
+ * for which the remaining lag one autocorrelations of the block means are consistent with zero.
+ */
+class BlockingAnalysis
+{
+public:
+	/**
+	 *\brief Summary of the block means of one level.
+	 */
+	struct Level
+	{
+		/// Number of blocks.
+		long long blocks;
+		/// Variance of the block means about their mean.
+		double variance;
+		/// Lag one autocovariance of the block means.
+		double lagCovariance;
+	};
+
+private:
+	/**
+	 *\brief Member variable holding the summary of every level with at least two blocks.
+	 */
+	std::vector<Level> m_levels;
+
+	/**
+	 *\brief Member variable holding the index of the level at the start of the plateau.
+	 */
+	int m_plateauLevel;
+
+	/**
+	 *\brief Member variable set if the plateau was reached before the last level.
+	 */
+	bool m_converged;
+
+	/**
+	 *\brief Finds the plateau level from the level summaries.
+	 */
+	void findPlateau();
+
+public:
+	/**
+	 *\brief Blocks a sample set in a single O(N) pass.
+	 *\param data a const DataArray reference holding the time series.
+	 */
+	explicit BlockingAnalysis(const DataArray &data);
+
+	/**
+	 *\brief Creates the analysis from level summaries that were accumulated elsewhere, e.g. while streaming.
+	 *\param levels vector of the summaries of each level, level k has blocks of 2^k samples.
+	 */
+	explicit BlockingAnalysis(const std::vector<Level> &levels);
+
+	/**
+	 *\brief Getter method for the number of levels.
+	 *\return integer value representing the number of block sizes with at least two blocks.
+	 */
+	int getLevels() const;
+
+	/**
+	 *\brief Getter method for the number of blocks of a level.
+	 *\param level index of the level.
+	 *\return integer value representing the number of blocks.
+	 */
+	long long getBlocks(int level) const;
+
+	/**
+	 *\brief Method to calculate the naive error of the mean of the block means of one level.
+	 *\param level index of the level.
+	 *\return floating point value representing the error.
+	 */
+	double error(int level) const;
+
+	/**
+	 *\brief Method to calculate the statistical uncertainty of the error of one level.
+	 *\param level index of the level.
+	 *\return floating point value representing the uncertainty of the error.
+	 */
+	double errorOfError(int level) const;
+
+	/**
+	 *\brief Getter method for the level at the start of the plateau.
+	 *\return integer value representing the index of the level, -1 if there are fewer than two samples.
+	 */
+	int getPlateauLevel() const;
+
+	/**
+	 *\brief Method to get the error of the mean at the plateau.
+	 *\return floating point value representing the error, NaN if there are fewer than two samples.
+	 */
+	double error() const;
+
+	/**
+	 *\brief Method to get the statistical uncertainty of the error at the plateau.
+	 *\return floating point value representing the uncertainty, NaN if there are fewer than two samples.
+	 */
+	double errorOfError() const;
+
+	/**
+	 *\brief Method to get the effective number of independent samples.
+	 *
+	 * The number of uncorrelated samples that would give the same error, N_eff = variance/error^2 which is
+	 * roughly N/(2 tau_int).
+	 *
+	 *\return floating point value representing the effective number of samples.
+	 */
+	double effectiveSamples() const;
+
+	/**
+	 *\brief Whether the plateau was reached before the largest block size.
+	 *
+	 * If not the series is too short compared to its autocorrelation time and the error is an underestimate.
+	 *
+	 *\return true if the plateau was reached.
+	 */
+	bool converged() const;
+};
+#endif /* BlockingAnalysis_hpp */
@@ -0,0 +1,39 @@
+#include "BoltzmannTable.hpp"
+#include <cmath>
+#include <algorithm>
+#include <limits>
+constexpr int BoltzmannTable::maxEnergyChange;
+
+BoltzmannTable::BoltzmannTable(double jConstant, double boltzmannConstant, double temperature)
+{
+	for(int energyChange = -maxEnergyChange; energyChange <= maxEnergyChange; ++energyChange)
+	{
+		int index = energyChange + maxEnergyChange;
+		double deltaEnergy = 2.0 * jConstant * energyChange;
+		m_probabilities[index] = std::min(1.0, std::exp(-deltaEnergy/(boltzmannConstant*temperature)));
+		m_thresholds[index]    = thresholds(m_probabilities[index]);
+	}
+}
+
+BoltzmannTable::Thresholds BoltzmannTable::thresholds(double probability)
+{
+	// Number of distinct values std::default_random_engine can return.
+	double range = static_cast<double>(std::default_random_engine::max() - std::default_random_engine::min()) + 1.0;
+
+	Thresholds result;
+	result.alwaysAccepted = (probability >= 1.0);
+	result.engine 		  = static_cast<std::uint64_t>(std::llround(probability * range));
+
+	// 2^64 and 2^32 don't fit so moves that are always accepted get the largest threshold instead, they never
+	// compare with it anyway.
+	result.fullRange = result.alwaysAccepted ? std::numeric_limits<std::uint64_t>::max()
+											 : static_cast<std::uint64_t>(std::ldexp(probability, 64));
+	result.word 	 = result.alwaysAccepted ? std::numeric_limits<std::uint32_t>::max()
+											 : static_cast<std::uint32_t>(std::ldexp(probability, 32));
+	return result;
+}
+
+double BoltzmannTable::probability(int energyChange) const
+{
+	return m_probabilities[energyChange + maxEnergyChange];
+}
@@ -0,0 +1,157 @@
+#ifndef BoltzmannTable_hpp
+#define BoltzmannTable_hpp
+#include <random>
+#include <cstdint>
+#include "randomEngines.hpp"
+
+/**
+ *\file
+ *\class BoltzmannTable
+ *\brief Table of metropolis acceptance thresholds for the integer energy changes on a square lattice.
+ *
+ * On the square lattice flipping a spin, or swapping two opposite spins, changes the energy by 2J times a
+ * small integer (the energy change in units of 2J) which lies in [-maxEnergyChange, maxEnergyChange]. The
+ * acceptance probability min(1, exp(-dE/k_B T)) is therefore computed once per temperature and stored as
+ * an integer threshold, so a proposed move is accepted by comparing the raw output of the random number
+ * engine with the threshold rather than calling std::exp. Moves that lower the energy are accepted without
+ * drawing a random number at all. There are thresholds for std::default_random_engine and for engines that
+ * return every 64 bit number.
+ */
+class BoltzmannTable
+{
+public:
+	/// Largest magnitude of the energy change in units of 2J of a single flip or a swap.
+	static constexpr int maxEnergyChange = 8;
+
+	/**
+	 *\struct Thresholds
+	 *\brief Acceptance thresholds of a move for each kind of random number, see thresholds.
+	 */
+	struct Thresholds
+	{
+		/// Threshold for generator() - generator.min() of std::default_random_engine.
+		std::uint64_t engine;
+		/// Threshold for engines whose output covers [0, 2^64).
+		std::uint64_t fullRange;
+		/// Threshold for random words covering [0, 2^32).
+		std::uint32_t word;
+		/// Whether the move is accepted without drawing a random number.
+		bool alwaysAccepted;
+	};
+
+private:
+	/**
+	 *\brief Member variable array holding acceptance probabilities indexed by energy change + maxEnergyChange.
+	 */
+	double m_probabilities[2*maxEnergyChange+1];
+
+	/**
+	 *\brief Member variable array holding acceptance thresholds indexed by energy change + maxEnergyChange.
+	 */
+	Thresholds m_thresholds[2*maxEnergyChange+1];
+
+public:
+	/**
+	 *\brief Calculates the acceptance thresholds of a move.
+	 *
+	 * A move is accepted if the raw output of the engine, less generator.min() for std::default_random_engine,
+	 * or a random word is less than the threshold. Moves with probability 1 are always accepted, their full
+	 * range and word thresholds are the largest values instead of 2^64 and 2^32, which don't fit. Every table of
+	 * Metropolis thresholds is built with this so they all round the same way.
+	 *
+	 *\param probability floating point value in [0, 1] representing the acceptance probability of the move.
+	 *\return the thresholds of the move.
+	 */
+	static Thresholds thresholds(double probability);
+
+	/**
+	 *\brief Performs the metropolis test for a move with precalculated thresholds.
+	 *\param thresholds the thresholds of the move, from thresholds.
+	 *\param generator reference to random engine used in the acceptance test, either std::default_random_engine
+	 * or an engine that returns every 64 bit number.
+	 *\return boolean value representing whether the move should be accepted.
+	 */
+	template<class Engine>
+	static bool accept(const Thresholds &thresholds, Engine &generator);
+
+	/**
+	 *\brief Builds the table for a given temperature.
+	 *\param jConstant floating point value representing the J constant.
+	 *\param boltzmannConstant floating point value representing the Boltzmann constant.
+	 *\param temperature floating point value representing the temperature of the system.
+	 */
+	BoltzmannTable(double jConstant, double boltzmannConstant, double temperature);
+
+	/**
+	 *\brief Getter method for the acceptance probability of a move.
+	 *\param energyChange integer energy change of the move in units of 2J.
+	 *\return floating point value representing the acceptance probability.
+	 */
+	double probability(int energyChange) const;
+
+	/**
+	 *\brief Whether a move is accepted without needing a random number.
+	 *\param energyChange integer energy change of the move in units of 2J.
+	 *\return boolean value representing whether the move is always accepted.
+	 */
+	bool alwaysAccepted(int energyChange) const;
+
+	/**
+	 *\brief Performs the metropolis test for a move.
+	 *\param energyChange integer energy change of the move in units of 2J.
+	 *\param generator reference to random engine used in the acceptance test, either std::default_random_engine
+	 * or an engine that returns every 64 bit number.
+	 *\return boolean value representing whether the move should be accepted.
+	 */
+	template<class Engine>
+	bool accept(int energyChange, Engine &generator) const;
+
+	/**
+	 *\brief Gets the threshold for the random words filled by fillRandomWords from an engine.
+	 *
+	 * A move is accepted if it is always accepted or the word is less than the threshold, which lets the
+	 * acceptance tests of many sites be made at once with vector instructions.
+	 *
+	 *\param energyChange integer energy change of the move in units of 2J.
+	 *\return the threshold for words drawn from Engine.
+	 */
+	template<class Engine>
+	std::uint32_t wordThreshold(int energyChange) const;
+};
+
+inline bool BoltzmannTable::alwaysAccepted(int energyChange) const
+{
+	return m_thresholds[energyChange + maxEnergyChange].alwaysAccepted;
+}
+
+template<class Engine>
+inline bool BoltzmannTable::accept(const Thresholds &thresholds, Engine &generator)
+{
+	static_assert(hasFullRange64<Engine>() || Engine::max() - Engine::min() == std::default_random_engine::max() - std::default_random_engine::min(),
+				  "The thresholds only suit std::default_random_engine and full range 64 bit engines.");
+
+	if(hasFullRange64<Engine>())
+	{
+		return thresholds.alwaysAccepted || (static_cast<std::uint64_t>(generator()) < thresholds.fullRange);
+	}
+	return thresholds.alwaysAccepted || (static_cast<std::uint64_t>(generator() - generator.min()) < thresholds.engine);
+}
+
+template<class Engine>
+inline bool BoltzmannTable::accept(int energyChange, Engine &generator) const
+{
+	return accept(m_thresholds[energyChange + maxEnergyChange], generator);
+}
+
+template<class Engine>
+inline std::uint32_t BoltzmannTable::wordThreshold(int energyChange) const
+{
+	static_assert(hasFullRange64<Engine>() || Engine::max() - Engine::min() == std::default_random_engine::max() - std::default_random_engine::min(),
+				  "The thresholds only suit std::default_random_engine and full range 64 bit engines.");
+
+	// The std::default_random_engine thresholds are below 2^31 so fit in a word.
+	const Thresholds &thresholds = m_thresholds[energyChange + maxEnergyChange];
+	return hasFullRange64<Engine>() ? thresholds.word : static_cast<std::uint32_t>(thresholds.engine);
+}
+
+#endif /* BoltzmannTable_hpp */
@@ -0,0 +1,472 @@
+#include "ByteSpinLattice2D.hpp"
+#include "binaryIO.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ISING_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace
+{
+	/**
+	 *\brief Acceptance thresholds of the words drawn for a row indexed by (energy change + 4) / 2.
+	 *
+	 * A flip is accepted if always is all ones or its word is less than its threshold. The arrays are padded
+	 * to a whole AVX-512 register.
+	 */
+	struct AcceptanceTable
+	{
+		alignas(64) std::uint32_t thresholds[16];
+		alignas(64) std::uint32_t always[16];
+	};
+
+	/**
+	 *\brief Updates the sites of a run of a half row one at a time.
+	 *
+	 * Every kernel takes the spins of the sites being updated, their neighbours in the rows above and below and
+	 * in the same row (the same column and the one to the side of it), the random word of each site and
+	 * adds the energy change (units of 2J) and magnetisation change of the flips it accepts.
+	 *
+	 *\return number of accepted flips.
+	 */
+	long long updateRunScalar(std::int8_t *spins,
+							  const std::int8_t *above,
+							  const std::int8_t *below,
+							  const std::int8_t *centre,
+							  const std::int8_t *side,
+							  const std::uint32_t *words,
+							  int first,
+							  int count,
+							  const AcceptanceTable &table,
+							  long long &energyChange,
+							  long long &magnetisationChange)
+	{
+		long long accepted = 0;
+		for(int site = first; site < count; ++site)
+		{
+			int spin = spins[site];
+			int flipEnergyChange = spin * (above[site] + below[site] + centre[site] + side[site]);
+			int index = (flipEnergyChange + 4) / 2;
+			if(table.always[index] || words[site] < table.thresholds[index])
+			{
+				spins[site] = static_cast<std::int8_t>(-spin);
+				energyChange += flipEnergyChange;
+				magnetisationChange -= 2 * spin;
+				++accepted;
+			}
+		}
+		return accepted;
+	}
+
+#ifdef ISING_X86_KERNELS
+	/**
+	 *\brief Updates the sites of a half row 32 at a time with AVX2, see updateRunScalar.
+	 */
+	__attribute__((target("avx2,popcnt")))
+	long long updateRowAvx2(std::int8_t *spins,
+							const std::int8_t *above,
+							const std::int8_t *below,
+							const std::int8_t *centre,
+							const std::int8_t *side,
+							const std::uint32_t *words,
+							int count,
+							const AcceptanceTable &table,
+							long long &energyChange,
+							long long &magnetisationChange)
+	{
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i one = _mm256_set1_epi8(1);
+		const __m256i four = _mm256_set1_epi8(4);
+
+		// There's no unsigned comparison so both sides are offset by 2^31.
+		const __m256i signBit = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+		const __m256i thresholds = _mm256_xor_si256(_mm256_load_si256(reinterpret_cast<const __m256i*>(table.thresholds)), signBit);
+		const __m256i always = _mm256_load_si256(reinterpret_cast<const __m256i*>(table.always));
+
+		// Used to turn a 32 bit mask into one byte per bit, byte i picks out byte i / 8 of the mask and then bit i % 8.
+		const __m256i maskBytes = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+												   2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+		const __m256i maskBits = _mm256_set1_epi64x(static_cast<long long>(0x8040201008040201ULL));
+
+		__m256i energySums = zero;
+		long long accepted = 0;
+		long long flipped = 0;
+		int site = 0;
+		for(; site + 32 <= count; site += 32)
+		{
+			__m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(spins + site));
+			__m256i n = _mm256_add_epi8(_mm256_add_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(above + site)),
+														_mm256_loadu_si256(reinterpret_cast<const __m256i*>(below + site))),
+										_mm256_add_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(centre + site)),
+														_mm256_loadu_si256(reinterpret_cast<const __m256i*>(side + site))));
+
+			// Energy change of each flip in units of 2J offset by 4 so it is in [0, 8].
+			__m256i biased = _mm256_add_epi8(_mm256_sign_epi8(n, s), four);
+
+			// The tests are made 8 sites at a time on 32 bit lanes.
+			__m128i halves[2] = {_mm256_castsi256_si128(biased), _mm256_extracti128_si256(biased, 1)};
+			std::uint32_t mask = 0;
+			for(int group = 0; group < 4; ++group)
+			{
+				__m128i part = (group % 2) ? _mm_srli_si128(halves[group / 2], 8) : halves[group / 2];
+				__m256i index = _mm256_srli_epi32(_mm256_cvtepi8_epi32(part), 1);
+				__m256i word = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + site + 8 * group)), signBit);
+				__m256i accept = _mm256_or_si256(_mm256_permutevar8x32_epi32(always, index),
+												 _mm256_cmpgt_epi32(_mm256_permutevar8x32_epi32(thresholds, index), word));
+				mask |= static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(accept))) << (8 * group);
+			}
+
+			__m256i flips = _mm256_shuffle_epi8(_mm256_set1_epi32(static_cast<int>(mask)), maskBytes);
+			flips = _mm256_cmpeq_epi8(_mm256_and_si256(flips, maskBits), maskBits);
+
+			// Multiply the flipped spins by -1 and the rest by 1.
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(spins + site), _mm256_sign_epi8(s, _mm256_or_si256(flips, one)));
+
+			energySums = _mm256_add_epi64(energySums, _mm256_sad_epu8(_mm256_and_si256(biased, flips), zero));
+			std::uint32_t negative = static_cast<std::uint32_t>(_mm256_movemask_epi8(s));
+			magnetisationChange += 2 * (__builtin_popcount(mask & negative) - __builtin_popcount(mask & ~negative));
+			flipped += __builtin_popcount(mask);
+		}
+
+		// Remove the offset of 4 from each accepted flip.
+		long long sums[4];
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(sums), energySums);
+		energyChange += sums[0] + sums[1] + sums[2] + sums[3] - 4 * flipped;
+		accepted += flipped;
+
+		return accepted + updateRunScalar(spins, above, below, centre, side, words, site, count, table, energyChange, magnetisationChange);
+	}
+
+	/**
+	 *\brief Updates the sites of a half row 64 at a time with AVX-512, see updateRunScalar.
+	 */
+	__attribute__((target("avx512f,avx512bw,popcnt")))
+	long long updateRowAvx512(std::int8_t *spins,
+							  const std::int8_t *above,
+							  const std::int8_t *below,
+							  const std::int8_t *centre,
+							  const std::int8_t *side,
+							  const std::uint32_t *words,
+							  int count,
+							  const AcceptanceTable &table,
+							  long long &energyChange,
+							  long long &magnetisationChange)
+	{
+		const __m512i zero = _mm512_setzero_si512();
+		const __m512i four = _mm512_set1_epi8(4);
+		const __m512i thresholds = _mm512_load_si512(table.thresholds);
+		const __m512i always = _mm512_load_si512(table.always);
+
+		// GCC's unmasked forms of the extract, widen, shift and permute intrinsics start from an undefined
+		// register and warn that it may be used uninitialised, so the zero masked forms are used with every lane on.
+		const __mmask16 allLanes = 0xFFFF;
+
+		__m512i energySums = zero;
+		long long accepted = 0;
+		long long flipped = 0;
+		int site = 0;
+		for(; site + 64 <= count; site += 64)
+		{
+			__m512i s = _mm512_loadu_si512(spins + site);
+			__m512i n = _mm512_add_epi8(_mm512_add_epi8(_mm512_loadu_si512(above + site), _mm512_loadu_si512(below + site)),
+										_mm512_add_epi8(_mm512_loadu_si512(centre + site), _mm512_loadu_si512(side + site)));
+
+			// Energy change of each flip in units of 2J offset by 4 so it is in [0, 8].
+			__mmask64 negative = _mm512_movepi8_mask(s);
+			__m512i biased = _mm512_add_epi8(_mm512_mask_sub_epi8(n, negative, zero, n), four);
+
+			// The tests are made 16 sites at a time on 32 bit lanes.
+			__m128i parts[4] = {_mm512_maskz_extracti32x4_epi32(0xF, biased, 0),
+								_mm512_maskz_extracti32x4_epi32(0xF, biased, 1),
+								_mm512_maskz_extracti32x4_epi32(0xF, biased, 2),
+								_mm512_maskz_extracti32x4_epi32(0xF, biased, 3)};
+			__mmask64 mask = 0;
+			for(int group = 0; group < 4; ++group)
+			{
+				__m512i index = _mm512_maskz_srli_epi32(allLanes, _mm512_maskz_cvtepi8_epi32(allLanes, parts[group]), 1);
+				__m512i word = _mm512_loadu_si512(words + site + 16 * group);
+				__m512i alwaysAccepted = _mm512_maskz_permutexvar_epi32(allLanes, index, always);
+				__mmask16 accept = _mm512_cmplt_epu32_mask(word, _mm512_maskz_permutexvar_epi32(allLanes, index, thresholds))
+								   | _mm512_test_epi32_mask(alwaysAccepted, alwaysAccepted);
+				mask |= static_cast<__mmask64>(accept) << (16 * group);
+			}
+
+			_mm512_storeu_si512(spins + site, _mm512_mask_sub_epi8(s, mask, zero, s));
+
+			energySums = _mm512_add_epi64(energySums, _mm512_sad_epu8(_mm512_maskz_mov_epi8(mask, biased), zero));
+			magnetisationChange += 2 * (__builtin_popcountll(mask & negative) - __builtin_popcountll(mask & ~negative));
+			flipped += __builtin_popcountll(mask);
+		}
+
+		// Sum the lanes through memory, _mm512_reduce_add_epi64 uses the unmasked extract, and remove the offset
+		// of 4 from each accepted flip.
+		alignas(64) long long energyLanes[8];
+		_mm512_store_si512(energyLanes, energySums);
+		for(long long lane : energyLanes)
+		{
+			energyChange += lane;
+		}
+		energyChange -= 4 * flipped;
+		accepted += flipped;
+
+		return accepted + updateRunScalar(spins, above, below, centre, side, words, site, count, table, energyChange, magnetisationChange);
+	}
+#endif
+}
+
+ByteSpinLattice2D::ByteSpinLattice2D(int rows, int cols, Kernel kernel) : 	m_colCount{cols},
+																			m_rowCount{rows},
+																			m_halfCols{cols / 2},
+																			m_stride{cols / 2 + 2},
+																			m_kernel{kernel},
+																			m_randomWords(m_halfCols)
+{
+	for(auto& sublattice : m_sublattices)
+	{
+		sublattice.assign(m_rowCount * m_stride, static_cast<std::int8_t>(SpinLattice2D::spinValues[SpinLattice2D::Up]));
+	}
+	resetTotals();
+}
+
+bool ByteSpinLattice2D::kernelSupported(Kernel kernel)
+{
+	switch(kernel)
+	{
+#ifdef ISING_X86_KERNELS
+		case Avx2:
+			return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+		case Avx512:
+			return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("popcnt");
+#endif
+		case Scalar:
+			return true;
+		default:
+			return false;
+	}
+}
+
+ByteSpinLattice2D::Kernel ByteSpinLattice2D::fastestKernel()
+{
+	if(kernelSupported(Avx512))
+	{
+		return Avx512;
+	}
+	return kernelSupported(Avx2) ? Avx2 : Scalar;
+}
+
+const char* ByteSpinLattice2D::kernelName(Kernel kernel)
+{
+	static const char* names[] = {"Scalar", "AVX2", "AVX-512"};
+	return names[kernel];
+}
+
+ByteSpinLattice2D::Kernel ByteSpinLattice2D::getKernel() const
+{
+	return m_kernel;
+}
+
+void ByteSpinLattice2D::resetTotals()
+{
+	m_bondSum = static_cast<int>(-1.0 * recomputeLatticeEnergy(1.0));
+	m_magnetisation = recomputeTotalMag();
+}
+
+std::int8_t& ByteSpinLattice2D::site(int row, int col)
+{
+	// Sites with col = 2 * index + (row + sublattice) % 2 are at index in their half row, after the ghost.
+	return m_sublattices[(row + col) % 2][row * m_stride + 1 + col / 2];
+}
+
+const std::int8_t& ByteSpinLattice2D::site(int row, int col) const
+{
+	return m_sublattices[(row + col) % 2][row * m_stride + 1 + col / 2];
+}
+
+void ByteSpinLattice2D::refreshGhosts(int sublattice)
+{
+	for(int row = 0; row < m_rowCount; ++row)
+	{
+		std::int8_t *halfRow = &m_sublattices[sublattice][row * m_stride];
+		halfRow[0] = halfRow[m_halfCols];
+		halfRow[m_halfCols + 1] = halfRow[1];
+	}
+}
+
+void ByteSpinLattice2D::randomise(std::default_random_engine &generator)
+{
+	std::uniform_int_distribution<int> distribution(0,1);
+	for(int row = 0; row < m_rowCount; ++row)
+	{
+		for(int col = 0; col < m_colCount; ++col)
+		{
+			site(row, col) = static_cast<std::int8_t>(SpinLattice2D::spinValues[distribution(generator) ? SpinLattice2D::Down : SpinLattice2D::Up]);
+		}
+	}
+	resetTotals();
+}
+
+SpinLattice2D::Spin ByteSpinLattice2D::operator()(int row, int col) const
+{
+	row = (row + m_rowCount) % m_rowCount;
+	col = (col + m_colCount) % m_colCount;
+	return (site(row, col) == SpinLattice2D::spinValues[SpinLattice2D::Up]) ? SpinLattice2D::Up : SpinLattice2D::Down;
+}
+
+std::ostream& operator<<(std::ostream& out, const ByteSpinLattice2D& spinLattice)
+{
+	for(int row = 0; row < spinLattice.m_rowCount; ++row)
+	{
+		for(int col = 0; col < spinLattice.m_colCount; ++col)
+		{
+			out << std::showpos << SpinLattice2D::spinValues[spinLattice(row,col)] << ' ';
+		}
+		out << '\n';
+	}
+	return out;
+}
+
+template<class Engine>
+long long ByteSpinLattice2D::halfSweep(int parity, Engine &generator, const BoltzmannTable &boltzmannTable)
+{
+	// The thresholds only depend on the engine and the temperature but are cheap enough to set every half sweep.
+	AcceptanceTable table = {};
+	for(int index = 0; index < 5; ++index)
+	{
+		int energyChange = 2 * index - 4;
+		table.thresholds[index] = boltzmannTable.wordThreshold<Engine>(energyChange);
+		table.always[index] = boltzmannTable.alwaysAccepted(energyChange) ? ~std::uint32_t(0) : 0;
+	}
+
+	// The neighbours are all on the other sublattice.
+	refreshGhosts(1 - parity);
+	const std::int8_t *neighbours = m_sublattices[1 - parity].data() + 1;
+
+	long long accepted = 0;
+	long long energyChange = 0;
+	long long magnetisationChange = 0;
+	for(int row = 0; row < m_rowCount; ++row)
+	{
+		std::int8_t *spins = &m_sublattices[parity][row * m_stride + 1];
+		const std::int8_t *above = neighbours + ((row - 1 + m_rowCount) % m_rowCount) * m_stride;
+		const std::int8_t *below = neighbours + ((row + 1) % m_rowCount) * m_stride;
+		const std::int8_t *centre = neighbours + row * m_stride;
+
+		// If the first site of the row is column 0 its other neighbour in the row is to the left, otherwise
+		// the first site is column 1 and it is to the right.
+		const std::int8_t *side = ((row + parity) % 2 == 0) ? centre - 1 : centre + 1;
+
+		fillRandomWords(generator, m_randomWords.data(), m_randomWords.data() + m_halfCols);
+		const std::uint32_t *words = m_randomWords.data();
+
+		switch(m_kernel)
+		{
+#ifdef ISING_X86_KERNELS
+			case Avx512:
+				accepted += updateRowAvx512(spins, above, below, centre, side, words, m_halfCols, table, energyChange, magnetisationChange);
+				break;
+			case Avx2:
+				accepted += updateRowAvx2(spins, above, below, centre, side, words, m_halfCols, table, energyChange, magnetisationChange);
+				break;
+#endif
+			default:
+				accepted += updateRunScalar(spins, above, below, centre, side, words, 0, m_halfCols, table, energyChange, magnetisationChange);
+				break;
+		}
+	}
+
+	// A flip with energy change dE (units of 2J) lowers the sum over bonds by 2 dE.
+	m_bondSum -= static_cast<int>(2 * energyChange);
+	m_magnetisation += static_cast<int>(magnetisationChange);
+	return accepted;
+}
+
+template<class Engine>
+long long ByteSpinLattice2D::sweep(Engine &generator, const BoltzmannTable &boltzmannTable)
+{
+	long long accepted = halfSweep(0, generator, boltzmannTable);
+	accepted += halfSweep(1, generator, boltzmannTable);
+	return accepted;
+}
+
+// Instantiated for every engine that can be chosen with --rng.
+template long long ByteSpinLattice2D::sweep(std::default_random_engine&, const BoltzmannTable&);
+template long long ByteSpinLattice2D::sweep(Xoshiro256StarStar&, const BoltzmannTable&);
+template long long ByteSpinLattice2D::sweep(Philox4x32&, const BoltzmannTable&);
+
+double ByteSpinLattice2D::latticeEnergy(double jConstant) const
+{
+	return -1.0 * jConstant * m_bondSum;
+}
+
+double ByteSpinLattice2D::recomputeLatticeEnergy(double jConstant) const
+{
+	// Every site has one bond to the right and one below.
+	long long bondSum = 0;
+	for(int row = 0; row < m_rowCount; ++row)
+	{
+		for(int col = 0; col < m_colCount; ++col)
+		{
+			int right = site(row, (col + 1) % m_colCount);
+			int below = site((row + 1) % m_rowCount, col);
+			bondSum += site(row, col) * (right + below);
+		}
+	}
+	return -1.0 * jConstant * bondSum;
+}
+
+int ByteSpinLattice2D::totalMag() const
+{
+	return m_magnetisation;
+}
+
+int ByteSpinLattice2D::recomputeTotalMag() const
+{
+	int magnetisation = 0;
+	for(int row = 0; row < m_rowCount; ++row)
+	{
+		for(int col = 0; col < m_colCount; ++col)
+		{
+			magnetisation += site(row, col);
+		}
+	}
+	return magnetisation;
+}
+
+int ByteSpinLattice2D::getRows() const
+{
+	return m_rowCount;
+}
+
+int ByteSpinLattice2D::getCols() const
+{
+	return m_colCount;
+}
+
+int ByteSpinLattice2D::getSize() const
+{
+	return m_rowCount * m_colCount;
+}
+
+void ByteSpinLattice2D::save(std::ostream &out) const
+{
+	for(const auto& sublattice : m_sublattices)
+	{
+		writeVector(out, sublattice);
+	}
+}
+
+void ByteSpinLattice2D::load(std::istream &in)
+{
+	for(auto& sublattice : m_sublattices)
+	{
+		std::size_t size = sublattice.size();
+		readVector(in, sublattice);
+		if(sublattice.size() != size)
+		{
+			in.setstate(std::ios::failbit);
+			sublattice.resize(size, 0);
+			return;
+		}
+	}
+	resetTotals();
+}
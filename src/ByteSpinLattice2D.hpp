@@ -0,0 +1,261 @@
+#ifndef ByteSpinLattice2D_hpp
+#define ByteSpinLattice2D_hpp
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <iostream>
+#include "SpinLattice2D.hpp"
+#include "BoltzmannTable.hpp"
+
+/**
+ *\file
+ *\class ByteSpinLattice2D
+ *\brief Models a 2D spin lattice stored as one byte per spin and swept with vector instructions.
+ *
+ * The lattice is stored in checkerboard order, each row holds the sites of one sublattice followed by those
+ * of the other so the sites updated together in a half sweep are contiguous bytes holding their spin values.
+ * The neighbours of the sites of one sublattice are then the same column of the other sublattice in the rows
+ * above and below and that column and the one to its left or right in the same row. Each half row has a ghost
+ * site at either end holding a copy of the site at the other end, refreshed before every half sweep, so all
+ * four neighbours of a run of sites are loaded with plain offsets whatever the boundary conditions.
+ *
+ * Half sweeps are done a row at a time by a kernel that adds up the neighbours of 32 (AVX2) or 64 (AVX-512)
+ * sites at once and makes their Metropolis tests against a row of random words drawn beforehand. The kernel
+ * is chosen at runtime from those the processor supports and all kernels, including the scalar one, make
+ * exactly the same flips. Periodic boundary conditions on a checkerboard require an even number of rows and
+ * columns.
+ */
+class ByteSpinLattice2D
+{
+public:
+	/**
+	 *\enum Kernel.
+	 *\brief represents the kernels that can perform the half sweeps.
+	 */
+	enum Kernel
+	{
+		Scalar,
+		Avx2,
+		Avx512,
+	};
+
+private:
+	/**
+	 *\brief Member variable integer to represent the number of columns.
+	 */
+	int m_colCount;
+
+	/**
+	 *\brief Member variable integer to represent the number of rows.
+	 */
+	int m_rowCount;
+
+	/**
+	 *\brief Member variable integer to represent the number of sites of one sublattice in each row.
+	 */
+	int m_halfCols;
+
+	/**
+	 *\brief Member variable integer to represent the distance between rows of a sublattice, including the ghost sites.
+	 */
+	int m_stride;
+
+	/**
+	 *\brief Member variable the kernel performing the half sweeps.
+	 */
+	Kernel m_kernel;
+
+	/**
+	 *\brief Member variable arrays holding the spin values of each sublattice, sites with (row + col) % 2 == sublattice.
+	 */
+	std::vector<std::int8_t> m_sublattices[2];
+
+	/**
+	 *\brief Scratch row holding the random words of the acceptance tests of one row.
+	 */
+	std::vector<std::uint32_t> m_randomWords;
+
+	/**
+	 *\brief Member variable integer holding the running sum of S_site * S_neighbour over all bonds.
+	 */
+	int m_bondSum;
+
+	/**
+	 *\brief Member variable integer holding the running total magnetisation.
+	 */
+	int m_magnetisation;
+
+	/**
+	 *\brief Recalculates the running energy and magnetisation after the whole lattice has been changed.
+	 */
+	void resetTotals();
+
+	/**
+	 *\brief Gets the byte holding the spin value of a site.
+	 *\param row row index, must be in the lattice.
+	 *\param col column index, must be in the lattice.
+	 *\return reference to the byte.
+	 */
+	std::int8_t& site(int row, int col);
+	const std::int8_t& site(int row, int col) const;
+
+	/**
+	 *\brief Copies the sites at either end of every row of a sublattice into the ghost sites at the other end.
+	 *\param sublattice the sublattice to refresh.
+	 */
+	void refreshGhosts(int sublattice);
+
+	/**
+	 *\brief Updates all sites on one sublattice of the checkerboard.
+	 *\param parity the sublattice to update, sites with (row + col) % 2 == parity are updated.
+	 *\param generator reference to random engine used in the acceptance tests.
+	 *\param boltzmannTable a BoltzmannTable reference holding the acceptance thresholds.
+	 *\return number of accepted flips.
+	 */
+	template<class Engine>
+	long long halfSweep(int parity, Engine &generator, const BoltzmannTable &boltzmannTable);
+
+public:
+	/**
+	 *\brief Creates a byte 2D spin lattice of specified dimensions; initially all spins up.
+	 *\param rows integer representing desired number of rows in lattice.
+	 *\param cols integer representing desired number of columns in lattice.
+	 *\param kernel the kernel performing the half sweeps, it must be supported by the processor.
+	 */
+	ByteSpinLattice2D(int rows, int cols, Kernel kernel = fastestKernel());
+
+	/**
+	 *\brief Whether the processor supports a kernel.
+	 *\param kernel the kernel.
+	 *\return true if the kernel can be used.
+	 */
+	static bool kernelSupported(Kernel kernel);
+
+	/**
+	 *\brief Gets the fastest kernel the processor supports.
+	 *\return the kernel.
+	 */
+	static Kernel fastestKernel();
+
+	/**
+	 *\brief Gets the name of a kernel.
+	 *\param kernel the kernel.
+	 *\return the name, Scalar, AVX2 or AVX-512.
+	 */
+	static const char* kernelName(Kernel kernel);
+
+	/**
+	 *\brief Getter method for the kernel performing the half sweeps.
+	 *\return the kernel.
+	 */
+	Kernel getKernel() const;
+
+	/**
+	 *\brief Randomises all spins in array.
+	 *\param generator reference to random engine used to draw the spins.
+	 */
+	void randomise(std::default_random_engine &generator);
+
+	/**
+	 *\brief Prints array as 2D matrix of +1 spin up and -1 spin down.
+	 *
+	 * Output format is identical to the SpinLattice2D equivalent.
+	 *
+	 *\param out an output stream reference to stream to.
+	 *\param spinLattice a const ByteSpinLattice2D reference to be printed.
+	 */
+	friend std::ostream& operator<<(std::ostream &out, const ByteSpinLattice2D &spinLattice);
+
+	/**
+	 *\brief Gets the spin at a site.
+	 *
+	 * Periodic boundary conditions are taken into account.
+	 *
+	 *\param row row index of site.
+	 *\param col column index of site.
+	 *\return the spin stored at the site.
+	 */
+	SpinLattice2D::Spin operator()(int row, int col) const;
+
+	/**
+	 *\brief Performs one Metropolis sweep of the lattice.
+	 *
+	 * A sweep consists of updating every site of one sublattice of the checkerboard followed by every
+	 * site of the other, so each site has exactly one proposed flip per sweep. The acceptance test of
+	 * each flip is the same as that used by glauberDynamics so the equilibrium physics is identical.
+	 *
+	 *\param generator reference to random engine used in the acceptance tests, std::default_random_engine,
+	 * Xoshiro256StarStar or Philox4x32.
+	 *\param boltzmannTable a BoltzmannTable reference holding the acceptance thresholds for the temperature of the system.
+	 *\return number of accepted flips.
+	 */
+	template<class Engine>
+	long long sweep(Engine &generator, const BoltzmannTable &boltzmannTable);
+
+	/**
+	 *\brief Gets the total energy of the lattice.
+	 *
+	 * Energy is given by the formula E = -J * Sum_{all nearest neighbours} S_site * S_neighbours. The sum is
+	 * updated from the flips accepted in each sweep so this is O(1).
+	 *
+	 *\param jConstant constant floating point value representing the value of the J constant.
+	 */
+	double latticeEnergy(const double jConstant) const;
+
+	/**
+	 *\brief Calculates the total energy of the lattice from every bond.
+	 *
+	 * Should always agree with latticeEnergy, used to check the running total.
+	 *
+	 *\param jConstant constant floating point value representing the value of the J constant.
+	 */
+	double recomputeLatticeEnergy(const double jConstant) const;
+
+	/**
+	 *\brief Gets total magnetisation of the spin lattice, this is O(1).
+	 *\return integer value representing the total magnetisation.
+	 */
+	int totalMag() const;
+
+	/**
+	 *\brief Calculates total magnetisation of the spin lattice from every site.
+	 *
+	 * Should always agree with totalMag, used to check the running total.
+	 *\return integer value representing the total magnetisation.
+	 */
+	int recomputeTotalMag() const;
+
+	/**
+	 *\brief Getter method for the number of columns in the spin lattice.
+	 *\return integer value representing number of columns.
+	 */
+	int getCols() const;
+
+	/**
+	 *\brief Getter method for the number of rows in the spin lattice.
+	 *\return integer value representing number of rows.
+	 */
+	int getRows() const;
+
+	/**
+	 *\brief Getter method for size of lattice = #columns * #rows
+	 *\return integer value representing size of lattice.
+	 */
+	int getSize() const;
+
+	/**
+	 *\brief Writes the spins of the lattice, which must have the same dimensions when it is loaded, to a binary stream so it can be restored with load.
+	 *\param out the stream to write to.
+	 */
+	void save(std::ostream &out) const;
+
+	/**
+	 *\brief Restores the spins of the lattice, which must have the same dimensions when it is loaded, written by save.
+	 *
+	 * Failures are left in the state of the stream.
+	 *
+	 *\param in the stream to read from.
+	 */
+	void load(std::istream &in);
+};
+#endif /* ByteSpinLattice2D_hpp */
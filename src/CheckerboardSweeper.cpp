@@ -0,0 +1,131 @@
+#include "CheckerboardSweeper.hpp"
+#include "binaryIO.hpp"
+#include <thread>
+#include <algorithm>
+
+// Every row's engine is its own stream of the user seed so the streams are independent of each other and of
+// the number of threads.
+template<class Engine>
+CheckerboardSweeper<Engine>::CheckerboardSweeper(int rows, unsigned int seed, int threads) : 	m_rowGenerators(makeStreams<Engine>(seed, rows)),
+																								m_threadCount{std::max(1, std::min(threads, rows))}
+{
+}
+
+template<class Engine>
+long long CheckerboardSweeper<Engine>::updateRows(SpinLattice2D &lattice,
+												  int parity,
+												  int firstRow,
+												  int lastRow,
+												  const BoltzmannTable &boltzmannTable,
+												  int &energyChange,
+												  int &magnetisationChange)
+{
+	// Accumulate locally so threads don't share cache lines in the inner loop.
+	long long accepted = 0;
+	int rowsEnergyChange = 0;
+	int rowsMagnetisationChange = 0;
+
+	for(int row = firstRow; row < lastRow; ++row)
+	{
+		Engine &generator = m_rowGenerators[row];
+
+		// First site on this sublattice is column 0 if row + parity is even, otherwise column 1.
+		for(int col = (row + parity) % 2; col < lattice.getCols(); col += 2)
+		{
+			int flipEnergyChange = lattice.flipEnergyChange(row, col);
+			if(boltzmannTable.accept(flipEnergyChange, generator))
+			{
+				rowsEnergyChange += flipEnergyChange;
+				rowsMagnetisationChange -= 2 * SpinLattice2D::spinValues[lattice.spin(row, col)];
+				lattice.flipUntracked(row, col);
+				++accepted;
+			}
+		}
+	}
+
+	energyChange += rowsEnergyChange;
+	magnetisationChange += rowsMagnetisationChange;
+	return accepted;
+}
+
+template<class Engine>
+long long CheckerboardSweeper<Engine>::sweep(SpinLattice2D &lattice, const BoltzmannTable &boltzmannTable)
+{
+	int rows = lattice.getRows();
+	long long accepted = 0;
+
+	for(int parity = 0; parity < 2; ++parity)
+	{
+		// Each thread gets a contiguous block of rows and counts its own accepted flips and their changes
+		// to the energy and magnetisation.
+		std::vector<long long> threadAccepted(m_threadCount, 0);
+		std::vector<int> threadEnergyChange(m_threadCount, 0);
+		std::vector<int> threadMagnetisationChange(m_threadCount, 0);
+		std::vector<std::thread> workers;
+		workers.reserve(m_threadCount-1);
+
+		for(int thread = 1; thread < m_threadCount; ++thread)
+		{
+			int firstRow = (rows * thread) / m_threadCount;
+			int lastRow  = (rows * (thread+1)) / m_threadCount;
+			workers.emplace_back([&, thread, firstRow, lastRow]()
+			{
+				threadAccepted[thread] = updateRows(lattice, parity, firstRow, lastRow, boltzmannTable,
+													threadEnergyChange[thread], threadMagnetisationChange[thread]);
+			});
+		}
+
+		// The calling thread does the first block itself.
+		threadAccepted[0] = updateRows(lattice, parity, 0, rows / m_threadCount, boltzmannTable,
+									   threadEnergyChange[0], threadMagnetisationChange[0]);
+
+		for(auto& worker : workers)
+		{
+			worker.join();
+		}
+
+		for(int thread = 0; thread < m_threadCount; ++thread)
+		{
+			accepted += threadAccepted[thread];
+			lattice.updateTotals(threadEnergyChange[thread], threadMagnetisationChange[thread]);
+		}
+	}
+
+	return accepted;
+}
+
+template<class Engine>
+int CheckerboardSweeper<Engine>::getThreads() const
+{
+	return m_threadCount;
+}
+
+template<class Engine>
+void CheckerboardSweeper<Engine>::save(std::ostream &out) const
+{
+	writeValue(out, static_cast<std::uint64_t>(m_rowGenerators.size()));
+	for(const auto& generator : m_rowGenerators)
+	{
+		writeEngine(out, generator);
+	}
+}
+
+template<class Engine>
+void CheckerboardSweeper<Engine>::load(std::istream &in)
+{
+	// The number of rows must match, anything else means the stream is from another lattice.
+	if(readValue<std::uint64_t>(in) != m_rowGenerators.size())
+	{
+		in.setstate(std::ios::failbit);
+		return;
+	}
+	for(auto& generator : m_rowGenerators)
+	{
+		readEngine(in, generator);
+	}
+}
+
+// Instantiated for every engine that can be chosen with --rng.
+template class CheckerboardSweeper<std::default_random_engine>;
+template class CheckerboardSweeper<Xoshiro256StarStar>;
+template class CheckerboardSweeper<Philox4x32>;
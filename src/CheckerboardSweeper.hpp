@@ -0,0 +1,100 @@
+#ifndef CheckerboardSweeper_hpp
+#define CheckerboardSweeper_hpp
+#include <iostream>
+#include <random>
+#include <vector>
+#include "SpinLattice2D.hpp"
+#include "BoltzmannTable.hpp"
+#include "randomEngines.hpp"
+
+/**
+ *\file
+ *\class CheckerboardSweeper
+ *\brief Performs multithreaded checkerboard (red-black) Glauber sweeps of a SpinLattice2D.
+ *
+ * The lattice is split into two sublattices like the squares of a checkerboard. No site has a nearest
+ * neighbour on its own sublattice so all of its sites can be updated at the same time. The rows of the
+ * lattice are split into contiguous blocks, one per thread, and each thread performs metropolis updates
+ * on its rows of one sublattice before all threads move on to the other.
+ *
+ * Every row has its own random number engine, one of the independent streams made by makeStreams from the
+ * user seed. Since a row is always updated in the same order by a single thread the results are identical for
+ * any number of threads given the same seed. Periodic boundary conditions require an even number of rows and
+ * columns. The sweeper is instantiated for std::default_random_engine, Xoshiro256StarStar and Philox4x32.
+ */
+template<class Engine>
+class CheckerboardSweeper
+{
+private:
+	/**
+	 *\brief Member variable holding one random number engine per lattice row.
+	 */
+	std::vector<Engine> m_rowGenerators;
+
+	/**
+	 *\brief Member variable integer to represent the number of threads used.
+	 */
+	int m_threadCount;
+
+	/**
+	 *\brief Updates every site of one sublattice in a block of rows.
+	 *\param lattice the SpinLattice2D being updated.
+	 *\param parity the sublattice to update, sites with (row + col) % 2 == parity are updated.
+	 *\param firstRow first row of the block.
+	 *\param lastRow one past the last row of the block.
+	 *\param boltzmannTable a BoltzmannTable reference holding the acceptance thresholds.
+	 *\param energyChange integer reference that the energy change of the accepted flips (units of 2J) is added to.
+	 *\param magnetisationChange integer reference that the magnetisation change of the accepted flips is added to.
+	 *\return number of accepted flips.
+	 */
+	long long updateRows(SpinLattice2D &lattice,
+						 int parity,
+						 int firstRow,
+						 int lastRow,
+						 const BoltzmannTable &boltzmannTable,
+						 int &energyChange,
+						 int &magnetisationChange);
+
+public:
+	/**
+	 *\brief Creates a sweeper for a lattice with a given number of rows.
+	 *\param rows integer representing the number of rows in the lattice that will be swept.
+	 *\param seed seed from which every row's random number engine is seeded.
+	 *\param threads integer representing the number of threads to use.
+	 */
+	CheckerboardSweeper(int rows, unsigned int seed, int threads);
+
+	/**
+	 *\brief Performs one sweep of the lattice, each site has exactly one proposed flip.
+	 *
+	 * Threads flip spins without touching the lattice's running energy and magnetisation and the changes
+	 * are added to them once all threads have finished each half sweep.
+	 *
+	 *\param lattice the SpinLattice2D to sweep.
+	 *\param boltzmannTable a BoltzmannTable reference holding the acceptance thresholds for the temperature of the system.
+	 *\return number of accepted flips.
+	 */
+	long long sweep(SpinLattice2D &lattice, const BoltzmannTable &boltzmannTable);
+
+	/**
+	 *\brief Getter method for the number of threads.
+	 *\return integer value representing the number of threads used.
+	 */
+	int getThreads() const;
+
+	/**
+	 *\brief Writes the state of every row's random number engine to a binary stream so it can be restored with load.
+	 *\param out the stream to write to.
+	 */
+	void save(std::ostream &out) const;
+
+	/**
+	 *\brief Restores the state of every row's random number engine written by save.
+	 *
+	 * Failures are left in the state of the stream.
+	 *
+	 *\param in the stream to read from.
+	 */
+	void load(std::istream &in);
+};
+#endif /* CheckerboardSweeper_hpp */
@@ -0,0 +1,152 @@
+#include "Checkpoint.hpp"
+#include "binaryIO.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unistd.h>
+constexpr std::uint32_t Checkpoint::version;
+const char Checkpoint::magic[4] = {'I', 'C', 'K', 'P'};
+
+Checkpoint::Checkpoint(const std::string &fileName, int interval) : m_fileName(fileName),
+																	 m_interval{interval},
+																	 m_writing{false},
+																	 m_loaded{false},
+																	 m_seed{0}
+{}
+
+Checkpoint::~Checkpoint()
+{
+	wait();
+}
+
+std::string Checkpoint::parameterRecord(const IsingInputParameters &params)
+{
+	// Only what the state depends on, e.g. the number of threads or the vector kernel can change since the results don't depend on it.
+	std::ostringstream record;
+	writeValue(record, params.rowCount);
+	writeValue(record, params.columnCount);
+	writeValue(record, params.temperature);
+	writeValue(record, params.burnPeriod);
+	writeValue(record, params.measurementInterval);
+	writeValue(record, params.dynamics);
+	writeValue(record, params.localExchange);
+	writeValue(record, params.spinModel);
+	writeValue(record, params.spinStates);
+	writeValue(record, params.jConstant);
+	writeValue(record, params.boltzmannConstant);
+	writeValue(record, params.sweeps);
+	writeValue(record, params.multiSpinCoding);
+	writeValue(record, params.vectorKernel != IsingInputParameters::NoVectorKernel);
+	writeValue(record, params.checkerboard);
+	writeValue(record, params.tiled);
+	writeValue(record, params.tileSize);
+	writeValue(record, params.nFoldWay);
+	writeValue(record, params.seed);
+	writeValue(record, params.randomEngine);
+	writeValue(record, params.streaming);
+	return record.str();
+}
+
+void Checkpoint::write(const std::string &header, const std::string &state)
+{
+	std::string temporaryName = m_fileName + ".tmp";
+	bool written = false;
+	if(std::FILE *file = std::fopen(temporaryName.c_str(), "wb"))
+	{
+		// Make sure the data is on disk before the rename makes it the checkpoint.
+		written = std::fwrite(header.data(), 1, header.size(), file) == header.size()
+				  && std::fwrite(state.data(), 1, state.size(), file) == state.size()
+				  && std::fflush(file) == 0
+				  && fsync(fileno(file)) == 0;
+		written = (std::fclose(file) == 0) && written;
+	}
+
+	if(!written || std::rename(temporaryName.c_str(), m_fileName.c_str()) != 0)
+	{
+		std::cerr << "Could not write checkpoint " << m_fileName << ", the previous one is kept." << '\n';
+		std::remove(temporaryName.c_str());
+	}
+	m_writing = false;
+}
+
+bool Checkpoint::load()
+{
+	std::ifstream file(m_fileName, std::ios::in | std::ios::binary);
+	char fileMagic[sizeof(magic)];
+	file.read(fileMagic, sizeof(fileMagic));
+	if(!file || std::memcmp(fileMagic, magic, sizeof(magic)) != 0 || readValue<std::uint32_t>(file) != version)
+	{
+		return false;
+	}
+
+	m_seed = readValue<unsigned int>(file);
+	m_parameters = readString(file);
+	std::string state = readString(file);
+	if(!file)
+	{
+		return false;
+	}
+
+	m_state.str(state);
+	m_state.clear();
+	m_loaded = true;
+	return true;
+}
+
+bool Checkpoint::isLoaded() const
+{
+	return m_loaded;
+}
+
+unsigned int Checkpoint::getSeed() const
+{
+	return m_seed;
+}
+
+bool Checkpoint::matches(const IsingInputParameters &params) const
+{
+	return m_loaded && m_parameters == parameterRecord(params);
+}
+
+std::istream& Checkpoint::state()
+{
+	return m_state;
+}
+
+bool Checkpoint::due(int sweeps) const
+{
+	return m_interval > 0 && (sweeps % m_interval) == 0;
+}
+
+bool Checkpoint::save(const IsingInputParameters &params, std::string state)
+{
+	if(m_writing)
+	{
+		return false;
+	}
+	wait();
+
+	// The header is small so is built here, the state is only moved to the writer thread.
+	std::ostringstream header;
+	header.write(magic, sizeof(magic));
+	writeValue(header, version);
+	writeValue(header, params.seed);
+	writeString(header, parameterRecord(params));
+	writeValue(header, static_cast<std::uint64_t>(state.size()));
+
+	m_writing = true;
+	m_writer = std::thread([this](const std::string &header, const std::string &state)
+	{
+		write(header, state);
+	}, header.str(), std::move(state));
+	return true;
+}
+
+void Checkpoint::wait()
+{
+	if(m_writer.joinable())
+	{
+		m_writer.join();
+	}
+}
@@ -0,0 +1,156 @@
+#ifndef Checkpoint_hpp
+#define Checkpoint_hpp
+#include <atomic>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "IsingInputParameters.hpp"
+
+/**
+ *\file
+ *\class Checkpoint
+ *\brief Periodically saves the state of a simulation to a file so it can be resumed after being stopped.
+ *
+ * The simulation serialises its state (the sweep reached, the random number engines, the lattice and the
+ * measurements) into memory and hands it over, the file is then written on a background thread so the sweeps
+ * carry on. The state is written to a temporary file which is renamed over the previous checkpoint once it is
+ * complete, so the checkpoint on disk is always either the previous one or the new one and never half written.
+ * If the previous checkpoint is still being written when the next is due the new one is skipped, which bounds the
+ * time spent on checkpoints to that of copying the state into memory.
+ *
+ * The file also holds the parameters the state depends on, a simulation is only resumed with the same ones so it
+ * continues exactly as if it had never stopped.
+ */
+class Checkpoint
+{
+public:
+	/// First four bytes of every checkpoint file.
+	static const char magic[4];
+
+	/// Version of the file format.
+	static constexpr std::uint32_t version = 8;
+
+private:
+	/**
+	 *\brief Member variable holding the name of the checkpoint file.
+	 */
+	std::string m_fileName;
+
+	/**
+	 *\brief Member variable integer holding the number of sweeps between checkpoints, 0 for none.
+	 */
+	int m_interval;
+
+	/**
+	 *\brief Member variable holding the thread writing the last checkpoint.
+	 */
+	std::thread m_writer;
+
+	/**
+	 *\brief Member variable set while a checkpoint is being written.
+	 */
+	std::atomic<bool> m_writing;
+
+	/**
+	 *\brief Member variable set if a checkpoint has been loaded.
+	 */
+	bool m_loaded;
+
+	/**
+	 *\brief Member variable holding the seed of the loaded checkpoint.
+	 */
+	unsigned int m_seed;
+
+	/**
+	 *\brief Member variable holding the record of the parameters of the loaded checkpoint.
+	 */
+	std::string m_parameters;
+
+	/**
+	 *\brief Member variable holding the state of the loaded checkpoint.
+	 */
+	std::istringstream m_state;
+
+	/**
+	 *\brief Records the parameters a state depends on.
+	 *\param params IsingInputParameters reference holding the simulation parameters.
+	 *\return string holding the parameters.
+	 */
+	static std::string parameterRecord(const IsingInputParameters &params);
+
+	/**
+	 *\brief Writes a checkpoint file and renames it into place, run on the writer thread.
+	 *\param header the header of the file.
+	 *\param state the serialised state of the simulation.
+	 */
+	void write(const std::string &header, const std::string &state);
+
+public:
+	/**
+	 *\brief Creates a checkpoint that saves to a file.
+	 *\param fileName name of the checkpoint file.
+	 *\param interval integer number of sweeps between checkpoints, 0 to never save.
+	 */
+	Checkpoint(const std::string &fileName, int interval);
+
+	/**
+	 *\brief Waits for a checkpoint being written to be finished.
+	 */
+	~Checkpoint();
+
+	Checkpoint(const Checkpoint&) = delete;
+	Checkpoint& operator=(const Checkpoint&) = delete;
+
+	/**
+	 *\brief Reads the checkpoint file so the simulation can be resumed from it.
+	 *\return false if the file doesn't exist or isn't a complete checkpoint.
+	 */
+	bool load();
+
+	/**
+	 *\brief Whether a checkpoint has been loaded.
+	 *\return true if load succeeded.
+	 */
+	bool isLoaded() const;
+
+	/**
+	 *\brief Getter method for the seed of the loaded checkpoint.
+	 *\return the seed the checkpointed simulation was started with.
+	 */
+	unsigned int getSeed() const;
+
+	/**
+	 *\brief Whether the loaded checkpoint was saved by a simulation with the same parameters.
+	 *\param params IsingInputParameters reference holding the simulation parameters.
+	 *\return true if the state can be resumed with these parameters.
+	 */
+	bool matches(const IsingInputParameters &params) const;
+
+	/**
+	 *\brief Gets the state of the loaded checkpoint.
+	 *\return stream holding the state in the order it was saved.
+	 */
+	std::istream& state();
+
+	/**
+	 *\brief Whether a checkpoint is due.
+	 *\param sweeps integer number of sweeps completed.
+	 *\return true if a checkpoint should be saved after this many sweeps.
+	 */
+	bool due(int sweeps) const;
+
+	/**
+	 *\brief Saves a state in the background.
+	 *\param params IsingInputParameters reference holding the simulation parameters.
+	 *\param state the serialised state of the simulation, moved to the writer thread.
+	 *\return false if the checkpoint was skipped because the previous one is still being written.
+	 */
+	bool save(const IsingInputParameters &params, std::string state);
+
+	/**
+	 *\brief Blocks until the checkpoint being written, if any, is finished.
+	 */
+	void wait();
+};
+#endif /* Checkpoint_hpp */
@@ -1,4 +1,8 @@
 #include "DataArray.hpp"
+#include "binaryIO.hpp"
+#include "fastFourierTransform.hpp"
+#include <complex>
+#include <algorithm>
 
 DataArray::DataArray():m_size{0}{}
 
@@ -76,6 +80,19 @@ double DataArray::variance() const
   return squareMean() - mean()*mean();
 }
 
+double DataArray::centredVariance() const
+{
+    double mean_m = mean();
+    double sum = 0;
+
+    for(const auto& point : m_data)
+    {
+        sum += (point - mean_m) * (point - mean_m);
+    }
+
+    return sum/m_size;
+}
+
 double DataArray::error() const
 {
       return std::sqrt(variance() / (m_size - 1));
@@ -97,40 +114,113 @@ std::ostream& operator<<(std::ostream& out, const DataArray& data)
 
 double DataArray::autoCorrelation(int t) const
 {
-    double term1          = 0;
-    double mean_m         = 0;
-    double mean_mSquared  = 0;
-
-    for(int point = 0; point < m_size; ++point)
+    double normalisation = centredVariance();
+    if(normalisation == 0)
     {
-        term1 += m_data[point]*m_data[(point+t)%m_size];
-        mean_m += m_data[point];
-        mean_mSquared += m_data[point] * m_data[point];
+        return (t == 0) ? 1.0 : 0.0;
     }
 
-    term1         /= m_size;
-    mean_m        /= m_size;
-    mean_mSquared /= m_size;
+    double mean_m = mean();
+    double autoCovariance = 0;
 
-    double normalisation = mean_mSquared - mean_m * mean_m;
-    double term2 = mean_m * mean_m;
+    for(int point = 0; point + t < m_size; ++point)
+    {
+        autoCovariance += (m_data[point] - mean_m) * (m_data[point+t] - mean_m);
+    }
+
+    autoCovariance /= (m_size - t);
 
-    return (term1-term2)/normalisation;
+    return autoCovariance/normalisation;
 }
 
 std::vector<double> DataArray::autoCorrelation(int t1, int t2) const
 {
+    t2 = std::min(t2, m_size);
     std::vector<double> autoCorrelationData;
+    if(t1 >= t2)
+    {
+        return autoCorrelationData;
+    }
+
+    // Zero pad to a power of two at least twice the size so the circular correlation of the FFT doesn't wrap.
+    int paddedSize = 1;
+    while(paddedSize < 2 * m_size)
+    {
+        paddedSize <<= 1;
+    }
+
+    double mean_m = mean();
+    std::vector<std::complex<double> > transform(paddedSize);
+    for(int point = 0; point < m_size; ++point)
+    {
+        transform[point] = m_data[point] - mean_m;
+    }
+
+    // The inverse transform of the power spectrum is the sum of products at every lag.
+    fastFourierTransform(transform, false);
+    for(auto& value : transform)
+    {
+        value = std::norm(value);
+    }
+    fastFourierTransform(transform, true);
+
+    // The zero lag sum is the centred variance times the number of samples.
+    double normalisation = transform[0].real() / m_size;
     autoCorrelationData.reserve(t2-t1);
     for(int t = t1; t < t2; ++t)
     {
-        autoCorrelationData.push_back(autoCorrelation(t));
+        if(normalisation == 0)
+        {
+            autoCorrelationData.push_back((t == 0) ? 1.0 : 0.0);
+        }
+        else
+        {
+            autoCorrelationData.push_back(transform[t].real() / (m_size - t) / normalisation);
+        }
     }
 
     return autoCorrelationData;
 }
 
+double DataArray::integratedAutoCorrelationTime(const std::vector<double> &autoCorrelation, int &window, double c) const
+{
+    double tau = 0.5;
+    if(centredVariance() == 0)
+    {
+        window = 0;
+        return tau;
+    }
+
+    for(window = 1; window < static_cast<int>(autoCorrelation.size()); ++window)
+    {
+        tau += autoCorrelation[window];
+        if(window >= c * tau)
+        {
+            break;
+        }
+    }
+
+    window = std::min(window, m_size - 1);
+    return tau;
+}
+
+double DataArray::integratedAutoCorrelationTimeError(double tau, int window) const
+{
+    return tau * std::sqrt(2.0 * (2 * window + 1) / m_size);
+}
+
 int DataArray::getSize() const
 {
 	return m_size;
 }
+
+void DataArray::save(std::ostream &out) const
+{
+    writeVector(out, m_data);
+}
+
+void DataArray::load(std::istream &in)
+{
+    readVector(in, m_data);
+    m_size = static_cast<int>(m_data.size());
+}
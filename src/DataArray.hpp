@@ -27,6 +27,16 @@ private:
      */
     int m_size;
 
+    /**
+     *\brief Method to calculate the variance as the mean of the squared deviations from the mean.
+     *
+     * Summing the centred values doesn't lose the precision that squareMean - mean^2 does when the mean is
+     * large compared to the spread, so it is used to normalise the autocorrelation functions.
+     *
+     *\return floating point value representing the variance of the data.
+     */
+    double centredVariance() const;
+
 public:
 	/**
 	 *\class IDataFunctor
@@ -51,6 +61,29 @@ public:
 			virtual double operator()(const DataArray &data) const = 0;
 	};
 
+	/**
+	 *\class IMomentFunctor
+	 *\brief Interface for a functor that only depends on the first and second moment of a sample set.
+	 *
+	 * Functions like the susceptibility and heat capacity only need the mean and square mean of the samples,
+	 * implementing this interface lets them be evaluated from running moments (e.g. StreamingStatistics)
+	 * without keeping the samples.
+	 */
+	class IMomentFunctor
+	{
+		public:
+			/**
+			 *\brief Operator() overload so the class behaves as a function (functor)
+			 *
+			 * Is pure virtual.
+			 *
+			 *\param mean floating point value representing the mean of the samples.
+			 *\param squareMean floating point value representing the mean of the squares of the samples.
+			 *\return a floating point value representing the result of the function.
+			 */
+			virtual double operator()(double mean, double squareMean) const = 0;
+	};
+
 	/**
 	 *\brief Default constructor.
 	 */
@@ -156,19 +189,72 @@ public:
 
     /**
      *\brief function to calculate the autocorrelation function for a specific computer time.
-     *\param t time value to compute autocorrelation of data for.
+     *
+     * The autocovariance at lag t is averaged over the N - t pairs of samples t apart, without wrapping around
+     * the end of the data, and normalised by the variance. This is O(N), use the range version for many lags.
+     * A constant sample set is taken to be uncorrelated, so the value is 1 at lag 0 and 0 at every other lag.
+     *
+     *\param t time value to compute autocorrelation of data for, must be less than the number of samples.
      *\return floating point value representing value of autocorrelation function.
      */
     double autoCorrelation(int t) const;
 
     /**
      *\brief function to calculate the autocorrelation function for a range computer times.
+     *
+     * Every lag is calculated at once from the power spectrum of the data zero padded to at least twice its
+     * length, so the sums don't wrap around, which takes O(N log N) time however large the range. The values
+     * are the same as those of the single lag version, including for a constant sample set.
+     *
      *\param t1 initial time value to compute autocorrelation of data for.
-     *\param t2 final time value to compute autocorrelation for.
+     *\param t2 final time value to compute autocorrelation for, lags from the number of samples on are left out.
      *\return vector of floating point values representing values of autocorrelation function indexed
      * according to their position in the vector.
      */
     std::vector<double> autoCorrelation(int t1, int t2) const;
+
+    /**
+     *\brief Method to calculate the integrated autocorrelation time with automatic windowing.
+     *
+     * tau_int = 1/2 + Sum_{t=1}^{W} rho(t) where the window W is the smallest with W >= c tau_int(W) (Sokal),
+     * which cuts off the noise in the tail of the autocorrelation function while keeping the bias small. The
+     * naive error of the mean should be multiplied by sqrt(2 tau_int) for correlated samples. The autocorrelation
+     * function is passed in so that the one written out can be reused rather than transformed a second time. A
+     * constant sample set, e.g. the magnetisation under Kawasaki dynamics, gives tau_int = 1/2 with a window of 0.
+     *
+     *\param autoCorrelation vector of floating point values of the autocorrelation function from lag 0, as returned
+     * by autoCorrelation(0, getSize()), the sum stops at its end if the window isn't reached before.
+     *\param window integer reference that is set to the window W chosen.
+     *\param c floating point value of the windowing constant, 6 works well for roughly exponential decay.
+     *\return floating point value representing the integrated autocorrelation time in units of samples.
+     */
+    double integratedAutoCorrelationTime(const std::vector<double> &autoCorrelation, int &window, double c = 6.0) const;
+
+    /**
+     *\brief Method to estimate the statistical error of the integrated autocorrelation time.
+     *
+     * Uses the Madras-Sokal approximation error = tau_int * sqrt(2 (2W + 1) / N).
+     *
+     *\param tau floating point value representing the integrated autocorrelation time.
+     *\param window integer value representing the window it was summed over.
+     *\return floating point value representing the error.
+     */
+    double integratedAutoCorrelationTimeError(double tau, int window) const;
+
+    /**
+     *\brief Writes the samples to a binary stream so it can be restored with load.
+     *\param out the stream to write to.
+     */
+    void save(std::ostream &out) const;
+
+    /**
+     *\brief Restores the samples written by save.
+     *
+     * Failures are left in the state of the stream.
+     *
+     *\param in the stream to read from.
+     */
+    void load(std::istream &in);
 };
 
 #endif /* DataArray_hpp */
@@ -0,0 +1,243 @@
+#include "DistributedSpinLattice2D.hpp"
+#ifdef ISING_USE_MPI
+
+namespace
+{
+	// Tags of boundary rows travelling to the rank above and to the rank below, these differ so the two
+	// messages can't be confused when both neighbours are the same rank.
+	constexpr int upTag = 0;
+	constexpr int downTag = 1;
+
+	int rankOf(MPI_Comm communicator)
+	{
+		int rank;
+		MPI_Comm_rank(communicator, &rank);
+		return rank;
+	}
+
+	int rankCountOf(MPI_Comm communicator)
+	{
+		int rankCount;
+		MPI_Comm_size(communicator, &rankCount);
+		return rankCount;
+	}
+}
+
+DistributedSpinLattice2D::DistributedSpinLattice2D(int rows, int cols, unsigned int seed, MPI_Comm communicator) :
+	m_communicator{communicator},
+	m_rank{rankOf(communicator)},
+	m_rankCount{rankCountOf(communicator)},
+	m_rankAbove{(m_rank + m_rankCount - 1) % m_rankCount},
+	m_rankBelow{(m_rank + 1) % m_rankCount},
+	m_rowCount{rows},
+	m_colCount{cols},
+	m_firstRow{(rows * m_rank) / m_rankCount},
+	m_localRows{(rows * (m_rank + 1)) / m_rankCount - m_firstRow},
+	m_strip(m_localRows + 2, cols),
+	m_sendUp(cols),
+	m_sendDown(cols),
+	m_receiveAbove(cols),
+	m_receiveBelow(cols)
+{
+	// Seed every row's engine exactly as CheckerboardSweeper does so the streams don't depend on the ranks.
+	m_rowGenerators.reserve(m_localRows);
+	for(int row = 0; row < m_localRows; ++row)
+	{
+		std::seed_seq sequence{seed, static_cast<unsigned int>(m_firstRow + row)};
+		m_rowGenerators.emplace_back(sequence);
+	}
+
+	MPI_Request requests[4];
+	startHaloExchange(requests);
+	finishHaloExchange(requests);
+
+	m_localBondSum = recomputeLocalBondSum();
+	m_localMagnetisation = recomputeLocalMagnetisation();
+}
+
+long long DistributedSpinLattice2D::updateRow(int row, int parity, const BoltzmannTable &boltzmannTable)
+{
+	std::default_random_engine &generator = m_rowGenerators[row-1];
+	long long accepted = 0;
+	int globalRow = m_firstRow + row - 1;
+
+	// First site on this sublattice is column 0 if row + parity is even, otherwise column 1.
+	for(int col = (globalRow + parity) % 2; col < m_colCount; col += 2)
+	{
+		int flipEnergyChange = m_strip.flipEnergyChange(row, col);
+		if(boltzmannTable.accept(flipEnergyChange, generator))
+		{
+			m_localBondSum -= 2 * flipEnergyChange;
+			m_localMagnetisation -= 2 * SpinLattice2D::spinValues[m_strip.spin(row, col)];
+			m_strip.flipUntracked(row, col);
+			++accepted;
+		}
+	}
+	return accepted;
+}
+
+void DistributedSpinLattice2D::packRow(int row, std::vector<char> &buffer) const
+{
+	for(int col = 0; col < m_colCount; ++col)
+	{
+		buffer[col] = static_cast<char>(m_strip(row, col));
+	}
+}
+
+void DistributedSpinLattice2D::unpackRow(int row, const std::vector<char> &buffer)
+{
+	// The strip's own running totals are never used so flipping the halo spins that changed is enough.
+	for(int col = 0; col < m_colCount; ++col)
+	{
+		if(m_strip(row, col) != static_cast<SpinLattice2D::Spin>(buffer[col]))
+		{
+			m_strip.flipUntracked(row, col);
+		}
+	}
+}
+
+void DistributedSpinLattice2D::startHaloExchange(MPI_Request *requests)
+{
+	packRow(1, m_sendUp);
+	packRow(m_localRows, m_sendDown);
+	MPI_Irecv(m_receiveAbove.data(), m_colCount, MPI_CHAR, m_rankAbove, downTag, m_communicator, &requests[0]);
+	MPI_Irecv(m_receiveBelow.data(), m_colCount, MPI_CHAR, m_rankBelow, upTag, m_communicator, &requests[1]);
+	MPI_Isend(m_sendUp.data(), m_colCount, MPI_CHAR, m_rankAbove, upTag, m_communicator, &requests[2]);
+	MPI_Isend(m_sendDown.data(), m_colCount, MPI_CHAR, m_rankBelow, downTag, m_communicator, &requests[3]);
+}
+
+void DistributedSpinLattice2D::finishHaloExchange(MPI_Request *requests)
+{
+	MPI_Waitall(4, requests, MPI_STATUSES_IGNORE);
+	unpackRow(0, m_receiveAbove);
+	unpackRow(m_localRows + 1, m_receiveBelow);
+}
+
+long long DistributedSpinLattice2D::sweep(const BoltzmannTable &boltzmannTable)
+{
+	long long accepted = 0;
+	for(int parity = 0; parity < 2; ++parity)
+	{
+		// The boundary rows are updated first so they can be sent while the interior is updated. Sites of one
+		// sublattice only depend on the other so the halos are not needed again until the next half sweep.
+		accepted += updateRow(1, parity, boltzmannTable);
+		if(m_localRows > 1)
+		{
+			accepted += updateRow(m_localRows, parity, boltzmannTable);
+		}
+
+		MPI_Request requests[4];
+		startHaloExchange(requests);
+
+		for(int row = 2; row < m_localRows; ++row)
+		{
+			accepted += updateRow(row, parity, boltzmannTable);
+		}
+
+		finishHaloExchange(requests);
+	}
+	return accepted;
+}
+
+long long DistributedSpinLattice2D::recomputeLocalBondSum() const
+{
+	long long bondSum = 0;
+	for(int row = 1; row <= m_localRows; ++row)
+	{
+		for(int col = 0; col < m_colCount; ++col)
+		{
+			int spin = SpinLattice2D::spinValues[m_strip(row, col)];
+			bondSum += spin * (SpinLattice2D::spinValues[m_strip(row, col+1)] + SpinLattice2D::spinValues[m_strip(row+1, col)]);
+		}
+	}
+	return bondSum;
+}
+
+long long DistributedSpinLattice2D::recomputeLocalMagnetisation() const
+{
+	long long magnetisation = 0;
+	for(int row = 1; row <= m_localRows; ++row)
+	{
+		for(int col = 0; col < m_colCount; ++col)
+		{
+			magnetisation += SpinLattice2D::spinValues[m_strip(row, col)];
+		}
+	}
+	return magnetisation;
+}
+
+double DistributedSpinLattice2D::latticeEnergy(const double jConstant) const
+{
+	long long bondSum = 0;
+	MPI_Allreduce(&m_localBondSum, &bondSum, 1, MPI_LONG_LONG, MPI_SUM, m_communicator);
+	return -1.0 * jConstant * bondSum;
+}
+
+double DistributedSpinLattice2D::recomputeLatticeEnergy(const double jConstant) const
+{
+	long long localBondSum = recomputeLocalBondSum();
+	long long bondSum = 0;
+	MPI_Allreduce(&localBondSum, &bondSum, 1, MPI_LONG_LONG, MPI_SUM, m_communicator);
+	return -1.0 * jConstant * bondSum;
+}
+
+int DistributedSpinLattice2D::totalMag() const
+{
+	long long magnetisation = 0;
+	MPI_Allreduce(&m_localMagnetisation, &magnetisation, 1, MPI_LONG_LONG, MPI_SUM, m_communicator);
+	return static_cast<int>(magnetisation);
+}
+
+int DistributedSpinLattice2D::recomputeTotalMag() const
+{
+	long long localMagnetisation = recomputeLocalMagnetisation();
+	long long magnetisation = 0;
+	MPI_Allreduce(&localMagnetisation, &magnetisation, 1, MPI_LONG_LONG, MPI_SUM, m_communicator);
+	return static_cast<int>(magnetisation);
+}
+
+void DistributedSpinLattice2D::gather(SpinLattice2D &lattice) const
+{
+	std::vector<char> strip(m_localRows * m_colCount);
+	for(int row = 0; row < m_localRows; ++row)
+	{
+		for(int col = 0; col < m_colCount; ++col)
+		{
+			strip[row * m_colCount + col] = static_cast<char>(m_strip(row + 1, col));
+		}
+	}
+
+	std::vector<int> counts(m_rankCount);
+	std::vector<int> offsets(m_rankCount);
+	for(int rank = 0; rank < m_rankCount; ++rank)
+	{
+		int firstRow = (m_rowCount * rank) / m_rankCount;
+		offsets[rank] = firstRow * m_colCount;
+		counts[rank]  = ((m_rowCount * (rank + 1)) / m_rankCount - firstRow) * m_colCount;
+	}
+
+	std::vector<char> whole(m_rank == 0 ? m_rowCount * m_colCount : 0);
+	MPI_Gatherv(strip.data(), static_cast<int>(strip.size()), MPI_CHAR,
+				whole.data(), counts.data(), offsets.data(), MPI_CHAR, 0, m_communicator);
+
+	if(m_rank == 0)
+	{
+		// Flip so the lattice keeps its own running totals consistent.
+		for(int row = 0; row < m_rowCount; ++row)
+		{
+			for(int col = 0; col < m_colCount; ++col)
+			{
+				if(lattice(row, col) != static_cast<SpinLattice2D::Spin>(whole[row * m_colCount + col]))
+				{
+					lattice.flip(row, col);
+				}
+			}
+		}
+	}
+}
+
+int DistributedSpinLattice2D::getRank() const
+{
+	return m_rank;
+}
+#endif /* ISING_USE_MPI */
@@ -0,0 +1,204 @@
+#ifndef DistributedSpinLattice2D_hpp
+#define DistributedSpinLattice2D_hpp
+#ifdef ISING_USE_MPI
+#include <mpi.h>
+#include <random>
+#include <vector>
+#include "SpinLattice2D.hpp"
+#include "BoltzmannTable.hpp"
+
+/**
+ *\file
+ *\class DistributedSpinLattice2D
+ *\brief Models a 2D spin lattice split into strips of rows across MPI ranks.
+ *
+ * Each rank owns a contiguous strip of rows and stores it in a SpinLattice2D with one extra ghost (halo) row
+ * above and below holding copies of the neighbouring ranks' boundary rows. Columns are periodic within the
+ * strip and rows are periodic across the ranks. The lattice is swept with checkerboard Glauber updates and
+ * the boundary rows are exchanged after each half sweep. Each half sweep updates the two boundary rows first,
+ * starts sending them with non-blocking communication and then updates the interior rows while the messages
+ * are in flight.
+ *
+ * Every row has its own random number engine seeded from the user seed and the global row index in the same
+ * way as CheckerboardSweeper, so for a given seed the trajectory is identical to a checkerboard run in a single
+ * process for any number of ranks. The energy and magnetisation are tracked incrementally on every rank and
+ * summed with reductions, so those methods must be called by every rank.
+ */
+class DistributedSpinLattice2D
+{
+private:
+	/**
+	 *\brief Member variable holding the communicator the lattice is split across.
+	 */
+	MPI_Comm m_communicator;
+
+	/**
+	 *\brief Member variable integer holding this rank and the number of ranks.
+	 */
+	int m_rank;
+	int m_rankCount;
+
+	/**
+	 *\brief Member variable integers holding the ranks owning the strips above and below this one.
+	 */
+	int m_rankAbove;
+	int m_rankBelow;
+
+	/**
+	 *\brief Member variable integers holding the number of rows and columns of the whole lattice.
+	 */
+	int m_rowCount;
+	int m_colCount;
+
+	/**
+	 *\brief Member variable integer holding the global index of the first row owned by this rank.
+	 */
+	int m_firstRow;
+
+	/**
+	 *\brief Member variable integer holding the number of rows owned by this rank.
+	 */
+	int m_localRows;
+
+	/**
+	 *\brief Member variable holding the strip, row 0 and row m_localRows + 1 are the halo rows.
+	 */
+	SpinLattice2D m_strip;
+
+	/**
+	 *\brief Member variable holding one random number engine per owned row.
+	 */
+	std::vector<std::default_random_engine> m_rowGenerators;
+
+	/**
+	 *\brief Buffers holding the packed boundary rows being sent and the halo rows being received.
+	 */
+	std::vector<char> m_sendUp;
+	std::vector<char> m_sendDown;
+	std::vector<char> m_receiveAbove;
+	std::vector<char> m_receiveBelow;
+
+	/**
+	 *\brief Member variable holding the part of the running bond sum from the flips of this rank.
+	 *
+	 * It starts as the sum of S_site * S_neighbour over the bonds to the right of and below the owned sites so
+	 * the sum over all ranks is the bond sum of the whole lattice.
+	 */
+	long long m_localBondSum;
+
+	/**
+	 *\brief Member variable holding the magnetisation of the owned sites.
+	 */
+	long long m_localMagnetisation;
+
+	/**
+	 *\brief Updates every site of one sublattice in one owned row.
+	 *\param row local index of the row.
+	 *\param parity the sublattice to update, sites with (globalRow + col) % 2 == parity are updated.
+	 *\param boltzmannTable a BoltzmannTable reference holding the acceptance thresholds.
+	 *\return number of accepted flips.
+	 */
+	long long updateRow(int row, int parity, const BoltzmannTable &boltzmannTable);
+
+	/**
+	 *\brief Packs an owned row into a buffer, one char per spin.
+	 *\param row local index of the row.
+	 *\param buffer buffer to pack into.
+	 */
+	void packRow(int row, std::vector<char> &buffer) const;
+
+	/**
+	 *\brief Copies a received buffer into a halo row.
+	 *\param row local index of the halo row.
+	 *\param buffer buffer holding the packed row.
+	 */
+	void unpackRow(int row, const std::vector<char> &buffer);
+
+	/**
+	 *\brief Starts sending the boundary rows to the neighbouring ranks and receiving the halo rows from them.
+	 *\param requests array of four requests that are set to the started communications.
+	 */
+	void startHaloExchange(MPI_Request *requests);
+
+	/**
+	 *\brief Waits for the communications started by startHaloExchange and copies the halo rows in.
+	 *\param requests array of four requests returned by startHaloExchange.
+	 */
+	void finishHaloExchange(MPI_Request *requests);
+
+	/**
+	 *\brief Calculates the local part of the bond sum from scratch.
+	 *\return the sum of S_site * S_neighbour over the bonds right of and below the owned sites.
+	 */
+	long long recomputeLocalBondSum() const;
+
+	/**
+	 *\brief Calculates the magnetisation of the owned sites from scratch.
+	 *\return the sum of the owned spins.
+	 */
+	long long recomputeLocalMagnetisation() const;
+
+public:
+	/**
+	 *\brief Creates the strip of a distributed lattice owned by the calling rank; initially all spins up.
+	 *
+	 * Must be called by every rank of the communicator.
+	 *
+	 *\param rows integer representing the number of rows in the whole lattice, at least the number of ranks.
+	 *\param cols integer representing the number of columns in the whole lattice.
+	 *\param seed seed from which every row's random number engine is seeded.
+	 *\param communicator the communicator to split the lattice across.
+	 */
+	DistributedSpinLattice2D(int rows, int cols, unsigned int seed, MPI_Comm communicator);
+
+	/**
+	 *\brief Performs one checkerboard sweep of the whole lattice, each site has exactly one proposed flip.
+	 *
+	 * Must be called by every rank of the communicator.
+	 *
+	 *\param boltzmannTable a BoltzmannTable reference holding the acceptance thresholds for the temperature of the system.
+	 *\return number of flips accepted on this rank.
+	 */
+	long long sweep(const BoltzmannTable &boltzmannTable);
+
+	/**
+	 *\brief Gets the total energy of the whole lattice by summing the running totals of every rank.
+	 *\param jConstant constant floating point value representing the value of the J constant.
+	 *\return floating point value representing the energy, on every rank.
+	 */
+	double latticeEnergy(const double jConstant) const;
+
+	/**
+	 *\brief Calculates the total energy of the whole lattice from scratch, used to check the running total.
+	 *\param jConstant constant floating point value representing the value of the J constant.
+	 *\return floating point value representing the energy, on every rank.
+	 */
+	double recomputeLatticeEnergy(const double jConstant) const;
+
+	/**
+	 *\brief Gets the total magnetisation of the whole lattice by summing the running totals of every rank.
+	 *\return integer value representing the total magnetisation, on every rank.
+	 */
+	int totalMag() const;
+
+	/**
+	 *\brief Calculates the total magnetisation of the whole lattice from scratch, used to check the running total.
+	 *\return integer value representing the total magnetisation, on every rank.
+	 */
+	int recomputeTotalMag() const;
+
+	/**
+	 *\brief Collects the strips of every rank into a whole lattice on rank 0.
+	 *\param lattice SpinLattice2D reference with the dimensions of the whole lattice that is set on rank 0, it is
+	 * left unchanged on the other ranks.
+	 */
+	void gather(SpinLattice2D &lattice) const;
+
+	/**
+	 *\brief Getter method for the rank of this process.
+	 *\return integer value representing the rank.
+	 */
+	int getRank() const;
+};
+#endif /* ISING_USE_MPI */
+#endif /* DistributedSpinLattice2D_hpp */
@@ -6,5 +6,10 @@ HeatCapacity::HeatCapacity(double boltzmannConstant, double temperature) : 	m_bo
 
 double HeatCapacity::operator()(const DataArray &data) const
 {
-	return 1/(m_boltzmannConstant * m_temperature * m_temperature) * (data.variance()); 
+	return (*this)(data.mean(), data.squareMean());
+}
+
+double HeatCapacity::operator()(double mean, double squareMean) const
+{
+	return 1/(m_boltzmannConstant * m_temperature * m_temperature) * (squareMean - mean * mean);
 }
@@ -2,7 +2,7 @@
 #define HeatCapacity_hpp
 #include "DataArray.hpp"
 
-class HeatCapacity : public DataArray::IDataFunctor
+class HeatCapacity : public DataArray::IDataFunctor, public DataArray::IMomentFunctor
 {
 private:
 	double m_boltzmannConstant;
@@ -10,6 +10,7 @@ private:
 public:
 	HeatCapacity(double boltzmannConstant, double temperature);
 	virtual double operator()(const DataArray &data) const override;
+	virtual double operator()(double mean, double squareMean) const override;
 };
 
 #endif /* HeatCapacity_hpp */
\ No newline at end of file
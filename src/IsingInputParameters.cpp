@@ -1,4 +1,20 @@
 #include "IsingInputParameters.hpp"
+#include <string>
+
+namespace
+{
+	// Names of the dynamics indexed by IsingInputParameters::DynamicsType.
+	const char* dynamicsNames[] = {"Glauber", "Kawasaki", "Wolff", "Swendsen-Wang"};
+
+	// Names of the models indexed by IsingInputParameters::SpinModelType.
+	const char* spinModelNames[] = {"Ising", "Potts", "Spin-S"};
+
+	// Names of the engines indexed by IsingInputParameters::RandomEngineType.
+	const char* randomEngineNames[] = {"Minstd", "Xoshiro256**", "Philox4x32-10"};
+
+	// Names of the kernels indexed by IsingInputParameters::VectorKernelType.
+	const char* vectorKernelNames[] = {"None", "Scalar", "AVX2", "AVX-512"};
+}
 
 std::ostream& operator<<(std::ostream& out, const IsingInputParameters& params)
 {
@@ -6,14 +22,71 @@ std::ostream& operator<<(std::ostream& out, const IsingInputParameters& params)
     out << "Input-Parameters..." << '\n';
     out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Rows: " << std::right << params.rowCount << '\n';
     out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Columns: " << std::right << params.columnCount << '\n';
-    out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Dynamics: " << std::right << ((params.dynamics==IsingInputParameters::Kawasaki) ? "Kawasaki" : "Glauber") << '\n';
+    out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Model: " << std::right << spinModelNames[params.spinModel] << '\n';
+    if(params.spinModel != IsingInputParameters::Ising)
+    {
+        out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Spin-States: " << std::right << params.spinStates << '\n';
+    }
+    out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Dynamics: " << std::right << dynamicsNames[params.dynamics] << '\n';
+    if(params.dynamics == IsingInputParameters::Kawasaki)
+    {
+        out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Kawasaki-Exchange: " << std::right << (params.localExchange ? "Local" : "Global") << '\n';
+    }
+    out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Lattice-Storage: " << std::right << (params.multiSpinCoding ? "Multi-Spin-Coded" : (params.vectorKernel != IsingInputParameters::NoVectorKernel ? "Byte-Checkerboard" : "Standard")) << '\n';
+    if(params.vectorKernel != IsingInputParameters::NoVectorKernel)
+    {
+        out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Vector-Kernel: " << std::right << vectorKernelNames[params.vectorKernel] << '\n';
+    }
+    out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Update-Order: " << std::right << (params.checkerboard ? "Checkerboard" : (params.tiled ? "Tiled" : (params.nFoldWay ? "N-Fold-Way" : "Random-Site"))) << '\n';
+    if(params.tiled)
+    {
+        out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Tile-Size: " << std::right << params.tileSize << '\n';
+    }
+    out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Threads: " << std::right << params.threads << '\n';
+    if(params.distributed)
+    {
+        out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "MPI-Ranks: " << std::right << params.ranks << '\n';
+    }
+    out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Seed: " << std::right << params.seed << '\n';
+    out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Random-Engine: " << std::right << randomEngineNames[params.randomEngine] << '\n';
     out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Temperature: " << std::right << params.temperature << '\n';
+    if(!params.temperatures.empty())
+    {
+        out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Temperatures: " << std::right;
+        for(int i = 0; i < static_cast<int>(params.temperatures.size()); ++i)
+        {
+            out << (i ? "," : "") << params.temperatures[i];
+        }
+        out << '\n';
+        out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Temperature-Mode: " << std::right << (params.replicaExchange ? "Replica-Exchange" : "Batch") << '\n';
+        if(params.replicaExchange)
+        {
+            out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Swap-Interval: " << std::right << params.swapInterval << '\n';
+        }
+    }
     out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "J: " << std::right << params.jConstant << '\n';
     out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "K_B: " << std::right << params.boltzmannConstant << '\n';
     out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Burn-Period: " << std::right << params.burnPeriod<< '\n';
 	out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Sweeps: " << std::right << params.sweeps<< '\n';
     out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Measurement-Interval: " << std::right << params.measurementInterval << '\n';
     out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Autocorrelation-Range: " << std::right << params.autoCorrelationRange << '\n';
-    out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Error-Method-Used: " << std::right << ((params.errorType==IsingInputParameters::Bootstrap) ? "Bootstrap" : "Jack-Knife") << '\n';
+    out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Sample-Storage: " << std::right << (params.streaming ? "Streaming" : "Full") << '\n';
+    if(params.trajectory)
+    {
+        out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Trajectory-Keyframe-Interval: " << std::right << params.keyFrameInterval << '\n';
+    }
+    if(params.checkpointInterval > 0)
+    {
+        out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Checkpoint-Interval: " << std::right << params.checkpointInterval << '\n';
+    }
+    out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Error-Method-Used: " << std::right << (params.streaming ? "Binned" : ((params.errorType==IsingInputParameters::Bootstrap) ? "Bootstrap" : "Jack-Knife")) << '\n';
+    if(!params.streaming && params.errorType == IsingInputParameters::Bootstrap)
+    {
+        out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Bootstrap-Block-Length: " << std::right << params.bootstrapBlockLength << '\n';
+    }
+    if(!params.streaming && params.errorType == IsingInputParameters::JackKnife)
+    {
+        out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Jack-Knife-Bins: " << std::right << (params.jackKnifeBins ? std::to_string(params.jackKnifeBins) : "Per-Sample") << '\n';
+    }
     return out;
 }
\ No newline at end of file
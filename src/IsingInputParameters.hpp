@@ -2,6 +2,7 @@
 #define IsingInputParameters_hpp
 #include <iostream>
 #include <iomanip>
+#include <vector>
 /**
  *\file 
  *\class IsingInputParameters
@@ -15,14 +16,26 @@ class IsingInputParameters
 public:
 	/**
 	 *\enum DynamicsType.
-	 *\brief represents the two possible types of dynamics.
+	 *\brief represents the possible types of dynamics.
 	 */
 	enum DynamicsType
 	{
 		Glauber,
 		Kawasaki,
+		Wolff,
+		SwendsenWang,
 
 	};
+	/**
+	 *\enum SpinModelType.
+	 *\brief represents the possible spin models.
+	 */
+	enum SpinModelType
+	{
+		Ising,
+		Potts,
+		SpinS,
+	};
 	/**
 	 *\enum ErrorTypes.
 	 *\brief represents the two methods of error calculation.
@@ -32,6 +45,27 @@ public:
 		Bootstrap,
 		JackKnife,
 	};
+	/**
+	 *\enum RandomEngineType.
+	 *\brief represents the random number engines the lattice dynamics can use.
+	 */
+	enum RandomEngineType
+	{
+		StandardEngine,
+		Xoshiro,
+		Philox,
+	};
+	/**
+	 *\enum VectorKernelType.
+	 *\brief represents the kernels that can sweep the byte lattice, NoVectorKernel if it isn't used.
+	 */
+	enum VectorKernelType
+	{
+		NoVectorKernel,
+		ScalarKernel,
+		Avx2Kernel,
+		Avx512Kernel,
+	};
 	/// Number of rows in lattice.
 	int rowCount;
 	/// Number of columns in lattice.
@@ -44,6 +78,12 @@ public:
     int measurementInterval;
     /// The type of dynamics used.
     DynamicsType dynamics;
+    /// Whether Kawasaki dynamics only swap nearest neighbours.
+    bool localExchange;
+    /// The spin model simulated.
+    SpinModelType spinModel;
+    /// Number of states of each spin of the Potts and spin-S models, 2 for Ising.
+    int spinStates;
     /// Value of the J constant.
     double jConstant;
     /// Value of the Boltzmann constant.
@@ -54,6 +94,46 @@ public:
     int autoCorrelationRange;
     /// The method used for calculating more complicated errors.
     ErrorTypes errorType;
+    /// Number of bins used by the jack-knife method, 0 for one bin per sample.
+    int jackKnifeBins;
+    /// Length of the blocks of consecutive samples drawn by the bootstrap method.
+    int bootstrapBlockLength;
+    /// Whether the lattice is stored bit-packed with multi-spin coding.
+    bool multiSpinCoding;
+    /// Kernel sweeping the lattice stored one byte per spin, NoVectorKernel for the other lattices.
+    VectorKernelType vectorKernel;
+    /// Whether the lattice is swept in checkerboard order rather than by random sites.
+    bool checkerboard;
+    /// Whether the lattice is swept in the cache-tiled checkerboard order rather than by random sites or bonds.
+    bool tiled;
+    /// Number of rows and columns of each tile of the tiled sweeps.
+    int tileSize;
+    /// Whether Glauber dynamics are run rejection-free in continuous time with the n-fold way.
+    bool nFoldWay;
+    /// Number of threads used for checkerboard sweeps.
+    int threads;
+    /// Seed of the random number generators.
+    unsigned int seed;
+    /// Random number engine used by the lattice dynamics.
+    RandomEngineType randomEngine;
+    /// Ladder of temperatures, empty for a single temperature run.
+    std::vector<double> temperatures;
+    /// Sweeps between attempted replica exchanges.
+    int swapInterval;
+    /// Whether the ladder of temperatures is coupled by replica exchange rather than run as independent simulations.
+    bool replicaExchange;
+    /// Whether the lattice is split across MPI ranks.
+    bool distributed;
+    /// Number of MPI ranks the lattice is split across.
+    int ranks;
+    /// Whether only streaming statistics are kept rather than every sample.
+    bool streaming;
+    /// Whether every measured configuration is recorded in a binary trajectory.
+    bool trajectory;
+    /// Maximum number of trajectory frames between keyframes.
+    int keyFrameInterval;
+    /// Number of sweeps between checkpoints, 0 for none.
+    int checkpointInterval;
 
     /** 
 	 *\brief operator<< overload for outputting the results.
@@ -1,4 +1,5 @@
 #include "IsingResults.hpp"
+#include <cmath>
 
 std::ostream& operator<<(std::ostream &out, const IsingResults &results)
 {	
@@ -6,8 +7,29 @@ std::ostream& operator<<(std::ostream &out, const IsingResults &results)
 	out << "Results..." << '\n';
    	out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "E: " << std::right << results.energy << " +/- " << results.energyError << '\n';
 	out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "M: " << std::right << results.magnetisation << " +/- " << results.magnetisationError << '\n';
+	if(!std::isnan(results.energyBlockedError))
+	{
+		out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "E-Blocked-Error: " << std::right << results.energyBlockedError << " +/- " << results.energyBlockedErrorOfError
+			<< (results.energyBlockingConverged ? "" : " (not converged, run longer)") << '\n';
+		out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "E-Effective-Samples: " << std::right << results.energyEffectiveSamples << '\n';
+	}
+	if(!std::isnan(results.magnetisationBlockedError))
+	{
+		out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "M-Blocked-Error: " << std::right << results.magnetisationBlockedError << " +/- " << results.magnetisationBlockedErrorOfError
+			<< (results.magnetisationBlockingConverged ? "" : " (not converged, run longer)") << '\n';
+		out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "M-Effective-Samples: " << std::right << results.magnetisationEffectiveSamples << '\n';
+	}
 	out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "X: " << std::right << results.susceptibility <<  " +/- " <<  results.susceptibilityError <<'\n';
 	out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "C: " << std::right << results.heatCapacity << " +/- " << results.heatCapacityError << '\n';
+	if(!std::isnan(results.improvedSusceptibility))
+	{
+		out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "X-Improved: " << std::right << results.improvedSusceptibility << " +/- " << results.improvedSusceptibilityError << '\n';
+	}
+
+	if(!std::isnan(results.binderCumulant))
+	{
+		out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "U: " << std::right << results.binderCumulant << '\n';
+	}
 
 	return out;
 }
\ No newline at end of file
@@ -34,13 +34,40 @@ public:
 	/// Error in lattice heat capacity.
 	double heatCapacityError;
 
+	/// Improved estimator of the lattice susceptibility from cluster sizes, NaN if not measured.
+	double improvedSusceptibility;
+	/// Error in the improved estimator of the lattice susceptibility.
+	double improvedSusceptibilityError;
+
+	/// Binder cumulant of the magnetisation U = 1 - <M^4>/(3<M^2>^2), NaN if not measured.
+	double binderCumulant;
+
+	/// Error in lattice energy from a blocking analysis, which accounts for autocorrelation.
+	double energyBlockedError;
+	/// Statistical uncertainty of the blocked error in lattice energy.
+	double energyBlockedErrorOfError;
+	/// Whether the blocking analysis of the energy reached a plateau, if not the blocked error is an underestimate.
+	bool energyBlockingConverged;
+	/// Number of independent samples the energy measurements are worth.
+	double energyEffectiveSamples;
+
+	/// Error in lattice magnetisation from a blocking analysis, which accounts for autocorrelation.
+	double magnetisationBlockedError;
+	/// Statistical uncertainty of the blocked error in lattice magnetisation.
+	double magnetisationBlockedErrorOfError;
+	/// Whether the blocking analysis of the magnetisation reached a plateau.
+	bool magnetisationBlockingConverged;
+	/// Number of independent samples the magnetisation measurements are worth.
+	double magnetisationEffectiveSamples;
+
 	/** 
 	 *\brief operator<< overload for outputting the results.
 	 *\param out std::ostream reference that is the stream being outputted to.
 	 *\param results constant IsingResults instance to be output.
 	 *\return std::ostream reference so the operator can be chained.
 	 *
-	 * Results will be output in a formatted table for easy viewing in the command line or a file.
+	 * Results will be output in a formatted table for easy viewing in the command line or a file. Results
+	 * that were not measured are left out.
 	 */
 	friend std::ostream& operator<<(std::ostream& out, const IsingResults &results);
 };
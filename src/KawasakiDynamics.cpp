@@ -0,0 +1,223 @@
+#include "KawasakiDynamics.hpp"
+#include "binaryIO.hpp"
+#include <cmath>
+
+KawasakiDynamics::KawasakiDynamics(const SpinLattice2D &lattice, bool local, double jConstant, double boltzmannConstant, double temperature) : m_local{local}
+{
+	for(int energyChange = -BoltzmannTable::maxEnergyChange; energyChange <= BoltzmannTable::maxEnergyChange; ++energyChange)
+	{
+		m_boltzmannFactors[energyChange + BoltzmannTable::maxEnergyChange] = std::exp(-2.0 * jConstant * energyChange / (boltzmannConstant * temperature));
+	}
+	buildSets(lattice);
+}
+
+void KawasakiDynamics::buildSets(const SpinLattice2D &lattice)
+{
+	int cols = lattice.getCols();
+	m_upSites.clear();
+	m_downSites.clear();
+	m_antiAlignedBonds.clear();
+
+	if(!m_local)
+	{
+		m_sitePositions.assign(lattice.getSize(), 0);
+		for(int site = 0; site < lattice.getSize(); ++site)
+		{
+			std::vector<int> &sites = (lattice(site / cols, site % cols) == SpinLattice2D::Up) ? m_upSites : m_downSites;
+			m_sitePositions[site] = static_cast<int>(sites.size());
+			sites.push_back(site);
+		}
+		return;
+	}
+
+	m_bondPositions.assign(2 * lattice.getSize(), -1);
+	for(int bond = 0; bond < 2 * lattice.getSize(); ++bond)
+	{
+		updateBond(lattice, bond);
+	}
+}
+
+int KawasakiDynamics::bondNeighbour(const SpinLattice2D &lattice, int bond) const
+{
+	int cols = lattice.getCols();
+	int site = bond / 2;
+	int row = site / cols;
+	int col = site % cols;
+	return (bond % 2) ? ((row + 1) % lattice.getRows()) * cols + col : row * cols + (col + 1) % cols;
+}
+
+void KawasakiDynamics::updateBond(const SpinLattice2D &lattice, int bond)
+{
+	int cols = lattice.getCols();
+	int site = bond / 2;
+	int neighbour = bondNeighbour(lattice, bond);
+	bool antiAligned = lattice(site / cols, site % cols) != lattice(neighbour / cols, neighbour % cols);
+	int &position = m_bondPositions[bond];
+
+	if(antiAligned && position < 0)
+	{
+		position = static_cast<int>(m_antiAlignedBonds.size());
+		m_antiAlignedBonds.push_back(bond);
+	}
+	else if(!antiAligned && position >= 0)
+	{
+		// Move the last bond into the gap so the set stays contiguous.
+		int last = m_antiAlignedBonds.back();
+		m_antiAlignedBonds[position] = last;
+		m_bondPositions[last] = position;
+		m_antiAlignedBonds.pop_back();
+		position = -1;
+	}
+}
+
+void KawasakiDynamics::updateSiteBonds(const SpinLattice2D &lattice, int site)
+{
+	int rows = lattice.getRows();
+	int cols = lattice.getCols();
+	int row = site / cols;
+	int col = site % cols;
+
+	// The bonds to the right of and below the site and those of its left and upper neighbours.
+	updateBond(lattice, 2 * site);
+	updateBond(lattice, 2 * site + 1);
+	updateBond(lattice, 2 * (row * cols + (col + cols - 1) % cols));
+	updateBond(lattice, 2 * (((row + rows - 1) % rows) * cols + col) + 1);
+}
+
+template<class Engine>
+bool KawasakiDynamics::updateGlobal(SpinLattice2D &lattice, Engine &generator, const BoltzmannTable &boltzmannTable)
+{
+	// A lattice of equal spins can't change.
+	if(m_upSites.empty() || m_downSites.empty())
+	{
+		return false;
+	}
+
+	int upPosition = randomIndex(generator, static_cast<int>(m_upSites.size()));
+	int downPosition = randomIndex(generator, static_cast<int>(m_downSites.size()));
+	int upSite = m_upSites[upPosition];
+	int downSite = m_downSites[downPosition];
+
+	int cols = lattice.getCols();
+	int energyChange = lattice.swapEnergyChange(upSite / cols, upSite % cols, downSite / cols, downSite % cols);
+	if(!boltzmannTable.accept(energyChange, generator))
+	{
+		return false;
+	}
+
+	// The sites trade places in the lists as well as spins.
+	lattice.swap(upSite / cols, upSite % cols, downSite / cols, downSite % cols);
+	m_upSites[upPosition] = downSite;
+	m_downSites[downPosition] = upSite;
+	m_sitePositions[downSite] = upPosition;
+	m_sitePositions[upSite] = downPosition;
+	return true;
+}
+
+template<class Engine>
+bool KawasakiDynamics::updateLocal(SpinLattice2D &lattice, Engine &generator)
+{
+	int antiAlignedBonds = static_cast<int>(m_antiAlignedBonds.size());
+	if(antiAlignedBonds == 0)
+	{
+		return false;
+	}
+
+	int bond = m_antiAlignedBonds[randomIndex(generator, antiAlignedBonds)];
+	int cols = lattice.getCols();
+	int site = bond / 2;
+	int neighbour = bondNeighbour(lattice, bond);
+	int energyChange = lattice.swapEnergyChange(site / cols, site % cols, neighbour / cols, neighbour % cols);
+
+	// The reverse swap is chosen from the anti-aligned bonds after this one, of which there are
+	// antiAlignedBonds + energyChange including this bond.
+	double acceptance = m_boltzmannFactors[energyChange + BoltzmannTable::maxEnergyChange] * antiAlignedBonds / (antiAlignedBonds + energyChange);
+	if(acceptance < 1.0)
+	{
+		std::uniform_real_distribution<double> distribution(0.0, 1.0);
+		if(distribution(generator) >= acceptance)
+		{
+			return false;
+		}
+	}
+
+	lattice.swap(site / cols, site % cols, neighbour / cols, neighbour % cols);
+	updateSiteBonds(lattice, site);
+	updateSiteBonds(lattice, neighbour);
+	return true;
+}
+
+template<class Engine>
+bool KawasakiDynamics::update(SpinLattice2D &lattice, Engine &generator, const BoltzmannTable &boltzmannTable)
+{
+	return m_local ? updateLocal(lattice, generator) : updateGlobal(lattice, generator, boltzmannTable);
+}
+
+// Instantiated for every engine that can be chosen with --rng.
+template bool KawasakiDynamics::update(SpinLattice2D&, std::default_random_engine&, const BoltzmannTable&);
+template bool KawasakiDynamics::update(SpinLattice2D&, Xoshiro256StarStar&, const BoltzmannTable&);
+template bool KawasakiDynamics::update(SpinLattice2D&, Philox4x32&, const BoltzmannTable&);
+
+void KawasakiDynamics::save(std::ostream &out) const
+{
+	if(m_local)
+	{
+		writeVector(out, m_antiAlignedBonds);
+		return;
+	}
+	writeVector(out, m_upSites);
+	writeVector(out, m_downSites);
+}
+
+void KawasakiDynamics::load(std::istream &in)
+{
+	// Every index must be in range and appear at most once, anything else means the stream is from another lattice.
+	if(m_local)
+	{
+		std::vector<int> bonds;
+		readVector(in, bonds);
+		std::vector<int> positions(m_bondPositions.size(), -1);
+		for(int position = 0; in && position < static_cast<int>(bonds.size()); ++position)
+		{
+			int bond = bonds[position];
+			if(bond < 0 || bond >= static_cast<int>(positions.size()) || positions[bond] >= 0)
+			{
+				in.setstate(std::ios::failbit);
+				return;
+			}
+			positions[bond] = position;
+		}
+		if(in)
+		{
+			m_antiAlignedBonds.swap(bonds);
+			m_bondPositions.swap(positions);
+		}
+		return;
+	}
+
+	std::vector<int> upSites, downSites;
+	readVector(in, upSites);
+	readVector(in, downSites);
+	std::vector<int> positions(m_sitePositions.size(), -1);
+	if(!in || upSites.size() + downSites.size() != positions.size())
+	{
+		in.setstate(std::ios::failbit);
+		return;
+	}
+	for(const auto* sites : {&upSites, &downSites})
+	{
+		for(int position = 0; position < static_cast<int>(sites->size()); ++position)
+		{
+			int site = (*sites)[position];
+			if(site < 0 || site >= static_cast<int>(positions.size()) || positions[site] >= 0)
+			{
+				in.setstate(std::ios::failbit);
+				return;
+			}
+			positions[site] = position;
+		}
+	}
+	m_upSites.swap(upSites);
+	m_downSites.swap(downSites);
+	m_sitePositions.swap(positions);
+}
@@ -0,0 +1,153 @@
+#ifndef KawasakiDynamics_hpp
+#define KawasakiDynamics_hpp
+#include <iostream>
+#include <random>
+#include <vector>
+#include "SpinLattice2D.hpp"
+#include "BoltzmannTable.hpp"
+#include "randomEngines.hpp"
+
+/**
+ *\file
+ *\class KawasakiDynamics
+ *\brief Performs rejection-free Kawasaki spin exchange updates of a SpinLattice2D.
+ *
+ * Kawasaki dynamics conserve the magnetisation by swapping opposite spins. Rather than picking two sites and
+ * finding half the time that they hold the same spin, the sites able to take part are kept in index sets
+ * so every proposal is a swap of opposite spins. Each set is a list of sites with every site's position in
+ * it, so an accepted swap updates the sets in O(1).
+ *
+ * - Global exchange (the default) keeps a list of the up sites and one of the down sites and swaps a random
+ *   up site with a random down site anywhere on the lattice. The numbers of up and down sites never change so
+ *   the proposals are symmetric and the usual Metropolis test applies.
+ * - Local exchange keeps the set of anti-aligned nearest neighbour bonds and swaps the two spins of a random
+ *   one, which is the physical dynamics of coarsening with a conserved order parameter. The number of
+ *   anti-aligned bonds changes by the energy change of the swap in units of 2J, so the Metropolis test is
+ *   multiplied by the ratio of the numbers of bonds before and after to keep detailed balance. Only the seven
+ *   bonds touching the swapped sites have to be checked after a swap. It needs at least three rows and
+ *   columns so no two sites are neighbours twice.
+ */
+class KawasakiDynamics
+{
+private:
+	/**
+	 *\brief Member variable holding whether only nearest neighbours are swapped.
+	 */
+	bool m_local;
+
+	/**
+	 *\brief Member variables holding the 1D indices of the up and down sites, used by global exchange.
+	 */
+	std::vector<int> m_upSites;
+	std::vector<int> m_downSites;
+
+	/**
+	 *\brief Member variable holding each site's position in m_upSites or m_downSites.
+	 */
+	std::vector<int> m_sitePositions;
+
+	/**
+	 *\brief Member variable holding the anti-aligned bonds used by local exchange.
+	 *
+	 * The bond to the right of site i is 2i and the bond below it 2i + 1.
+	 */
+	std::vector<int> m_antiAlignedBonds;
+
+	/**
+	 *\brief Member variable holding each bond's position in m_antiAlignedBonds, -1 if it is aligned.
+	 */
+	std::vector<int> m_bondPositions;
+
+	/**
+	 *\brief Member variable array holding exp(-dE/k_B T) indexed by energy change + maxEnergyChange.
+	 */
+	double m_boltzmannFactors[2*BoltzmannTable::maxEnergyChange+1];
+
+	/**
+	 *\brief Builds the sets from the spins of a lattice.
+	 *\param lattice the SpinLattice2D the sets describe.
+	 */
+	void buildSets(const SpinLattice2D &lattice);
+
+	/**
+	 *\brief Gets the 1D index of the site at the other end of a bond.
+	 *\param lattice the SpinLattice2D being updated.
+	 *\param bond index of the bond.
+	 *\return 1D index of the right or lower neighbour.
+	 */
+	int bondNeighbour(const SpinLattice2D &lattice, int bond) const;
+
+	/**
+	 *\brief Adds a bond to or removes it from the anti-aligned set to match the lattice.
+	 *\param lattice the SpinLattice2D being updated.
+	 *\param bond index of the bond.
+	 */
+	void updateBond(const SpinLattice2D &lattice, int bond);
+
+	/**
+	 *\brief Updates every bond touching a site.
+	 *\param lattice the SpinLattice2D being updated.
+	 *\param site 1D index of the site.
+	 */
+	void updateSiteBonds(const SpinLattice2D &lattice, int site);
+
+	/**
+	 *\brief Swaps a random up site with a random down site.
+	 *\param lattice the SpinLattice2D to update.
+	 *\param generator reference to random engine used for choosing the sites and the acceptance test.
+	 *\param boltzmannTable a BoltzmannTable reference holding the acceptance thresholds.
+	 *\return boolean value representing whether the swap was accepted.
+	 */
+	template<class Engine>
+	bool updateGlobal(SpinLattice2D &lattice, Engine &generator, const BoltzmannTable &boltzmannTable);
+
+	/**
+	 *\brief Swaps the spins of a random anti-aligned bond.
+	 *\param lattice the SpinLattice2D to update.
+	 *\param generator reference to random engine used for choosing the bond and the acceptance test.
+	 *\return boolean value representing whether the swap was accepted.
+	 */
+	template<class Engine>
+	bool updateLocal(SpinLattice2D &lattice, Engine &generator);
+
+public:
+	/**
+	 *\brief Creates Kawasaki dynamics for a lattice at a given temperature.
+	 *\param lattice the SpinLattice2D that will be updated, the sets are built from its spins.
+	 *\param local if true only nearest neighbours are swapped.
+	 *\param jConstant floating point value representing the J constant.
+	 *\param boltzmannConstant floating point value representing the Boltzmann constant.
+	 *\param temperature floating point value representing the temperature of the system.
+	 */
+	KawasakiDynamics(const SpinLattice2D &lattice, bool local, double jConstant, double boltzmannConstant, double temperature);
+
+	/**
+	 *\brief Proposes one swap of opposite spins and performs the Metropolis test.
+	 *\param lattice the SpinLattice2D to update, its spins must be those the sets were built or loaded with.
+	 *\param generator reference to random engine used for choosing the sites and the acceptance test,
+	 * std::default_random_engine, Xoshiro256StarStar or Philox4x32.
+	 *\param boltzmannTable a BoltzmannTable reference holding the acceptance thresholds for the temperature of the system.
+	 *\return boolean value representing whether the swap was accepted, false if there are no opposite spins.
+	 */
+	template<class Engine>
+	bool update(SpinLattice2D &lattice, Engine &generator, const BoltzmannTable &boltzmannTable);
+
+	/**
+	 *\brief Writes the sets to a binary stream so they can be restored with load.
+	 *
+	 * The order of the sets decides which sites are chosen so it is part of the state of the simulation.
+	 *
+	 *\param out the stream to write to.
+	 */
+	void save(std::ostream &out) const;
+
+	/**
+	 *\brief Restores the sets written by save for a lattice of the same size.
+	 *
+	 * Failures are left in the state of the stream.
+	 *
+	 *\param in the stream to read from.
+	 */
+	void load(std::istream &in);
+};
+#endif /* KawasakiDynamics_hpp */
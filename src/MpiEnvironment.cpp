@@ -0,0 +1,25 @@
+#include "MpiEnvironment.hpp"
+#ifdef ISING_USE_MPI
+
+MpiEnvironment::MpiEnvironment(int *argc, char ***argv)
+{
+	MPI_Init(argc, argv);
+	MPI_Comm_rank(MPI_COMM_WORLD, &m_rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &m_rankCount);
+}
+
+MpiEnvironment::~MpiEnvironment()
+{
+	MPI_Finalize();
+}
+
+int MpiEnvironment::getRank() const
+{
+	return m_rank;
+}
+
+int MpiEnvironment::getRankCount() const
+{
+	return m_rankCount;
+}
+#endif /* ISING_USE_MPI */
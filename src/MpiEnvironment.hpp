@@ -0,0 +1,56 @@
+#ifndef MpiEnvironment_hpp
+#define MpiEnvironment_hpp
+#ifdef ISING_USE_MPI
+#include <mpi.h>
+
+/**
+ *\file
+ *\class MpiEnvironment
+ *\brief Initialises MPI for the lifetime of the object.
+ *
+ * MPI is initialised when the object is created and finalised when it is destroyed so every way out of main
+ * shuts MPI down cleanly.
+ */
+class MpiEnvironment
+{
+private:
+	/**
+	 *\brief Member variable integer holding the rank of this process in MPI_COMM_WORLD.
+	 */
+	int m_rank;
+
+	/**
+	 *\brief Member variable integer holding the number of ranks in MPI_COMM_WORLD.
+	 */
+	int m_rankCount;
+
+public:
+	/**
+	 *\brief Initialises MPI.
+	 *\param argc pointer to the argument count passed to main.
+	 *\param argv pointer to the arguments passed to main.
+	 */
+	MpiEnvironment(int *argc, char ***argv);
+
+	/**
+	 *\brief Finalises MPI.
+	 */
+	~MpiEnvironment();
+
+	MpiEnvironment(const MpiEnvironment&) = delete;
+	MpiEnvironment& operator=(const MpiEnvironment&) = delete;
+
+	/**
+	 *\brief Getter method for the rank of this process.
+	 *\return integer value representing the rank in MPI_COMM_WORLD.
+	 */
+	int getRank() const;
+
+	/**
+	 *\brief Getter method for the number of ranks.
+	 *\return integer value representing the number of ranks in MPI_COMM_WORLD.
+	 */
+	int getRankCount() const;
+};
+#endif /* ISING_USE_MPI */
+#endif /* MpiEnvironment_hpp */
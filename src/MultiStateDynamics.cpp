@@ -0,0 +1,86 @@
+#include "MultiStateDynamics.hpp"
+#include <cmath>
+#include <algorithm>
+
+template<class Model>
+constexpr int MultiStateDynamics<Model>::tableSize;
+
+template<class Model>
+MultiStateDynamics<Model>::MultiStateDynamics(double jConstant, double boltzmannConstant, double temperature)
+{
+	for(int bondChange = -Model::maxBondChange; bondChange <= Model::maxBondChange; ++bondChange)
+	{
+		int index = bondChange + Model::maxBondChange;
+		double deltaEnergy = -jConstant * Model::energyScale() * bondChange;
+		m_thresholds[index] = BoltzmannTable::thresholds(std::min(1.0, std::exp(-deltaEnergy/(boltzmannConstant*temperature))));
+	}
+}
+
+template<class Model>
+template<class Engine>
+inline bool MultiStateDynamics<Model>::accept(int bondChange, Engine &generator) const
+{
+	return BoltzmannTable::accept(m_thresholds[bondChange + Model::maxBondChange], generator);
+}
+
+template<class Model>
+template<class Engine>
+inline bool MultiStateDynamics<Model>::update(MultiStateLattice2D<Model> &lattice, Engine &generator) const
+{
+	int row = randomIndex(generator, lattice.getRows());
+	int col = randomIndex(generator, lattice.getCols());
+
+	// Draw one of the other states, with two states there is only one.
+	int state = lattice.state(row, col);
+	int proposed = 1 - state;
+	if(Model::states > 2)
+	{
+		proposed = randomIndex(generator, Model::states - 1);
+		proposed += (proposed >= state);
+	}
+
+	int bondChange = lattice.bondChange(row, col, proposed);
+	if(!accept(bondChange, generator))
+	{
+		return false;
+	}
+
+	lattice.setState(row, col, proposed, bondChange);
+	return true;
+}
+
+template<class Model>
+template<class Engine>
+long long MultiStateDynamics<Model>::sweep(MultiStateLattice2D<Model> &lattice, Engine &generator) const
+{
+	long long accepted = 0;
+	int sites = lattice.getSize();
+	for(int site = 0; site < sites; ++site)
+	{
+		accepted += update(lattice, generator);
+	}
+	return accepted;
+}
+
+// Instantiated for every model that can be chosen with --potts and --spin-states and every engine that can be
+// chosen with --rng.
+#define INSTANTIATE_MULTI_STATE_DYNAMICS(Model) \
+	template class MultiStateDynamics<Model>; \
+	template bool MultiStateDynamics<Model>::update(MultiStateLattice2D<Model>&, std::default_random_engine&) const; \
+	template bool MultiStateDynamics<Model>::update(MultiStateLattice2D<Model>&, Xoshiro256StarStar&) const; \
+	template bool MultiStateDynamics<Model>::update(MultiStateLattice2D<Model>&, Philox4x32&) const; \
+	template long long MultiStateDynamics<Model>::sweep(MultiStateLattice2D<Model>&, std::default_random_engine&) const; \
+	template long long MultiStateDynamics<Model>::sweep(MultiStateLattice2D<Model>&, Xoshiro256StarStar&) const; \
+	template long long MultiStateDynamics<Model>::sweep(MultiStateLattice2D<Model>&, Philox4x32&) const;
+
+INSTANTIATE_MULTI_STATE_DYNAMICS(PottsModel<2>)
+INSTANTIATE_MULTI_STATE_DYNAMICS(PottsModel<3>)
+INSTANTIATE_MULTI_STATE_DYNAMICS(PottsModel<4>)
+INSTANTIATE_MULTI_STATE_DYNAMICS(PottsModel<5>)
+INSTANTIATE_MULTI_STATE_DYNAMICS(PottsModel<6>)
+INSTANTIATE_MULTI_STATE_DYNAMICS(PottsModel<7>)
+INSTANTIATE_MULTI_STATE_DYNAMICS(PottsModel<8>)
+INSTANTIATE_MULTI_STATE_DYNAMICS(SpinSModel<2>)
+INSTANTIATE_MULTI_STATE_DYNAMICS(SpinSModel<3>)
+INSTANTIATE_MULTI_STATE_DYNAMICS(SpinSModel<4>)
+INSTANTIATE_MULTI_STATE_DYNAMICS(SpinSModel<5>)
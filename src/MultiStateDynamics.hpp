@@ -0,0 +1,69 @@
+#ifndef MultiStateDynamics_hpp
+#define MultiStateDynamics_hpp
+#include <cstdint>
+#include <random>
+#include "MultiStateLattice2D.hpp"
+#include "randomEngines.hpp"
+#include "BoltzmannTable.hpp"
+
+/**
+ *\file
+ *\class MultiStateDynamics
+ *\brief Performs Metropolis dynamics on a MultiStateLattice2D.
+ *
+ * Every update picks a random site and proposes a new state drawn uniformly from the other Model::states-1
+ * states, which for two states is the other state without drawing a random number. Changing a site changes
+ * the bond sum by an integer in [-Model::maxBondChange, Model::maxBondChange] so the acceptance thresholds
+ * of every possible change are computed once per temperature with BoltzmannTable::thresholds, and moves that lower the
+ * energy are accepted without drawing a random number. For the two state spin-S model every random number
+ * is used exactly as glauberDynamics uses it so the two give identical results for a seed.
+ */
+template<class Model>
+class MultiStateDynamics
+{
+private:
+	/// Number of entries in the acceptance tables.
+	static constexpr int tableSize = 2 * Model::maxBondChange + 1;
+
+	/**
+	 *\brief Member variable array holding acceptance thresholds indexed by bond change + Model::maxBondChange.
+	 */
+	BoltzmannTable::Thresholds m_thresholds[tableSize];
+
+	/**
+	 *\brief Performs the metropolis test for a move.
+	 *\param bondChange the change in the bond sum of the move.
+	 *\param generator reference to the random engine.
+	 *\return boolean value representing whether the move should be accepted.
+	 */
+	template<class Engine>
+	bool accept(int bondChange, Engine &generator) const;
+
+public:
+	/**
+	 *\brief Builds the acceptance tables for a given temperature.
+	 *\param jConstant floating point value representing the J constant.
+	 *\param boltzmannConstant floating point value representing the Boltzmann constant.
+	 *\param temperature floating point value representing the temperature of the system.
+	 */
+	MultiStateDynamics(double jConstant, double boltzmannConstant, double temperature);
+
+	/**
+	 *\brief Proposes a new state for one random site and performs a Metropolis update.
+	 *\param lattice the lattice to update.
+	 *\param generator reference to random engine, std::default_random_engine, Xoshiro256StarStar or Philox4x32.
+	 *\return boolean value representing whether the update was successful.
+	 */
+	template<class Engine>
+	bool update(MultiStateLattice2D<Model> &lattice, Engine &generator) const;
+
+	/**
+	 *\brief Performs one sweep, as many updates as the lattice has sites.
+	 *\param lattice the lattice to update.
+	 *\param generator reference to random engine, std::default_random_engine, Xoshiro256StarStar or Philox4x32.
+	 *\return number of accepted updates.
+	 */
+	template<class Engine>
+	long long sweep(MultiStateLattice2D<Model> &lattice, Engine &generator) const;
+};
+#endif /* MultiStateDynamics_hpp */
@@ -0,0 +1,154 @@
+#include "MultiStateLattice2D.hpp"
+#include "binaryIO.hpp"
+#include <algorithm>
+
+template<class Model>
+MultiStateLattice2D<Model>::MultiStateLattice2D(int rows, int cols) : 	m_colCount{cols},
+																		m_rowCount{rows},
+																		m_states(rows * cols, 0)
+{
+	resetTotals();
+}
+
+template<class Model>
+void MultiStateLattice2D<Model>::resetTotals()
+{
+	m_bondSum = static_cast<int>(recomputeBondSum());
+	countStates(m_stateCounts);
+}
+
+template<class Model>
+void MultiStateLattice2D<Model>::countStates(int *counts) const
+{
+	std::fill(counts, counts + Model::states, 0);
+	for(const auto& state : m_states)
+	{
+		++counts[state];
+	}
+}
+
+template<class Model>
+std::ostream& operator<<(std::ostream& out, const MultiStateLattice2D<Model>& lattice)
+{
+	for(int row = 0; row < lattice.m_rowCount; ++row)
+	{
+		for(int col = 0; col < lattice.m_colCount; ++col)
+		{
+			out << std::showpos << Model::printedValue(lattice(row,col)) << ' ';
+		}
+		out << '\n';
+	}
+	return out;
+}
+
+template<class Model>
+int MultiStateLattice2D<Model>::operator()(int row, int col) const
+{
+	row = (row + m_rowCount) % m_rowCount;
+	col = (col + m_colCount) % m_colCount;
+	return m_states[row * m_colCount + col];
+}
+
+template<class Model>
+double MultiStateLattice2D<Model>::latticeEnergy(double jConstant) const
+{
+	return -1.0 * jConstant * Model::energyScale() * m_bondSum;
+}
+
+template<class Model>
+long long MultiStateLattice2D<Model>::recomputeBondSum() const
+{
+	// Every site has one bond to the right and one below.
+	long long bondSum = 0;
+	for(int row = 0; row < m_rowCount; ++row)
+	{
+		for(int col = 0; col < m_colCount; ++col)
+		{
+			int state = m_states[row * m_colCount + col];
+			bondSum += Model::bond(state, (*this)(row, col+1)) + Model::bond(state, (*this)(row+1, col));
+		}
+	}
+	return bondSum;
+}
+
+template<class Model>
+double MultiStateLattice2D<Model>::recomputeLatticeEnergy(double jConstant) const
+{
+	return -1.0 * jConstant * Model::energyScale() * recomputeBondSum();
+}
+
+template<class Model>
+double MultiStateLattice2D<Model>::totalMag() const
+{
+	return Model::magnetisation(m_stateCounts);
+}
+
+template<class Model>
+double MultiStateLattice2D<Model>::recomputeTotalMag() const
+{
+	int counts[Model::states];
+	countStates(counts);
+	return Model::magnetisation(counts);
+}
+
+template<class Model>
+int MultiStateLattice2D<Model>::getRows() const
+{
+	return m_rowCount;
+}
+
+template<class Model>
+int MultiStateLattice2D<Model>::getCols() const
+{
+	return m_colCount;
+}
+
+template<class Model>
+int MultiStateLattice2D<Model>::getSize() const
+{
+	return m_rowCount * m_colCount;
+}
+
+template<class Model>
+void MultiStateLattice2D<Model>::save(std::ostream &out) const
+{
+	writeVector(out, m_states);
+}
+
+template<class Model>
+void MultiStateLattice2D<Model>::load(std::istream &in)
+{
+	std::size_t size = m_states.size();
+	readVector(in, m_states);
+	if(m_states.size() != size)
+	{
+		in.setstate(std::ios::failbit);
+		m_states.assign(size, 0);
+		return;
+	}
+
+	// A state out of range would index past the state counts.
+	if(std::any_of(m_states.begin(), m_states.end(), [](std::uint8_t state) { return state >= Model::states; }))
+	{
+		in.setstate(std::ios::failbit);
+		m_states.assign(size, 0);
+	}
+	resetTotals();
+}
+
+// Instantiated for every model that can be chosen with --potts and --spin-states.
+#define INSTANTIATE_MULTI_STATE_LATTICE(Model) \
+	template class MultiStateLattice2D<Model>; \
+	template std::ostream& operator<<(std::ostream&, const MultiStateLattice2D<Model>&);
+
+INSTANTIATE_MULTI_STATE_LATTICE(PottsModel<2>)
+INSTANTIATE_MULTI_STATE_LATTICE(PottsModel<3>)
+INSTANTIATE_MULTI_STATE_LATTICE(PottsModel<4>)
+INSTANTIATE_MULTI_STATE_LATTICE(PottsModel<5>)
+INSTANTIATE_MULTI_STATE_LATTICE(PottsModel<6>)
+INSTANTIATE_MULTI_STATE_LATTICE(PottsModel<7>)
+INSTANTIATE_MULTI_STATE_LATTICE(PottsModel<8>)
+INSTANTIATE_MULTI_STATE_LATTICE(SpinSModel<2>)
+INSTANTIATE_MULTI_STATE_LATTICE(SpinSModel<3>)
+INSTANTIATE_MULTI_STATE_LATTICE(SpinSModel<4>)
+INSTANTIATE_MULTI_STATE_LATTICE(SpinSModel<5>)
@@ -0,0 +1,208 @@
+#ifndef MultiStateLattice2D_hpp
+#define MultiStateLattice2D_hpp
+#include <cstdint>
+#include <vector>
+#include <iostream>
+#include "spinModels.hpp"
+
+/**
+ *\file
+ *\class MultiStateLattice2D
+ *\brief Models a 2D lattice of spins with a number of states fixed at compile time, e.g. a q-state Potts model.
+ *
+ * Each site holds its state, 0 to Model::states-1, in a byte. The model (PottsModel or SpinSModel from
+ * spinModels.hpp) gives the bond values so the running energy is kept as an integer sum over bonds, and the
+ * number of sites in each state is kept so the magnetisation is O(states). The lattice is instantiated for
+ * Potts models with 2 to 8 states and spin-S models with 2 to 5 states (spin-1/2 to spin-2).
+ */
+template<class Model>
+class MultiStateLattice2D
+{
+private:
+	/**
+	 *\brief Member variable integer to represent the number of columns.
+	 */
+	int m_colCount;
+
+	/**
+	 *\brief Member variable integer to represent the number of rows.
+	 */
+	int m_rowCount;
+
+	/**
+	 *\brief Member variable array holding the state of each site row by row.
+	 */
+	std::vector<std::uint8_t> m_states;
+
+	/**
+	 *\brief Member variable integer holding the running sum of Model::bond over all bonds.
+	 */
+	int m_bondSum;
+
+	/**
+	 *\brief Member variable array holding the running number of sites in each state.
+	 */
+	int m_stateCounts[Model::states];
+
+	/**
+	 *\brief Recalculates the running energy and state counts after the whole lattice has been changed.
+	 */
+	void resetTotals();
+
+	/**
+	 *\brief Sums Model::bond over every bond of the lattice.
+	 *\return the bond sum.
+	 */
+	long long recomputeBondSum() const;
+
+	/**
+	 *\brief Counts the sites in each state.
+	 *\param counts array of Model::states integers to fill.
+	 */
+	void countStates(int *counts) const;
+
+public:
+	/**
+	 *\brief Creates a lattice of specified dimensions; initially all sites in state 0.
+	 *\param rows integer representing desired number of rows in lattice.
+	 *\param cols integer representing desired number of columns in lattice.
+	 */
+	MultiStateLattice2D(int rows, int cols);
+
+	/**
+	 *\brief Prints array as 2D matrix of the value of each state given by Model::printedValue.
+	 *\param out an output stream reference to stream to.
+	 *\param lattice a const MultiStateLattice2D reference to be printed.
+	 */
+	template<class M>
+	friend std::ostream& operator<<(std::ostream &out, const MultiStateLattice2D<M> &lattice);
+
+	/**
+	 *\brief Gets the state of a site.
+	 *
+	 * Periodic boundary conditions are taken into account.
+	 *
+	 *\param row row index of site.
+	 *\param col column index of site.
+	 *\return the state of the site.
+	 */
+	int operator()(int row, int col) const;
+
+	/**
+	 *\brief Gets the state of a site inside the lattice without applying the boundary conditions.
+	 *\param row row index of site, must be in the lattice.
+	 *\param col column index of site, must be in the lattice.
+	 *\return the state of the site.
+	 */
+	int state(int row, int col) const;
+
+	/**
+	 *\brief Gets the change in the bond sum of changing the state of a site.
+	 *\param row row index of site, must be in the lattice.
+	 *\param col column index of site, must be in the lattice.
+	 *\param state the proposed state.
+	 *\return the change in the bond sum, the energy changes by -J * Model::energyScale() times this.
+	 */
+	int bondChange(int row, int col, int state) const;
+
+	/**
+	 *\brief Changes the state of a site.
+	 *\param row row index of site, must be in the lattice.
+	 *\param col column index of site, must be in the lattice.
+	 *\param state the new state.
+	 *\param bondChange the change in the bond sum given by bondChange.
+	 */
+	void setState(int row, int col, int state, int bondChange);
+
+	/**
+	 *\brief Gets the total energy of the lattice from the running bond sum, this is O(1).
+	 *\param jConstant constant floating point value representing the value of the J constant.
+	 */
+	double latticeEnergy(const double jConstant) const;
+
+	/**
+	 *\brief Calculates the total energy of the lattice from every bond.
+	 *
+	 * Should always agree with latticeEnergy, used to check the running total.
+	 *
+	 *\param jConstant constant floating point value representing the value of the J constant.
+	 */
+	double recomputeLatticeEnergy(const double jConstant) const;
+
+	/**
+	 *\brief Gets the magnetisation of the lattice from the running state counts, this is O(states).
+	 *\return floating point value representing the magnetisation.
+	 */
+	double totalMag() const;
+
+	/**
+	 *\brief Calculates the magnetisation of the lattice by counting the state of every site.
+	 *
+	 * Should always agree with totalMag, used to check the running total.
+	 *\return floating point value representing the magnetisation.
+	 */
+	double recomputeTotalMag() const;
+
+	/**
+	 *\brief Getter method for the number of columns in the lattice.
+	 *\return integer value representing number of columns.
+	 */
+	int getCols() const;
+
+	/**
+	 *\brief Getter method for the number of rows in the lattice.
+	 *\return integer value representing number of rows.
+	 */
+	int getRows() const;
+
+	/**
+	 *\brief Getter method for size of lattice = #columns * #rows
+	 *\return integer value representing size of lattice.
+	 */
+	int getSize() const;
+
+	/**
+	 *\brief Writes the states of the lattice, which must have the same dimensions when it is loaded, to a binary stream so it can be restored with load.
+	 *\param out the stream to write to.
+	 */
+	void save(std::ostream &out) const;
+
+	/**
+	 *\brief Restores the states of the lattice, which must have the same dimensions when it is loaded, written by save.
+	 *
+	 * Failures, including states out of range, are left in the state of the stream.
+	 *
+	 *\param in the stream to read from.
+	 */
+	void load(std::istream &in);
+};
+
+// The accessors used by every update are defined here so the dynamics can inline them.
+
+template<class Model>
+inline int MultiStateLattice2D<Model>::state(int row, int col) const
+{
+	return m_states[row * m_colCount + col];
+}
+
+template<class Model>
+inline int MultiStateLattice2D<Model>::bondChange(int row, int col, int state) const
+{
+	const std::uint8_t *site = &m_states[row * m_colCount + col];
+	int up    = (row == 0) ? site[(m_rowCount - 1) * m_colCount] : site[-m_colCount];
+	int down  = (row == m_rowCount - 1) ? site[-(m_rowCount - 1) * m_colCount] : site[m_colCount];
+	int left  = (col == 0) ? site[m_colCount - 1] : site[-1];
+	int right = (col == m_colCount - 1) ? site[-(m_colCount - 1)] : site[1];
+	return Model::bondChange(*site, state, up, down, left, right);
+}
+
+template<class Model>
+inline void MultiStateLattice2D<Model>::setState(int row, int col, int state, int bondChange)
+{
+	std::uint8_t &site = m_states[row * m_colCount + col];
+	--m_stateCounts[site];
+	++m_stateCounts[state];
+	m_bondSum += bondChange;
+	site = static_cast<std::uint8_t>(state);
+}
+#endif /* MultiStateLattice2D_hpp */
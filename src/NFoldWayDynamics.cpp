@@ -0,0 +1,173 @@
+#include "NFoldWayDynamics.hpp"
+#include "binaryIO.hpp"
+#include <cmath>
+constexpr int NFoldWayDynamics::classCount;
+
+NFoldWayDynamics::NFoldWayDynamics(const SpinLattice2D &lattice, const BoltzmannTable &boltzmannTable) : 	m_siteClasses(lattice.getSize(), classCount),
+																											m_sitePositions(lattice.getSize(), 0),
+																											m_time{0.0}
+{
+	for(int classIndex = 0; classIndex < classCount; ++classIndex)
+	{
+		m_rates[classIndex] = boltzmannTable.probability(2 * classIndex - 4);
+	}
+
+	// Sites start in no class, which classify treats as a class to move them out of.
+	for(int site = 0; site < lattice.getSize(); ++site)
+	{
+		classify(lattice, site);
+	}
+}
+
+int NFoldWayDynamics::classOf(int energyChange)
+{
+	return (energyChange + 4) / 2;
+}
+
+void NFoldWayDynamics::classify(const SpinLattice2D &lattice, int site)
+{
+	int cols = lattice.getCols();
+	int newClass = classOf(lattice.flipEnergyChange(site / cols, site % cols));
+	int oldClass = m_siteClasses[site];
+	if(newClass == oldClass)
+	{
+		return;
+	}
+
+	// Move the last site of the old class into the gap so the list stays contiguous.
+	if(oldClass < classCount)
+	{
+		std::vector<int> &oldSites = m_classSites[oldClass];
+		int last = oldSites.back();
+		oldSites[m_sitePositions[site]] = last;
+		m_sitePositions[last] = m_sitePositions[site];
+		oldSites.pop_back();
+	}
+
+	m_siteClasses[site] = static_cast<std::uint8_t>(newClass);
+	m_sitePositions[site] = static_cast<int>(m_classSites[newClass].size());
+	m_classSites[newClass].push_back(site);
+}
+
+template<class Engine>
+long long NFoldWayDynamics::advance(SpinLattice2D &lattice, Engine &generator, double time)
+{
+	std::uniform_real_distribution<double> distribution(0.0, 1.0);
+	int rows = lattice.getRows();
+	int cols = lattice.getCols();
+	long long flips = 0;
+
+	while(true)
+	{
+		double classRates[classCount];
+		double totalRate = 0.0;
+		for(int classIndex = 0; classIndex < classCount; ++classIndex)
+		{
+			classRates[classIndex] = m_rates[classIndex] * m_classSites[classIndex].size();
+			totalRate += classRates[classIndex];
+		}
+
+		// The waiting time for the next flip, 1 - u is in (0, 1] so the logarithm is finite.
+		double wait = -std::log(1.0 - distribution(generator)) / totalRate;
+		if(m_time + wait > time)
+		{
+			m_time = time;
+			return flips;
+		}
+		m_time += wait;
+
+		// Choose a class in proportion to its rate, rounding can leave a little over so fall back to the last
+		// class with any rate.
+		double choice = distribution(generator) * totalRate;
+		int chosenClass = classCount - 1;
+		while(classRates[chosenClass] == 0.0)
+		{
+			--chosenClass;
+		}
+		for(int classIndex = 0; classIndex < classCount; ++classIndex)
+		{
+			if(choice < classRates[classIndex])
+			{
+				chosenClass = classIndex;
+				break;
+			}
+			choice -= classRates[classIndex];
+		}
+
+		const std::vector<int> &sites = m_classSites[chosenClass];
+		int site = sites[randomIndex(generator, static_cast<int>(sites.size()))];
+		int row = site / cols;
+		int col = site % cols;
+		lattice.flip(row, col);
+		++flips;
+
+		// Only the flipped site and its neighbours have a different energy change now.
+		classify(lattice, site);
+		classify(lattice, ((row + 1) % rows) * cols + col);
+		classify(lattice, ((row + rows - 1) % rows) * cols + col);
+		classify(lattice, row * cols + (col + 1) % cols);
+		classify(lattice, row * cols + (col + cols - 1) % cols);
+	}
+}
+
+// Instantiated for every engine that can be chosen with --rng.
+template long long NFoldWayDynamics::advance(SpinLattice2D&, std::default_random_engine&, double);
+template long long NFoldWayDynamics::advance(SpinLattice2D&, Xoshiro256StarStar&, double);
+template long long NFoldWayDynamics::advance(SpinLattice2D&, Philox4x32&, double);
+
+double NFoldWayDynamics::getTime() const
+{
+	return m_time;
+}
+
+void NFoldWayDynamics::save(std::ostream &out) const
+{
+	writeValue(out, m_time);
+	for(const auto& sites : m_classSites)
+	{
+		writeVector(out, sites);
+	}
+}
+
+void NFoldWayDynamics::load(std::istream &in)
+{
+	double time = readValue<double>(in);
+	std::vector<int> classSites[classCount];
+	for(auto& sites : classSites)
+	{
+		readVector(in, sites);
+	}
+
+	// Every site must be in exactly one class, anything else means the stream is from another lattice.
+	std::vector<std::uint8_t> siteClasses(m_siteClasses.size(), classCount);
+	std::vector<int> positions(m_sitePositions.size(), 0);
+	std::size_t classified = 0;
+	for(int classIndex = 0; in && classIndex < classCount; ++classIndex)
+	{
+		for(int position = 0; position < static_cast<int>(classSites[classIndex].size()); ++position)
+		{
+			int site = classSites[classIndex][position];
+			if(site < 0 || site >= static_cast<int>(siteClasses.size()) || siteClasses[site] != classCount)
+			{
+				in.setstate(std::ios::failbit);
+				return;
+			}
+			siteClasses[site] = static_cast<std::uint8_t>(classIndex);
+			positions[site] = position;
+			++classified;
+		}
+	}
+	if(!in || classified != siteClasses.size())
+	{
+		in.setstate(std::ios::failbit);
+		return;
+	}
+
+	m_time = time;
+	for(int classIndex = 0; classIndex < classCount; ++classIndex)
+	{
+		m_classSites[classIndex].swap(classSites[classIndex]);
+	}
+	m_siteClasses.swap(siteClasses);
+	m_sitePositions.swap(positions);
+}
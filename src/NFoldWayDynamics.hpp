@@ -0,0 +1,118 @@
+#ifndef NFoldWayDynamics_hpp
+#define NFoldWayDynamics_hpp
+#include <iostream>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include "SpinLattice2D.hpp"
+#include "BoltzmannTable.hpp"
+#include "randomEngines.hpp"
+
+/**
+ *\file
+ *\class NFoldWayDynamics
+ *\brief Performs rejection-free continuous time Glauber dynamics with the n-fold way of Bortz, Kalos and Lebowitz.
+ *
+ * At low temperatures almost every proposed flip of ordinary Glauber dynamics is rejected. The n-fold way
+ * instead sorts the sites into classes by the energy change of flipping them, which on the square lattice
+ * takes one of five values, and keeps a list of the sites in each class with every site's position in it.
+ * Every step flips a spin: a class is chosen with probability proportional to its total rate, the number
+ * of its sites times their Metropolis acceptance probability, and a random site of the class is flipped.
+ * Only the flipped site and its four neighbours can change class so the lists are updated in O(1).
+ *
+ * A physical clock, in sweeps, advances by an exponentially distributed waiting time with mean one over the
+ * total rate before each flip, which is exactly the time ordinary random site Glauber dynamics would take on
+ * average to make the same flip. The lattice is measured at whole sweeps of the clock so each configuration
+ * is sampled in proportion to its residence time and the results match ordinary Glauber dynamics.
+ */
+class NFoldWayDynamics
+{
+public:
+	/// Number of classes, flipping a site changes the energy by -4, -2, 0, 2 or 4 in units of 2J.
+	static constexpr int classCount = 5;
+
+private:
+	/**
+	 *\brief Member variable holding the 1D indices of the sites in each class.
+	 */
+	std::vector<int> m_classSites[classCount];
+
+	/**
+	 *\brief Member variable holding each site's class.
+	 */
+	std::vector<std::uint8_t> m_siteClasses;
+
+	/**
+	 *\brief Member variable holding each site's position in the list of its class.
+	 */
+	std::vector<int> m_sitePositions;
+
+	/**
+	 *\brief Member variable holding the flip rate, the Metropolis acceptance probability, of each class.
+	 */
+	double m_rates[classCount];
+
+	/**
+	 *\brief Member variable holding the physical time in sweeps.
+	 */
+	double m_time;
+
+	/**
+	 *\brief Gets the class of a site from its energy change.
+	 *\param energyChange integer energy change of flipping the site in units of 2J.
+	 *\return index of the class.
+	 */
+	static int classOf(int energyChange);
+
+	/**
+	 *\brief Moves a site to the class matching the lattice.
+	 *\param lattice the SpinLattice2D being updated.
+	 *\param site 1D index of the site.
+	 */
+	void classify(const SpinLattice2D &lattice, int site);
+
+public:
+	/**
+	 *\brief Creates n-fold way dynamics for a lattice at a given temperature.
+	 *\param lattice the SpinLattice2D that will be updated, its sites are classified at the start.
+	 *\param boltzmannTable a BoltzmannTable reference holding the acceptance probabilities for the temperature of the system.
+	 */
+	NFoldWayDynamics(const SpinLattice2D &lattice, const BoltzmannTable &boltzmannTable);
+
+	/**
+	 *\brief Flips spins until the clock reaches a given time.
+	 *
+	 * The waiting time is memoryless so the wait for the first flip after the given time is simply drawn
+	 * again on the next call.
+	 *
+	 *\param lattice the SpinLattice2D to update, its spins must be those the classes were built or loaded with.
+	 *\param generator reference to random engine used for the waiting times and choosing the flips,
+	 * std::default_random_engine, Xoshiro256StarStar or Philox4x32.
+	 *\param time the time in sweeps to stop at.
+	 *\return number of spins flipped.
+	 */
+	template<class Engine>
+	long long advance(SpinLattice2D &lattice, Engine &generator, double time);
+
+	/**
+	 *\brief Getter method for the physical time.
+	 *\return floating point value representing the time in sweeps.
+	 */
+	double getTime() const;
+
+	/**
+	 *\brief Writes the classes and the clock to a binary stream so they can be restored with load.
+	 *\param out the stream to write to.
+	 */
+	void save(std::ostream &out) const;
+
+	/**
+	 *\brief Restores the classes and the clock written by save for a lattice of the same size.
+	 *
+	 * Failures are left in the state of the stream.
+	 *
+	 *\param in the stream to read from.
+	 */
+	void load(std::istream &in);
+};
+#endif /* NFoldWayDynamics_hpp */
@@ -0,0 +1,288 @@
+#include "PackedSpinLattice2D.hpp"
+#include "binaryIO.hpp"
+constexpr int PackedSpinLattice2D::bitsPerWord;
+
+namespace
+{
+	// Masks selecting the even and odd columns of a word, since every word starts on an even column
+	// these are the same for every word in a row.
+	constexpr PackedSpinLattice2D::Word evenColumns = 0x5555555555555555ULL;
+	constexpr PackedSpinLattice2D::Word oddColumns  = 0xAAAAAAAAAAAAAAAAULL;
+}
+
+PackedSpinLattice2D::PackedSpinLattice2D(int rows, int cols) : 	m_colCount{cols},
+																m_rowCount{rows},
+																m_wordsPerRow{(cols + bitsPerWord - 1) / bitsPerWord},
+																m_lastWordMask{(cols % bitsPerWord) ? ((Word(1) << (cols % bitsPerWord)) - 1) : ~Word(0)},
+																m_words(m_rowCount * m_wordsPerRow, 0),
+																m_leftNeighbours(m_wordsPerRow),
+																m_rightNeighbours(m_wordsPerRow)
+{
+	resetTotals();
+}
+
+void PackedSpinLattice2D::resetTotals()
+{
+	m_bondSum = static_cast<int>(-1.0 * recomputeLatticeEnergy(1.0));
+	m_magnetisation = recomputeTotalMag();
+}
+
+PackedSpinLattice2D::PackedSpinLattice2D(const SpinLattice2D &spinLattice) : PackedSpinLattice2D(spinLattice.getRows(), spinLattice.getCols())
+{
+	for(int row = 0; row < m_rowCount; ++row)
+	{
+		for(int col = 0; col < m_colCount; ++col)
+		{
+			if(SpinLattice2D::spinValues[spinLattice(row, col)] > 0)
+			{
+				m_words[row * m_wordsPerRow + col / bitsPerWord] |= Word(1) << (col % bitsPerWord);
+			}
+		}
+	}
+	resetTotals();
+}
+
+const PackedSpinLattice2D::Word* PackedSpinLattice2D::rowWords(int row) const
+{
+	row = (row + m_rowCount) % m_rowCount;
+	return &m_words[row * m_wordsPerRow];
+}
+
+void PackedSpinLattice2D::leftNeighbourRow(const Word *row, Word *out) const
+{
+	// Shift every spin one column to the right carrying the top bit of the previous word.
+	for(int word = 0; word < m_wordsPerRow; ++word)
+	{
+		out[word] = (row[word] << 1) | (word > 0 ? row[word-1] >> (bitsPerWord-1) : 0);
+	}
+
+	// Periodic boundary conditions, the left neighbour of column 0 is the last column.
+	int lastBit = (m_colCount - 1) % bitsPerWord;
+	out[0] |= (row[m_wordsPerRow-1] >> lastBit) & 1;
+	out[m_wordsPerRow-1] &= m_lastWordMask;
+}
+
+void PackedSpinLattice2D::rightNeighbourRow(const Word *row, Word *out) const
+{
+	// Shift every spin one column to the left carrying the bottom bit of the next word.
+	for(int word = 0; word < m_wordsPerRow; ++word)
+	{
+		out[word] = (row[word] >> 1) | (word + 1 < m_wordsPerRow ? row[word+1] << (bitsPerWord-1) : 0);
+	}
+
+	// Periodic boundary conditions, the right neighbour of the last column is column 0. The padding bits
+	// above the last column are always clear so we can just or the spin in.
+	int lastBit = (m_colCount - 1) % bitsPerWord;
+	out[m_wordsPerRow-1] |= (row[0] & 1) << lastBit;
+}
+
+void PackedSpinLattice2D::randomise(std::default_random_engine &generator)
+{
+	std::uniform_int_distribution<int> distribution(0,1);
+	for(int row = 0; row < m_rowCount; ++row)
+	{
+		for(int col = 0; col < m_colCount; ++col)
+		{
+			Word bit = Word(1) << (col % bitsPerWord);
+			Word &word = m_words[row * m_wordsPerRow + col / bitsPerWord];
+			word = distribution(generator) ? (word | bit) : (word & ~bit);
+		}
+	}
+	resetTotals();
+}
+
+SpinLattice2D::Spin PackedSpinLattice2D::operator()(int row, int col) const
+{
+	col = (col + m_colCount) % m_colCount;
+	Word word = rowWords(row)[col / bitsPerWord];
+	return ((word >> (col % bitsPerWord)) & 1) ? SpinLattice2D::Down : SpinLattice2D::Up;
+}
+
+std::ostream& operator<<(std::ostream& out, const PackedSpinLattice2D& spinLattice)
+{
+	for(int row = 0; row < spinLattice.m_rowCount; ++row)
+	{
+		for(int col = 0; col < spinLattice.m_colCount; ++col)
+		{
+			out << std::showpos << SpinLattice2D::spinValues[spinLattice(row,col)] << ' ';
+		}
+		out << '\n';
+	}
+	return out;
+}
+
+template<class Engine>
+long long PackedSpinLattice2D::halfSweep(int parity, Engine &generator, const BoltzmannTable &boltzmannTable)
+{
+	long long accepted = 0;
+
+	for(int row = 0; row < m_rowCount; ++row)
+	{
+		Word *spins = &m_words[row * m_wordsPerRow];
+		const Word *above = rowWords(row-1);
+		const Word *below = rowWords(row+1);
+		leftNeighbourRow(spins, m_leftNeighbours.data());
+		rightNeighbourRow(spins, m_rightNeighbours.data());
+
+		// Sites on this sublattice are the even columns if row + parity is even, otherwise the odd ones.
+		Word sublattice = ((row + parity) % 2 == 0) ? evenColumns : oddColumns;
+
+		for(int word = 0; word < m_wordsPerRow; ++word)
+		{
+			Word active = sublattice & (word == m_wordsPerRow-1 ? m_lastWordMask : ~Word(0));
+			Word s = spins[word];
+
+			// A set bit in each of these means the site is anti-aligned with that neighbour.
+			Word a = s ^ above[word];
+			Word b = s ^ below[word];
+			Word c = s ^ m_leftNeighbours[word];
+			Word d = s ^ m_rightNeighbours[word];
+
+			// Bit-sliced addition of the four anti-aligned flags giving a three bit count per site.
+			Word sum1   = a ^ b;
+			Word carry1 = a & b;
+			Word sum2   = c ^ d;
+			Word carry2 = c & d;
+			Word bit0   = sum1 ^ sum2;
+			Word carry3 = sum1 & sum2;
+			Word bit1   = carry1 ^ carry2 ^ carry3;
+			Word bit2   = carry1 & carry2;
+
+			Word counts[5] =
+			{
+				~bit2 & ~bit1 & ~bit0,
+				~bit2 & ~bit1 &  bit0,
+				~bit2 &  bit1 & ~bit0,
+				~bit2 &  bit1 &  bit0,
+				 bit2,
+			};
+
+			// A site with k anti-aligned neighbours has S_site * Sum S_neighbour = 4 - 2k which is the energy
+			// change of flipping it in units of 2J.
+			Word flips = 0;
+			for(int antiAligned = 0; antiAligned < 5; ++antiAligned)
+			{
+				Word candidates = counts[antiAligned] & active;
+				int energyChange = 4 - 2 * antiAligned;
+				if(!candidates)
+				{
+					continue;
+				}
+
+				// Only the sites whose flip may be rejected need a random number.
+				Word classFlips = candidates;
+				if(!boltzmannTable.alwaysAccepted(energyChange))
+				{
+					classFlips = 0;
+					while(candidates)
+					{
+						int bit = __builtin_ctzll(candidates);
+						candidates &= candidates - 1;
+						if(boltzmannTable.accept(energyChange, generator))
+						{
+							classFlips |= Word(1) << bit;
+						}
+					}
+				}
+
+				flips |= classFlips;
+				m_bondSum -= 2 * energyChange * __builtin_popcountll(classFlips);
+			}
+
+			// Flipping a set bit lowers the magnetisation by 2 and flipping a clear bit raises it by 2.
+			m_magnetisation += 2 * (__builtin_popcountll(flips & ~s) - __builtin_popcountll(flips & s));
+			spins[word] = s ^ flips;
+			accepted += __builtin_popcountll(flips);
+		}
+	}
+
+	return accepted;
+}
+
+template<class Engine>
+long long PackedSpinLattice2D::sweep(Engine &generator, const BoltzmannTable &boltzmannTable)
+{
+	long long accepted = halfSweep(0, generator, boltzmannTable);
+	accepted += halfSweep(1, generator, boltzmannTable);
+	return accepted;
+}
+
+// Instantiated for every engine that can be chosen with --rng.
+template long long PackedSpinLattice2D::sweep(std::default_random_engine&, const BoltzmannTable&);
+template long long PackedSpinLattice2D::sweep(Xoshiro256StarStar&, const BoltzmannTable&);
+template long long PackedSpinLattice2D::sweep(Philox4x32&, const BoltzmannTable&);
+
+double PackedSpinLattice2D::latticeEnergy(double jConstant) const
+{
+	return -1.0 * jConstant * m_bondSum;
+}
+
+double PackedSpinLattice2D::recomputeLatticeEnergy(double jConstant) const
+{
+	// Every site has one bond to the right and one below, each anti-aligned bond contributes +J and each
+	// aligned bond -J.
+	long long antiAligned = 0;
+	std::vector<Word> right(m_wordsPerRow);
+	for(int row = 0; row < m_rowCount; ++row)
+	{
+		const Word *spins = rowWords(row);
+		const Word *below = rowWords(row+1);
+		rightNeighbourRow(spins, right.data());
+		for(int word = 0; word < m_wordsPerRow; ++word)
+		{
+			antiAligned += __builtin_popcountll(spins[word] ^ right[word]);
+			antiAligned += __builtin_popcountll(spins[word] ^ below[word]);
+		}
+	}
+
+	long long bonds = 2LL * getSize();
+	return -1.0 * jConstant * (bonds - 2 * antiAligned);
+}
+
+int PackedSpinLattice2D::totalMag() const
+{
+	return m_magnetisation;
+}
+
+int PackedSpinLattice2D::recomputeTotalMag() const
+{
+	long long upSpins = 0;
+	for(const auto& word : m_words)
+	{
+		upSpins += __builtin_popcountll(word);
+	}
+	return static_cast<int>(2 * upSpins - getSize());
+}
+
+int PackedSpinLattice2D::getRows() const
+{
+	return m_rowCount;
+}
+
+int PackedSpinLattice2D::getCols() const
+{
+	return m_colCount;
+}
+
+int PackedSpinLattice2D::getSize() const
+{
+	return m_rowCount * m_colCount;
+}
+
+void PackedSpinLattice2D::save(std::ostream &out) const
+{
+	writeVector(out, m_words);
+}
+
+void PackedSpinLattice2D::load(std::istream &in)
+{
+	std::size_t size = m_words.size();
+	readVector(in, m_words);
+	if(m_words.size() != size)
+	{
+		in.setstate(std::ios::failbit);
+		m_words.resize(size, 0);
+		return;
+	}
+	resetTotals();
+}
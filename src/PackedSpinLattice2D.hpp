@@ -0,0 +1,230 @@
+#ifndef PackedSpinLattice2D_hpp
+#define PackedSpinLattice2D_hpp
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <iostream>
+#include "SpinLattice2D.hpp"
+#include "BoltzmannTable.hpp"
+
+/**
+ *\file
+ *\class PackedSpinLattice2D
+ *\brief Models a 2D spin lattice using multi-spin coding.
+ *
+ * Each row of the lattice is stored as a sequence of 64 bit words with one bit per spin, a set bit
+ * representing a spin with value +1 and a clear bit a spin with value -1. Updates are performed on a
+ * checkerboard decomposition of the lattice so a whole word of one sublattice can be updated at once
+ * with bitwise logic and the energy and magnetisation are calculated with popcount. Periodic boundary
+ * conditions on a checkerboard require an even number of rows and columns.
+ */
+class PackedSpinLattice2D
+{
+public:
+	/// Type used to store the packed spins.
+	using Word = std::uint64_t;
+
+	/// Number of spins packed into each word.
+	static constexpr int bitsPerWord = 64;
+
+private:
+	/**
+	 *\brief Member variable integer to represent the number of columns.
+	 */
+	int m_colCount;
+
+	/**
+	 *\brief Member variable integer to represent the number of rows.
+	 */
+	int m_rowCount;
+
+	/**
+	 *\brief Member variable integer to represent the number of words used to store a single row.
+	 */
+	int m_wordsPerRow;
+
+	/**
+	 *\brief Member variable mask of the bits in the last word of a row that hold spins.
+	 */
+	Word m_lastWordMask;
+
+	/**
+	 *\brief Member variable array holding the packed spins row by row.
+	 */
+	std::vector<Word> m_words;
+
+	/**
+	 *\brief Scratch rows holding the left and right neighbours of the row being updated.
+	 */
+	std::vector<Word> m_leftNeighbours;
+	std::vector<Word> m_rightNeighbours;
+
+	/**
+	 *\brief Member variable integer holding the running sum of S_site * S_neighbour over all bonds.
+	 */
+	int m_bondSum;
+
+	/**
+	 *\brief Member variable integer holding the running total magnetisation.
+	 */
+	int m_magnetisation;
+
+	/**
+	 *\brief Recalculates the running energy and magnetisation after the whole lattice has been changed.
+	 */
+	void resetTotals();
+
+	/**
+	 *\brief Returns pointer to the first word of a row taking into account periodic boundary conditions.
+	 *\param row row index.
+	 *\return pointer to the first word of the row.
+	 */
+	const Word* rowWords(int row) const;
+
+	/**
+	 *\brief Fills a row with the spins of each site's left neighbour.
+	 *\param row pointer to the first word of the row.
+	 *\param out pointer to the first word of the row to fill.
+	 */
+	void leftNeighbourRow(const Word *row, Word *out) const;
+
+	/**
+	 *\brief Fills a row with the spins of each site's right neighbour.
+	 *\param row pointer to the first word of the row.
+	 *\param out pointer to the first word of the row to fill.
+	 */
+	void rightNeighbourRow(const Word *row, Word *out) const;
+
+	/**
+	 *\brief Updates all sites on one sublattice of the checkerboard.
+	 *\param parity the sublattice to update, sites with (row + col) % 2 == parity are updated.
+	 *\param generator reference to random engine used in the acceptance tests.
+	 *\param boltzmannTable a BoltzmannTable reference holding the acceptance thresholds.
+	 *\return number of accepted flips.
+	 */
+	template<class Engine>
+	long long halfSweep(int parity, Engine &generator, const BoltzmannTable &boltzmannTable);
+
+public:
+	/**
+	 *\brief Creates a packed 2D spin lattice of specified dimensions; initially all spins up.
+	 *\param rows integer representing desired number of rows in lattice.
+	 *\param cols integer representing desired number of columns in lattice.
+	 */
+	PackedSpinLattice2D(int rows, int cols);
+
+	/**
+	 *\brief Creates a packed copy of an ordinary spin lattice.
+	 *\param spinLattice a const SpinLattice2D reference to be packed.
+	 */
+	explicit PackedSpinLattice2D(const SpinLattice2D &spinLattice);
+
+	/**
+	 *\brief Randomises all spins in array.
+	 *\param generator reference to random engine used to draw the spins.
+	 */
+	void randomise(std::default_random_engine &generator);
+
+	/**
+	 *\brief Prints array as 2D matrix of +1 spin up and -1 spin down.
+	 *
+	 * Output format is identical to the SpinLattice2D equivalent.
+	 *
+	 *\param out an output stream reference to stream to.
+	 *\param spinLattice a const PackedSpinLattice2D reference to be printed.
+	 */
+	friend std::ostream& operator<<(std::ostream &out, const PackedSpinLattice2D &spinLattice);
+
+	/**
+	 *\brief Gets the spin at a site.
+	 *
+	 * Periodic boundary conditions are taken into account.
+	 *
+	 *\param row row index of site.
+	 *\param col column index of site.
+	 *\return the spin stored at the site.
+	 */
+	SpinLattice2D::Spin operator()(int row, int col) const;
+
+	/**
+	 *\brief Performs one Metropolis sweep of the lattice.
+	 *
+	 * A sweep consists of updating every site of one sublattice of the checkerboard followed by every
+	 * site of the other, so each site has exactly one proposed flip per sweep. The acceptance test of
+	 * each flip is the same as that used by glauberDynamics so the equilibrium physics is identical.
+	 *
+	 *\param generator reference to random engine used in the acceptance tests, std::default_random_engine,
+	 * Xoshiro256StarStar or Philox4x32.
+	 *\param boltzmannTable a BoltzmannTable reference holding the acceptance thresholds for the temperature of the system.
+	 *\return number of accepted flips.
+	 */
+	template<class Engine>
+	long long sweep(Engine &generator, const BoltzmannTable &boltzmannTable);
+
+	/**
+	 *\brief Gets the total energy of the lattice.
+	 *
+	 * Energy is given by the formula E = -J * Sum_{all nearest neighbours} S_site * S_neighbours. The sum is
+	 * updated from the flips accepted in each sweep so this is O(1).
+	 *
+	 *\param jConstant constant floating point value representing the value of the J constant.
+	 */
+	double latticeEnergy(const double jConstant) const;
+
+	/**
+	 *\brief Calculates the total energy of the lattice by counting anti-aligned bonds with popcount.
+	 *
+	 * Should always agree with latticeEnergy, used to check the running total.
+	 *
+	 *\param jConstant constant floating point value representing the value of the J constant.
+	 */
+	double recomputeLatticeEnergy(const double jConstant) const;
+
+	/**
+	 *\brief Gets total magnetisation of the spin lattice, this is O(1).
+	 *\return integer value representing the total magnetisation.
+	 */
+	int totalMag() const;
+
+	/**
+	 *\brief Calculates total magnetisation of the spin lattice with popcount.
+	 *
+	 * Should always agree with totalMag, used to check the running total.
+	 *\return integer value representing the total magnetisation.
+	 */
+	int recomputeTotalMag() const;
+
+	/**
+	 *\brief Getter method for the number of columns in the spin lattice.
+	 *\return integer value representing number of columns.
+	 */
+	int getCols() const;
+
+	/**
+	 *\brief Getter method for the number of rows in the spin lattice.
+	 *\return integer value representing number of rows.
+	 */
+	int getRows() const;
+
+	/**
+	 *\brief Getter method for size of lattice = #columns * #rows
+	 *\return integer value representing size of lattice.
+	 */
+	int getSize() const;
+
+	/**
+	 *\brief Writes the spins of the lattice, which must have the same dimensions when it is loaded, to a binary stream so it can be restored with load.
+	 *\param out the stream to write to.
+	 */
+	void save(std::ostream &out) const;
+
+	/**
+	 *\brief Restores the spins of the lattice, which must have the same dimensions when it is loaded, written by save.
+	 *
+	 * Failures are left in the state of the stream.
+	 *
+	 *\param in the stream to read from.
+	 */
+	void load(std::istream &in);
+};
+#endif /* PackedSpinLattice2D_hpp */
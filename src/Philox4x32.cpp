@@ -0,0 +1,127 @@
+#include "Philox4x32.hpp"
+
+namespace
+{
+	// Round multipliers and key increments (the golden ratio and sqrt(3) - 1) from the Philox paper.
+	constexpr std::uint32_t multiplier0 = 0xD2511F53;
+	constexpr std::uint32_t multiplier1 = 0xCD9E8D57;
+	constexpr std::uint32_t keyIncrement0 = 0x9E3779B9;
+	constexpr std::uint32_t keyIncrement1 = 0xBB67AE85;
+	constexpr int rounds = 10;
+}
+
+constexpr int Philox4x32::bufferBlocks;
+
+Philox4x32::Philox4x32(std::uint64_t seed, std::uint64_t stream) : 	m_key{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)},
+																	m_stream{stream},
+																	m_block{0},
+																	m_buffer{},
+																	m_used{2*bufferBlocks}
+{
+}
+
+void Philox4x32::generateBlocks(std::uint64_t block, result_type *out) const
+{
+	// The words of every block's counter are kept in their own arrays so each round is a loop over the blocks
+	// the compiler can vectorise.
+	std::uint32_t counter0[bufferBlocks], counter1[bufferBlocks], counter2[bufferBlocks], counter3[bufferBlocks];
+	for(int i = 0; i < bufferBlocks; ++i)
+	{
+		counter0[i] = static_cast<std::uint32_t>(block + i);
+		counter1[i] = static_cast<std::uint32_t>((block + i) >> 32);
+		counter2[i] = static_cast<std::uint32_t>(m_stream);
+		counter3[i] = static_cast<std::uint32_t>(m_stream >> 32);
+	}
+	std::uint32_t key0 = m_key[0];
+	std::uint32_t key1 = m_key[1];
+
+	for(int round = 0; round < rounds; ++round)
+	{
+		for(int i = 0; i < bufferBlocks; ++i)
+		{
+			std::uint64_t product0 = static_cast<std::uint64_t>(multiplier0) * counter0[i];
+			std::uint64_t product1 = static_cast<std::uint64_t>(multiplier1) * counter2[i];
+			counter0[i] = static_cast<std::uint32_t>(product1 >> 32) ^ counter1[i] ^ key0;
+			counter2[i] = static_cast<std::uint32_t>(product0 >> 32) ^ counter3[i] ^ key1;
+			counter1[i] = static_cast<std::uint32_t>(product1);
+			counter3[i] = static_cast<std::uint32_t>(product0);
+		}
+		key0 += keyIncrement0;
+		key1 += keyIncrement1;
+	}
+
+	for(int i = 0; i < bufferBlocks; ++i)
+	{
+		out[2*i]   = (static_cast<result_type>(counter1[i]) << 32) | counter0[i];
+		out[2*i+1] = (static_cast<result_type>(counter3[i]) << 32) | counter2[i];
+	}
+}
+
+void Philox4x32::generate(result_type *first, result_type *last)
+{
+	// Use up what is left of the buffer first.
+	while(first != last && m_used < 2*bufferBlocks)
+	{
+		*first++ = m_buffer[m_used++];
+	}
+
+	for(; last - first >= 2*bufferBlocks; first += 2*bufferBlocks)
+	{
+		generateBlocks(m_block, first);
+		m_block += bufferBlocks;
+	}
+
+	while(first != last)
+	{
+		*first++ = (*this)();
+	}
+}
+
+void Philox4x32::discard(unsigned long long steps)
+{
+	// Skip the rest of the buffer, then whole groups of blocks without generating them.
+	while(steps > 0 && m_used < 2*bufferBlocks)
+	{
+		++m_used;
+		--steps;
+	}
+	m_block += (steps / (2*bufferBlocks)) * bufferBlocks;
+	for(steps %= 2*bufferBlocks; steps > 0; --steps)
+	{
+		(*this)();
+	}
+}
+
+std::uint64_t Philox4x32::getStream() const
+{
+	return m_stream;
+}
+
+std::ostream& operator<<(std::ostream &out, const Philox4x32 &engine)
+{
+	// The buffer is a function of the other members so it isn't written, only whether it has been used.
+	return out << engine.m_key[0] << ' ' << engine.m_key[1] << ' ' << engine.m_stream << ' ' << engine.m_block << ' ' << engine.m_used;
+}
+
+std::istream& operator>>(std::istream &in, Philox4x32 &engine)
+{
+	in >> engine.m_key[0] >> engine.m_key[1] >> engine.m_stream >> engine.m_block >> engine.m_used;
+	if(in && engine.m_used < 2*Philox4x32::bufferBlocks)
+	{
+		if(engine.m_block < Philox4x32::bufferBlocks || engine.m_used < 0)
+		{
+			in.setstate(std::ios::failbit);
+			return in;
+		}
+		engine.generateBlocks(engine.m_block - Philox4x32::bufferBlocks, engine.m_buffer);
+	}
+	return in;
+}
+
+bool operator==(const Philox4x32 &left, const Philox4x32 &right)
+{
+	// Engines with an exhausted buffer are at the same position as ones that have used none of the next blocks.
+	auto position = [](const Philox4x32 &engine) { return 2 * engine.m_block - (2*Philox4x32::bufferBlocks - engine.m_used); };
+	return left.m_key[0] == right.m_key[0] && left.m_key[1] == right.m_key[1]
+		   && left.m_stream == right.m_stream && position(left) == position(right);
+}
@@ -0,0 +1,142 @@
+#ifndef Philox4x32_hpp
+#define Philox4x32_hpp
+#include <cstdint>
+#include <iostream>
+#include <limits>
+
+/**
+ *\file
+ *\class Philox4x32
+ *\brief The counter based Philox4x32-10 random number engine of Salmon et al.
+ *
+ * Philox has no state to speak of, the numbers are a keyed bijection of a 128 bit counter. Here the key is
+ * the 64 bit seed and the counter is split into a 64 bit stream index and a 64 bit block index, so every
+ * (seed, stream) pair is an independent sequence of 2^65 numbers and any position in it can be reached in
+ * O(1) with discard. Each block of ten rounds gives 128 bits, two 64 bit numbers. Blocks are generated
+ * bufferBlocks at a time with the rounds applied to all of them together, which the compiler vectorises,
+ * and buffered for operator(). It meets the requirements of a random number engine so it can be used
+ * with the distributions of <random>.
+ */
+class Philox4x32
+{
+public:
+	/// Type of the numbers generated.
+	using result_type = std::uint64_t;
+
+	/// Number of blocks generated together.
+	static constexpr int bufferBlocks = 8;
+
+private:
+	/**
+	 *\brief Member variable holding the 64 bit key as two 32 bit words.
+	 */
+	std::uint32_t m_key[2];
+
+	/**
+	 *\brief Member variable holding the index of this engine's stream.
+	 */
+	std::uint64_t m_stream;
+
+	/**
+	 *\brief Member variable holding the index of the first block after the buffer.
+	 */
+	std::uint64_t m_block;
+
+	/**
+	 *\brief Member variable holding the numbers of the last bufferBlocks blocks generated.
+	 */
+	result_type m_buffer[2*bufferBlocks];
+
+	/**
+	 *\brief Member variable holding how many of the buffered numbers have been used, 2*bufferBlocks means none are left.
+	 */
+	int m_used;
+
+	/**
+	 *\brief Applies the ten Philox rounds to bufferBlocks consecutive blocks of this engine's stream.
+	 *\param block index of the first block.
+	 *\param out array the 2*bufferBlocks 64 bit numbers of the blocks are written to.
+	 */
+	void generateBlocks(std::uint64_t block, result_type *out) const;
+
+public:
+	/**
+	 *\brief Creates an engine at the start of a stream.
+	 *\param seed the seed, used as the key.
+	 *\param stream index of the stream.
+	 */
+	explicit Philox4x32(std::uint64_t seed = 0, std::uint64_t stream = 0);
+
+	/**
+	 *\brief Smallest number generated.
+	 *\return 0.
+	 */
+	static constexpr result_type min() { return 0; }
+
+	/**
+	 *\brief Largest number generated.
+	 *\return 2^64 - 1.
+	 */
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+	/**
+	 *\brief Generates the next number.
+	 *\return uniformly distributed 64 bit number.
+	 */
+	result_type operator()();
+
+	/**
+	 *\brief Fills a range with numbers, the same numbers as calling operator() for each element.
+	 *
+	 * Whole groups of blocks are written straight into the range so this avoids the buffer.
+	 *
+	 *\param first pointer to the first element.
+	 *\param last pointer to one past the last element.
+	 */
+	void generate(result_type *first, result_type *last);
+
+	/**
+	 *\brief Advances the engine by a number of steps in O(1).
+	 *\param steps number of numbers to skip.
+	 */
+	void discard(unsigned long long steps);
+
+	/**
+	 *\brief Getter method for the index of the stream.
+	 *\return the index of the stream.
+	 */
+	std::uint64_t getStream() const;
+
+	/**
+	 *\brief Writes the state of the engine as text.
+	 *\param out an output stream reference to write to.
+	 *\param engine the engine to write.
+	 *\return the stream so the operator can be chained.
+	 */
+	friend std::ostream& operator<<(std::ostream &out, const Philox4x32 &engine);
+
+	/**
+	 *\brief Reads the state of an engine written by operator<<.
+	 *\param in an input stream reference to read from.
+	 *\param engine the engine to restore.
+	 *\return the stream so the operator can be chained.
+	 */
+	friend std::istream& operator>>(std::istream &in, Philox4x32 &engine);
+
+	/**
+	 *\brief Engines are equal if they will generate the same numbers.
+	 */
+	friend bool operator==(const Philox4x32 &left, const Philox4x32 &right);
+};
+
+inline Philox4x32::result_type Philox4x32::operator()()
+{
+	if(m_used == 2*bufferBlocks)
+	{
+		generateBlocks(m_block, m_buffer);
+		m_block += bufferBlocks;
+		m_used = 0;
+	}
+	return m_buffer[m_used++];
+}
+#endif /* Philox4x32_hpp */
@@ -0,0 +1,115 @@
+#include "ReplicaExchange.hpp"
+#include "glauberDynamics.hpp"
+#include <cmath>
+
+ReplicaExchange::ReplicaExchange(int rows,
+								 int cols,
+								 const std::vector<double> &temperatures,
+								 double jConstant,
+								 double boltzmannConstant,
+								 unsigned int seed,
+								 int threads) : 	m_temperatures(temperatures),
+													m_swapAttempts(temperatures.size(), 0),
+													m_swapAccepts(temperatures.size(), 0),
+													m_swapRounds{0},
+													m_acceptedFlips(temperatures.size(), 0),
+													m_jConstant{jConstant},
+													m_boltzmannConstant{boltzmannConstant},
+													m_threadPool(threads)
+{
+	int replicas = static_cast<int>(temperatures.size());
+	m_boltzmannTables.reserve(replicas);
+	m_replicas.reserve(replicas);
+	m_replicaGenerators.reserve(replicas);
+	for(int replica = 0; replica < replicas; ++replica)
+	{
+		m_boltzmannTables.emplace_back(jConstant, boltzmannConstant, temperatures[replica]);
+		m_replicas.emplace_back(rows, cols);
+
+		// The extra constant keeps these streams distinct from other per-row or per-replica streams.
+		std::seed_seq sequence{seed, static_cast<unsigned int>(replica), 2u};
+		m_replicaGenerators.emplace_back(sequence);
+
+		m_replicaAtTemperature.push_back(replica);
+		m_temperatureOfReplica.push_back(replica);
+	}
+}
+
+void ReplicaExchange::sweep(int sweeps)
+{
+	for(int replica = 0; replica < static_cast<int>(m_replicas.size()); ++replica)
+	{
+		m_threadPool.submit([this, replica, sweeps]()
+		{
+			SpinLattice2D &lattice = m_replicas[replica];
+			std::default_random_engine &generator = m_replicaGenerators[replica];
+			const BoltzmannTable &boltzmannTable = m_boltzmannTables[m_temperatureOfReplica[replica]];
+
+			// Each replica is at a different temperature, so no other task touches this count.
+			long long &acceptedFlips = m_acceptedFlips[m_temperatureOfReplica[replica]];
+			for(int sweep = 0; sweep < sweeps; ++sweep)
+			{
+				for(int site = 0; site < lattice.getSize(); ++site)
+				{
+					acceptedFlips += glauberDynamics(lattice, generator, boltzmannTable);
+				}
+			}
+		});
+	}
+
+	m_threadPool.wait();
+}
+
+void ReplicaExchange::attemptSwaps(std::default_random_engine &generator)
+{
+	std::uniform_real_distribution<double> distribution(0.0,1.0);
+
+	// Alternate between pairs (0,1),(2,3)... and (1,2),(3,4)...
+	for(int lower = m_swapRounds % 2; lower + 1 < static_cast<int>(m_temperatures.size()); lower += 2)
+	{
+		int upper = lower + 1;
+		int lowerReplica = m_replicaAtTemperature[lower];
+		int upperReplica = m_replicaAtTemperature[upper];
+
+		double betaDifference = 1.0/(m_boltzmannConstant*m_temperatures[lower]) - 1.0/(m_boltzmannConstant*m_temperatures[upper]);
+		double energyDifference = m_replicas[lowerReplica].latticeEnergy(m_jConstant) - m_replicas[upperReplica].latticeEnergy(m_jConstant);
+
+		++m_swapAttempts[lower];
+		if(distribution(generator) <= std::min(1.0, std::exp(betaDifference * energyDifference)))
+		{
+			// Exchange temperature labels, the lattices stay where they are.
+			m_replicaAtTemperature[lower] = upperReplica;
+			m_replicaAtTemperature[upper] = lowerReplica;
+			m_temperatureOfReplica[upperReplica] = lower;
+			m_temperatureOfReplica[lowerReplica] = upper;
+			++m_swapAccepts[lower];
+		}
+	}
+
+	++m_swapRounds;
+}
+
+int ReplicaExchange::getTemperatureCount() const
+{
+	return static_cast<int>(m_temperatures.size());
+}
+
+double ReplicaExchange::getTemperature(int temperatureIndex) const
+{
+	return m_temperatures[temperatureIndex];
+}
+
+const SpinLattice2D& ReplicaExchange::lattice(int temperatureIndex) const
+{
+	return m_replicas[m_replicaAtTemperature[temperatureIndex]];
+}
+
+long long ReplicaExchange::getAcceptedFlips(int temperatureIndex) const
+{
+	return m_acceptedFlips[temperatureIndex];
+}
+
+double ReplicaExchange::swapAcceptanceRate(int temperatureIndex) const
+{
+	return m_swapAttempts[temperatureIndex] ? static_cast<double>(m_swapAccepts[temperatureIndex])/m_swapAttempts[temperatureIndex] : 0.0;
+}
@@ -0,0 +1,143 @@
+#ifndef ReplicaExchange_hpp
+#define ReplicaExchange_hpp
+#include <random>
+#include <vector>
+#include "SpinLattice2D.hpp"
+#include "BoltzmannTable.hpp"
+#include "ThreadPool.hpp"
+
+/**
+ *\file
+ *\class ReplicaExchange
+ *\brief Simulates a ladder of temperatures with parallel tempering (replica exchange).
+ *
+ * One SpinLattice2D replica is held per temperature of the ladder. Replicas are swept with Glauber dynamics
+ * concurrently on a thread pool, each with its own random number engine, and swaps of neighbouring temperatures
+ * are attempted between sweeps. A swap of temperatures T_i and T_{i+1} is accepted with probability
+ * min(1, exp((1/k_B T_i - 1/k_B T_{i+1})(E_i - E_{i+1}))). Accepted swaps exchange the temperature labels of the
+ * two replicas rather than copying lattices. Each round of swaps alternates between the even and odd pairs of
+ * the ladder.
+ */
+class ReplicaExchange
+{
+private:
+	/**
+	 *\brief Member variable holding the temperatures of the ladder in the order given.
+	 */
+	std::vector<double> m_temperatures;
+
+	/**
+	 *\brief Member variable holding the acceptance thresholds of each temperature.
+	 */
+	std::vector<BoltzmannTable> m_boltzmannTables;
+
+	/**
+	 *\brief Member variable holding the replicas.
+	 */
+	std::vector<SpinLattice2D> m_replicas;
+
+	/**
+	 *\brief Member variable holding one random number engine per replica.
+	 */
+	std::vector<std::default_random_engine> m_replicaGenerators;
+
+	/**
+	 *\brief Member variable holding the index of the replica currently at each temperature.
+	 */
+	std::vector<int> m_replicaAtTemperature;
+
+	/**
+	 *\brief Member variable holding the index of the temperature each replica is currently at.
+	 */
+	std::vector<int> m_temperatureOfReplica;
+
+	/**
+	 *\brief Member variables counting attempted and accepted swaps of temperature i with temperature i+1.
+	 */
+	std::vector<long long> m_swapAttempts;
+	std::vector<long long> m_swapAccepts;
+
+	/**
+	 *\brief Member variable integer counting rounds of swaps, used to alternate even and odd pairs.
+	 */
+	long long m_swapRounds;
+
+	/**
+	 *\brief Member variable counting the flips accepted at each temperature.
+	 */
+	std::vector<long long> m_acceptedFlips;
+
+	double m_jConstant;
+	double m_boltzmannConstant;
+
+	/**
+	 *\brief Member variable holding the pool the replicas are swept on.
+	 */
+	ThreadPool m_threadPool;
+
+public:
+	/**
+	 *\brief Creates one aligned replica per temperature.
+	 *\param rows integer representing the number of rows of each replica.
+	 *\param cols integer representing the number of columns of each replica.
+	 *\param temperatures vector of temperatures in the ladder, should be sorted.
+	 *\param jConstant floating point value representing the J constant.
+	 *\param boltzmannConstant floating point value representing the Boltzmann constant.
+	 *\param seed seed from which every replica's random number engine is seeded.
+	 *\param threads integer representing the number of threads in the pool.
+	 */
+	ReplicaExchange(int rows,
+					int cols,
+					const std::vector<double> &temperatures,
+					double jConstant,
+					double boltzmannConstant,
+					unsigned int seed,
+					int threads);
+
+	/**
+	 *\brief Sweeps every replica concurrently.
+	 *\param sweeps integer representing the number of sweeps each replica does before returning.
+	 */
+	void sweep(int sweeps);
+
+	/**
+	 *\brief Attempts swaps between either the even or the odd neighbouring pairs of temperatures.
+	 *\param generator reference to random engine used in the acceptance tests.
+	 */
+	void attemptSwaps(std::default_random_engine &generator);
+
+	/**
+	 *\brief Getter method for the number of temperatures in the ladder.
+	 *\return integer value representing the number of temperatures.
+	 */
+	int getTemperatureCount() const;
+
+	/**
+	 *\brief Getter method for a temperature of the ladder.
+	 *\param temperatureIndex index of the temperature in the ladder.
+	 *\return floating point value representing the temperature.
+	 */
+	double getTemperature(int temperatureIndex) const;
+
+	/**
+	 *\brief Gets the replica currently at a temperature.
+	 *\param temperatureIndex index of the temperature in the ladder.
+	 *\return constant reference to the replica.
+	 */
+	const SpinLattice2D& lattice(int temperatureIndex) const;
+
+	/**
+	 *\brief Getter method for the number of flips accepted at a temperature, by whichever replica was there.
+	 *\param temperatureIndex index of the temperature in the ladder.
+	 *\return the number of accepted flips.
+	 */
+	long long getAcceptedFlips(int temperatureIndex) const;
+
+	/**
+	 *\brief Gets the fraction of attempted swaps of temperature i and i+1 that were accepted.
+	 *\param temperatureIndex index i of the lower temperature of the pair.
+	 *\return floating point value representing the acceptance rate.
+	 */
+	double swapAcceptanceRate(int temperatureIndex) const;
+};
+#endif /* ReplicaExchange_hpp */
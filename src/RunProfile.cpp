@@ -0,0 +1,90 @@
+#include "RunProfile.hpp"
+#include <iomanip>
+#include <string>
+#include <algorithm>
+
+const char* const RunProfile::phaseNames[MAXPHASES] = {"Setup", "Burn-In", "Production", "Measurement", "Output", "Autocorrelation", "Error-Analysis"};
+
+RunProfile::RunProfile() : 	m_attemptedMoves{0},
+							m_acceptedMoves{0},
+							m_flippedSpins{0}
+{
+	std::fill(m_seconds, m_seconds + MAXPHASES, 0.0);
+}
+
+void RunProfile::endPhase(Phase phase)
+{
+	m_seconds[phase] += m_timer.elapsed();
+	m_timer.reset();
+}
+
+double RunProfile::getSeconds(Phase phase) const
+{
+	return m_seconds[phase];
+}
+
+double RunProfile::getTotalSeconds() const
+{
+	double total = 0;
+	for(int phase = 0; phase < MAXPHASES; ++phase)
+	{
+		total += m_seconds[phase];
+	}
+	return total;
+}
+
+double RunProfile::movesPerSecond() const
+{
+	double sweepSeconds = m_seconds[BurnIn] + m_seconds[Production];
+	return (sweepSeconds > 0) ? m_attemptedMoves / sweepSeconds : 0.0;
+}
+
+double RunProfile::flipsPerSecond() const
+{
+	double sweepSeconds = m_seconds[BurnIn] + m_seconds[Production];
+	return (sweepSeconds > 0) ? m_flippedSpins / sweepSeconds : 0.0;
+}
+
+void RunProfile::writeJson(std::ostream &out, int indent) const
+{
+	std::string braceIndent(indent - 1, '\t');
+	std::string memberIndent(indent, '\t');
+	out << "{\n";
+	out << memberIndent << "\"seconds\": {";
+	for(int phase = 0; phase < MAXPHASES; ++phase)
+	{
+		out << (phase ? ", " : "") << '"' << phaseNames[phase] << "\": " << m_seconds[phase];
+	}
+	out << "},\n";
+	out << memberIndent << "\"totalSeconds\": " << getTotalSeconds() << ",\n";
+	out << memberIndent << "\"attemptedMoves\": " << m_attemptedMoves << ",\n";
+	out << memberIndent << "\"acceptedMoves\": " << m_acceptedMoves << ",\n";
+	out << memberIndent << "\"acceptanceRate\": " << (m_attemptedMoves ? static_cast<double>(m_acceptedMoves) / m_attemptedMoves : 0.0) << ",\n";
+	out << memberIndent << "\"movesPerSecond\": " << movesPerSecond() << ",\n";
+	out << memberIndent << "\"flippedSpins\": " << m_flippedSpins << ",\n";
+	out << memberIndent << "\"flipsPerSecond\": " << flipsPerSecond() << '\n';
+	out << braceIndent << '}';
+}
+
+std::ostream& operator<<(std::ostream &out, const RunProfile &profile)
+{
+	int outputColumnWidth = 30;
+	out << "Profile..." << '\n';
+	for(int phase = 0; phase < RunProfile::MAXPHASES; ++phase)
+	{
+		out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << (std::string(RunProfile::phaseNames[phase]) + "-Time(s): ")
+			<< std::right << profile.m_seconds[phase] << '\n';
+	}
+	out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Total-Time(s): " << std::right << profile.getTotalSeconds() << '\n';
+	out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Attempted-Moves: " << std::right << profile.m_attemptedMoves << '\n';
+	out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Accepted-Moves: " << std::right << profile.m_acceptedMoves << '\n';
+	if(profile.m_attemptedMoves)
+	{
+		out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Acceptance-Rate: " << std::right
+			<< static_cast<double>(profile.m_acceptedMoves) / profile.m_attemptedMoves << '\n';
+	}
+	out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Moves-Per-Second: " << std::right << profile.movesPerSecond() << '\n';
+	out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Flipped-Spins: " << std::right << profile.m_flippedSpins << '\n';
+	out << std::setw(outputColumnWidth) << std::setfill(' ') << std::left << "Flips-Per-Second: " << std::right << profile.flipsPerSecond() << '\n';
+	return out;
+}
@@ -0,0 +1,131 @@
+#ifndef RunProfile_hpp
+#define RunProfile_hpp
+#include <iostream>
+#include "Timer.hpp"
+
+/**
+ *\file
+ *\class RunProfile
+ *\brief Class for recording where the time of a simulation goes and how many moves its dynamics made.
+ *
+ * The wall time is split into phases. Each call to endPhase adds the time since the previous call, or since
+ * the profile was created, to one phase, so the phases cover the whole run without gaps. A move is a
+ * proposed flip or swap of the local dynamics, a Wolff cluster or a Swendsen-Wang update of every cluster.
+ * Moves of the rejection-free and cluster dynamics are always accepted. The profile covers this run of the
+ * program only, a resumed simulation reports the sweeps it did itself.
+ */
+class RunProfile
+{
+public:
+	/**
+	 *\enum Phase.
+	 *\brief represents the phases of a run.
+	 */
+	enum Phase
+	{
+		Setup,
+		BurnIn,
+		Production,
+		Measurement,
+		Output,
+		AutoCorrelation,
+		ErrorAnalysis,
+		MAXPHASES,
+	};
+
+	/// Names of the phases used in the results.
+	static const char* const phaseNames[MAXPHASES];
+
+private:
+	/**
+	 *\brief Member variable timing the current phase.
+	 */
+	Timer m_timer;
+
+	/**
+	 *\brief Member variable array holding the wall time of each phase in seconds.
+	 */
+	double m_seconds[MAXPHASES];
+
+	/**
+	 *\brief Member variable holding the number of moves proposed.
+	 */
+	long long m_attemptedMoves;
+
+	/**
+	 *\brief Member variable holding the number of moves accepted.
+	 */
+	long long m_acceptedMoves;
+
+	/**
+	 *\brief Member variable holding the number of spins flipped by the accepted moves.
+	 */
+	long long m_flippedSpins;
+
+public:
+	/**
+	 *\brief Creates an empty profile whose first phase starts now.
+	 */
+	RunProfile();
+
+	/**
+	 *\brief Ends the current phase, adding the time since the previous phase ended to it.
+	 *\param phase the phase that has just ended.
+	 */
+	void endPhase(Phase phase);
+
+	/**
+	 *\brief Counts moves made by the dynamics.
+	 *\param attempted number of moves proposed.
+	 *\param accepted number of moves accepted.
+	 *\param flipped number of spins flipped by the accepted moves.
+	 */
+	void addMoves(long long attempted, long long accepted, long long flipped);
+
+	/**
+	 *\brief Gets the wall time of a phase.
+	 *\param phase the phase.
+	 *\return the time in seconds.
+	 */
+	double getSeconds(Phase phase) const;
+
+	/**
+	 *\brief Gets the wall time of every phase.
+	 *\return the time in seconds.
+	 */
+	double getTotalSeconds() const;
+
+	/**
+	 *\brief Gets the number of moves proposed per second of the burn-in and production sweeps.
+	 *\return the moves per second, zero if no time has been spent sweeping.
+	 */
+	double movesPerSecond() const;
+
+	/**
+	 *\brief Gets the number of spins flipped per second of the burn-in and production sweeps.
+	 *\return the flips per second, zero if no time has been spent sweeping.
+	 */
+	double flipsPerSecond() const;
+
+	/**
+	 *\brief Writes the profile as a JSON object.
+	 *\param out the stream to write to.
+	 *\param indent the number of tabs the members are indented by, the braces are indented by one less.
+	 */
+	void writeJson(std::ostream &out, int indent = 1) const;
+
+	/**
+	 *\brief Prints the profile in the same format as the results.
+	 *\param out an output stream reference to stream to.
+	 *\param profile a const RunProfile reference to be printed.
+	 */
+	friend std::ostream& operator<<(std::ostream &out, const RunProfile &profile);
+};
+
+inline void RunProfile::addMoves(long long attempted, long long accepted, long long flipped)
+{
+	m_attemptedMoves += attempted;
+	m_acceptedMoves += accepted;
+	m_flippedSpins += flipped;
+}
+#endif /* RunProfile_hpp */
@@ -0,0 +1,46 @@
+#include "SimulationData.hpp"
+#include "binaryIO.hpp"
+
+void SimulationData::addMeasurement(double energy, double magnetisation)
+{
+	energyStatistics.push_back(energy);
+	magnetisationStatistics.push_back(magnetisation);
+	if(keepSamples)
+	{
+		energyData.push_back(energy);
+		magnetisationData.push_back(magnetisation);
+	}
+}
+
+void SimulationData::reserve(int size)
+{
+	if(keepSamples)
+	{
+		energyData.reserve(size);
+		magnetisationData.reserve(size);
+	}
+}
+
+void SimulationData::save(std::ostream &out) const
+{
+	writeValue(out, keepSamples);
+	energyData.save(out);
+	magnetisationData.save(out);
+	energyStatistics.save(out);
+	magnetisationStatistics.save(out);
+	clusterSizeStatistics.save(out);
+	writeValue(out, totalClusterSize);
+	writeValue(out, totalClusters);
+}
+
+void SimulationData::load(std::istream &in)
+{
+	keepSamples = readValue<bool>(in);
+	energyData.load(in);
+	magnetisationData.load(in);
+	energyStatistics.load(in);
+	magnetisationStatistics.load(in);
+	clusterSizeStatistics.load(in);
+	totalClusterSize = readValue<long long>(in);
+	totalClusters = readValue<long long>(in);
+}
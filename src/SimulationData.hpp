@@ -0,0 +1,65 @@
+#ifndef SimulationData_hpp
+#define SimulationData_hpp
+#include "DataArray.hpp"
+#include "StreamingStatistics.hpp"
+#include "RunProfile.hpp"
+
+/**
+ *\file
+ *\class SimulationData
+ *\brief Class for holding the samples measured by a simulation at one temperature.
+ *
+ * This class essentially just holds the measurements so they can be passed on to the analysis. Every
+ * measurement is added to the streaming statistics, the samples themselves are only kept if keepSamples is set.
+ */
+class SimulationData
+{
+public:
+	/// Whether every sample is kept, if not only the streaming statistics are available.
+	bool keepSamples = true;
+	/// Lattice energy at each measurement.
+	DataArray energyData;
+	/// Absolute lattice magnetisation at each measurement.
+	DataArray magnetisationData;
+	/// Running statistics of the lattice energy.
+	StreamingStatistics energyStatistics;
+	/// Running statistics of the absolute lattice magnetisation.
+	StreamingStatistics magnetisationStatistics;
+	/// Statistics of the mean Wolff cluster size of each measurement sweep, empty for other dynamics.
+	StreamingStatistics clusterSizeStatistics;
+	/// Total size of all Wolff clusters flipped after the burn period.
+	long long totalClusterSize = 0;
+	/// Number of Wolff clusters flipped after the burn period.
+	long long totalClusters = 0;
+	/// Wall time of each phase and the moves made by the dynamics, it is not saved as it only covers this run.
+	RunProfile profile;
+
+	/**
+	 *\brief Adds one measurement.
+	 *\param energy floating point value representing the lattice energy.
+	 *\param magnetisation floating point value representing the absolute lattice magnetisation.
+	 */
+	void addMeasurement(double energy, double magnetisation);
+
+	/**
+	 *\brief Reserves space for the samples if they are kept.
+	 *\param size integer value representing the number of measurements that will be made.
+	 */
+	void reserve(int size);
+
+	/**
+	 *\brief Writes the measurements to a binary stream so it can be restored with load.
+	 *\param out the stream to write to.
+	 */
+	void save(std::ostream &out) const;
+
+	/**
+	 *\brief Restores the measurements written by save.
+	 *
+	 * Failures are left in the state of the stream.
+	 *
+	 *\param in the stream to read from.
+	 */
+	void load(std::istream &in);
+};
+#endif /* SimulationData_hpp */
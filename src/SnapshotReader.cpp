@@ -0,0 +1,125 @@
+#include "SnapshotReader.hpp"
+#include "binaryIO.hpp"
+#include <cstring>
+#include <limits>
+
+SnapshotReader::SnapshotReader() : m_rowCount{0}, m_colCount{0}, m_temperature{0} {}
+
+bool SnapshotReader::open(const std::string &fileName)
+{
+	m_file.close();
+	m_file.clear();
+	m_file.open(fileName, std::ios::in | std::ios::binary);
+
+	char magic[sizeof(SnapshotWriter::magic)];
+	m_file.read(magic, sizeof(magic));
+	if(!m_file || std::memcmp(magic, SnapshotWriter::magic, sizeof(magic)) != 0
+	   || readValue<std::uint32_t>(m_file) != SnapshotWriter::version)
+	{
+		return false;
+	}
+
+	m_rowCount = static_cast<int>(readValue<std::uint32_t>(m_file));
+	m_colCount = static_cast<int>(readValue<std::uint32_t>(m_file));
+	m_temperature = readValue<double>(m_file);
+	std::uint64_t frames = readValue<std::uint64_t>(m_file);
+	std::uint64_t indexOffset = readValue<std::uint64_t>(m_file);
+
+	// A file that was never closed has no frame table.
+	if(!m_file || indexOffset == 0)
+	{
+		return false;
+	}
+
+	// The counts come from the file, so check the frame table and a keyframe fit in it before allocating for them.
+	m_file.seekg(0, std::ios::end);
+	std::uint64_t fileSize = static_cast<std::uint64_t>(m_file.tellg());
+	std::uint64_t entrySize = 2 * sizeof(std::uint64_t) + sizeof(std::int64_t);
+	std::uint64_t sites = static_cast<std::uint64_t>(m_rowCount) * static_cast<std::uint64_t>(m_colCount);
+	if(!m_file || m_rowCount <= 0 || m_colCount <= 0
+	   || sites > static_cast<std::uint64_t>(std::numeric_limits<int>::max()) || sites / 8 > fileSize
+	   || indexOffset > fileSize || frames > (fileSize - indexOffset) / entrySize)
+	{
+		return false;
+	}
+
+	m_file.seekg(indexOffset, std::ios::beg);
+	m_index.resize(frames);
+	for(auto& entry : m_index)
+	{
+		entry.offset 		 = readValue<std::uint64_t>(m_file);
+		entry.keyFrameOffset = readValue<std::uint64_t>(m_file);
+		entry.sweep 		 = readValue<std::int64_t>(m_file);
+	}
+
+	m_frame.resize((static_cast<long long>(m_rowCount) * m_colCount + 63) / 64);
+	return static_cast<bool>(m_file);
+}
+
+int SnapshotReader::getRows() const
+{
+	return m_rowCount;
+}
+
+int SnapshotReader::getCols() const
+{
+	return m_colCount;
+}
+
+double SnapshotReader::getTemperature() const
+{
+	return m_temperature;
+}
+
+int SnapshotReader::getFrames() const
+{
+	return static_cast<int>(m_index.size());
+}
+
+long long SnapshotReader::getSweep(int frame) const
+{
+	return m_index[frame].sweep;
+}
+
+bool SnapshotReader::isKeyFrame(int frame) const
+{
+	return m_index[frame].offset == m_index[frame].keyFrameOffset;
+}
+
+bool SnapshotReader::readFrame(int frame, std::vector<int> &spins)
+{
+	// Skip the type byte and sweep of the keyframe to get to its spins.
+	const SnapshotWriter::IndexEntry &entry = m_index[frame];
+	m_file.seekg(entry.keyFrameOffset + sizeof(std::uint8_t) + sizeof(std::int64_t), std::ios::beg);
+	m_file.read(reinterpret_cast<char*>(m_frame.data()), m_frame.size() * sizeof(SnapshotWriter::Word));
+
+	// A delta frame then flips the sites that changed since the keyframe.
+	if(!isKeyFrame(frame))
+	{
+		m_file.seekg(entry.offset + sizeof(std::uint8_t) + sizeof(std::int64_t), std::ios::beg);
+		std::uint32_t changes = readValue<std::uint32_t>(m_file);
+		for(std::uint32_t change = 0; change < changes; ++change)
+		{
+			// A site outside the lattice means the file is corrupt.
+			std::uint32_t site = readValue<std::uint32_t>(m_file);
+			if(site >= static_cast<std::uint32_t>(m_rowCount * m_colCount))
+			{
+				m_file.setstate(std::ios::failbit);
+				break;
+			}
+			m_frame[site / 64] ^= SnapshotWriter::Word(1) << (site % 64);
+		}
+	}
+	if(!m_file)
+	{
+		return false;
+	}
+
+	int sites = m_rowCount * m_colCount;
+	spins.resize(sites);
+	for(int site = 0; site < sites; ++site)
+	{
+		spins[site] = ((m_frame[site / 64] >> (site % 64)) & 1) ? 1 : -1;
+	}
+	return true;
+}
@@ -0,0 +1,106 @@
+#ifndef SnapshotReader_hpp
+#define SnapshotReader_hpp
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "SnapshotWriter.hpp"
+
+/**
+ *\file
+ *\class SnapshotReader
+ *\brief Reads any frame of a trajectory written by SnapshotWriter.
+ *
+ * The header and frame table are read when the file is opened, after which each frame is rebuilt from its
+ * keyframe and, for a delta frame, the list of sites that changed since the keyframe.
+ */
+class SnapshotReader
+{
+private:
+	/**
+	 *\brief Member variable holding the file being read.
+	 */
+	std::ifstream m_file;
+
+	/**
+	 *\brief Member variables holding the dimensions of the lattice.
+	 */
+	int m_rowCount;
+	int m_colCount;
+
+	/**
+	 *\brief Member variable holding the temperature of the lattice.
+	 */
+	double m_temperature;
+
+	/**
+	 *\brief Member variable holding the frame table.
+	 */
+	std::vector<SnapshotWriter::IndexEntry> m_index;
+
+	/**
+	 *\brief Member variable holding the packed spins of the last frame read.
+	 */
+	std::vector<SnapshotWriter::Word> m_frame;
+
+public:
+	/**
+	 *\brief Default constructor, no file open.
+	 */
+	SnapshotReader();
+
+	/**
+	 *\brief Opens a snapshot file and reads its header and frame table.
+	 *\param fileName name of the file to read.
+	 *\return false if the file can't be read, isn't a snapshot file, was never closed or is too short for the
+	 * lattice and frame table its header describes.
+	 */
+	bool open(const std::string &fileName);
+
+	/**
+	 *\brief Getter method for the number of rows in the lattice.
+	 *\return integer value representing the number of rows.
+	 */
+	int getRows() const;
+
+	/**
+	 *\brief Getter method for the number of columns in the lattice.
+	 *\return integer value representing the number of columns.
+	 */
+	int getCols() const;
+
+	/**
+	 *\brief Getter method for the temperature of the lattice.
+	 *\return floating point value representing the temperature.
+	 */
+	double getTemperature() const;
+
+	/**
+	 *\brief Getter method for the number of frames.
+	 *\return integer value representing the number of frames.
+	 */
+	int getFrames() const;
+
+	/**
+	 *\brief Getter method for the sweep a frame was recorded at.
+	 *\param frame index of the frame.
+	 *\return integer value representing the sweep.
+	 */
+	long long getSweep(int frame) const;
+
+	/**
+	 *\brief Whether a frame is a keyframe.
+	 *\param frame index of the frame.
+	 *\return true if the frame holds the whole lattice.
+	 */
+	bool isKeyFrame(int frame) const;
+
+	/**
+	 *\brief Reads a frame.
+	 *\param frame index of the frame.
+	 *\param spins vector filled with the spin values, +1 or -1, of the sites row by row.
+	 *\return false if the frame couldn't be read.
+	 */
+	bool readFrame(int frame, std::vector<int> &spins);
+};
+#endif /* SnapshotReader_hpp */
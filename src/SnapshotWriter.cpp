@@ -0,0 +1,94 @@
+#include "SnapshotWriter.hpp"
+#include "binaryIO.hpp"
+#include <algorithm>
+constexpr std::uint32_t SnapshotWriter::version;
+constexpr std::uint64_t SnapshotWriter::headerSize;
+const char SnapshotWriter::magic[4] = {'I', 'S', 'N', 'P'};
+
+SnapshotWriter::SnapshotWriter(const std::string &fileName, int rows, int cols, double temperature, int keyFrameInterval) :
+	m_file(fileName, std::ios::out | std::ios::binary),
+	m_rowCount{rows},
+	m_colCount{cols},
+	m_keyFrameInterval{std::max(1, keyFrameInterval)},
+	m_framesSinceKeyFrame{0},
+	m_frame((static_cast<long long>(rows) * cols + 63) / 64, 0),
+	m_keyFrame(m_frame.size(), 0)
+{
+	// The frame count and frame table offset are filled in when the file is closed.
+	m_file.write(magic, sizeof(magic));
+	writeValue(m_file, version);
+	writeValue(m_file, static_cast<std::uint32_t>(rows));
+	writeValue(m_file, static_cast<std::uint32_t>(cols));
+	writeValue(m_file, temperature);
+	writeValue(m_file, std::uint64_t(0));
+	writeValue(m_file, std::uint64_t(0));
+}
+
+SnapshotWriter::~SnapshotWriter()
+{
+	if(m_file.is_open())
+	{
+		close();
+	}
+}
+
+void SnapshotWriter::writeFrame(int sweep)
+{
+	std::uint64_t offset = static_cast<std::uint64_t>(m_file.tellp());
+
+	// Find the sites that differ from the last keyframe, giving up as soon as a keyframe would be smaller.
+	std::size_t maximumChanges = m_frame.size() * sizeof(Word) / sizeof(std::uint32_t);
+	bool delta = !m_index.empty() && m_framesSinceKeyFrame < m_keyFrameInterval;
+	m_changedSites.clear();
+	for(std::size_t word = 0; delta && word < m_frame.size(); ++word)
+	{
+		Word changed = m_frame[word] ^ m_keyFrame[word];
+		while(changed)
+		{
+			m_changedSites.push_back(static_cast<std::uint32_t>(word * 64 + __builtin_ctzll(changed)));
+			changed &= changed - 1;
+		}
+		delta = m_changedSites.size() < maximumChanges;
+	}
+
+	if(delta)
+	{
+		writeValue(m_file, static_cast<std::uint8_t>(DeltaFrame));
+		writeValue(m_file, static_cast<std::int64_t>(sweep));
+		writeValue(m_file, static_cast<std::uint32_t>(m_changedSites.size()));
+		m_file.write(reinterpret_cast<const char*>(m_changedSites.data()), m_changedSites.size() * sizeof(std::uint32_t));
+		m_index.push_back(IndexEntry{offset, m_index.back().keyFrameOffset, sweep});
+		++m_framesSinceKeyFrame;
+	}
+	else
+	{
+		writeValue(m_file, static_cast<std::uint8_t>(KeyFrame));
+		writeValue(m_file, static_cast<std::int64_t>(sweep));
+		m_file.write(reinterpret_cast<const char*>(m_frame.data()), m_frame.size() * sizeof(Word));
+		m_index.push_back(IndexEntry{offset, offset, sweep});
+		m_keyFrame.swap(m_frame);
+		m_framesSinceKeyFrame = 1;
+	}
+}
+
+void SnapshotWriter::close()
+{
+	// Frame table at the end then go back to fill in the header.
+	std::uint64_t indexOffset = static_cast<std::uint64_t>(m_file.tellp());
+	for(const auto& entry : m_index)
+	{
+		writeValue(m_file, entry.offset);
+		writeValue(m_file, entry.keyFrameOffset);
+		writeValue(m_file, entry.sweep);
+	}
+
+	m_file.seekp(headerSize - 2 * sizeof(std::uint64_t), std::ios::beg);
+	writeValue(m_file, static_cast<std::uint64_t>(m_index.size()));
+	writeValue(m_file, indexOffset);
+	m_file.close();
+}
+
+int SnapshotWriter::getFrames() const
+{
+	return static_cast<int>(m_index.size());
+}
@@ -0,0 +1,158 @@
+#ifndef SnapshotWriter_hpp
+#define SnapshotWriter_hpp
+#include <cstdint>
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "SpinLattice2D.hpp"
+
+/**
+ *\file
+ *\class SnapshotWriter
+ *\brief Records a trajectory of lattice configurations in a compact binary file.
+ *
+ * The file starts with a header holding the dimensions of the lattice, its temperature, the number of frames
+ * and the offset of the frame table. Each frame records the sweep it was taken at and is either a keyframe, the
+ * whole lattice packed one bit per spin (a set bit is a spin of +1), or a delta frame, the indices of the sites
+ * that differ from the last keyframe. A delta frame is only written while it is smaller than a keyframe and a
+ * keyframe is forced every keyframeInterval frames. Since every delta frame refers to a keyframe rather than the
+ * previous frame, any frame can be rebuilt from at most two reads. The frame table at the end of the file holds
+ * the offset, keyframe offset and sweep of every frame so a reader can seek straight to any of them. All values
+ * are stored in the byte order of the machine, read the file with SnapshotReader.
+ */
+class SnapshotWriter
+{
+public:
+	/// Type used to store the packed spins.
+	using Word = std::uint64_t;
+
+	/// Values of the type byte of each frame.
+	enum FrameType : std::uint8_t
+	{
+		KeyFrame,
+		DeltaFrame,
+	};
+
+	/// Entry of the frame table.
+	struct IndexEntry
+	{
+		/// Offset of the frame in the file.
+		std::uint64_t offset;
+		/// Offset of the keyframe the frame refers to, the frame itself for a keyframe.
+		std::uint64_t keyFrameOffset;
+		/// Sweep the frame was recorded at.
+		std::int64_t sweep;
+	};
+
+	/// First four bytes of every snapshot file.
+	static const char magic[4];
+
+	/// Version of the file format.
+	static constexpr std::uint32_t version = 1;
+
+	/// Size of the header in bytes.
+	static constexpr std::uint64_t headerSize = 40;
+
+private:
+	/**
+	 *\brief Member variable holding the file being written.
+	 */
+	std::ofstream m_file;
+
+	/**
+	 *\brief Member variables holding the dimensions of the lattice.
+	 */
+	int m_rowCount;
+	int m_colCount;
+
+	/**
+	 *\brief Member variable integer holding the maximum number of frames between keyframes.
+	 */
+	int m_keyFrameInterval;
+
+	/**
+	 *\brief Member variable integer counting the frames written since the last keyframe.
+	 */
+	int m_framesSinceKeyFrame;
+
+	/**
+	 *\brief Member variable holding the packed spins of the frame being written.
+	 */
+	std::vector<Word> m_frame;
+
+	/**
+	 *\brief Member variable holding the packed spins of the last keyframe.
+	 */
+	std::vector<Word> m_keyFrame;
+
+	/**
+	 *\brief Member variable holding the sites that differ from the last keyframe.
+	 */
+	std::vector<std::uint32_t> m_changedSites;
+
+	/**
+	 *\brief Member variable holding the frame table.
+	 */
+	std::vector<IndexEntry> m_index;
+
+	/**
+	 *\brief Writes the frame held in m_frame.
+	 *\param sweep the sweep the frame was recorded at.
+	 */
+	void writeFrame(int sweep);
+
+public:
+	/**
+	 *\brief Creates the file and writes its header.
+	 *\param fileName name of the file to create.
+	 *\param rows integer representing the number of rows in the lattice.
+	 *\param cols integer representing the number of columns in the lattice.
+	 *\param temperature floating point value representing the temperature of the lattice.
+	 *\param keyFrameInterval integer maximum number of frames between keyframes, 1 for keyframes only.
+	 */
+	SnapshotWriter(const std::string &fileName, int rows, int cols, double temperature, int keyFrameInterval);
+
+	/**
+	 *\brief Closes the file if this hasn't been done already.
+	 */
+	~SnapshotWriter();
+
+	SnapshotWriter(const SnapshotWriter&) = delete;
+	SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+	/**
+	 *\brief Records the configuration of a lattice.
+	 *\param lattice any lattice whose operator()(row, col) returns a SpinLattice2D::Spin.
+	 *\param sweep the sweep the configuration was reached at.
+	 */
+	template<class Lattice>
+	void write(const Lattice &lattice, int sweep)
+	{
+		std::fill(m_frame.begin(), m_frame.end(), 0);
+		int site = 0;
+		for(int row = 0; row < m_rowCount; ++row)
+		{
+			for(int col = 0; col < m_colCount; ++col, ++site)
+			{
+				if(SpinLattice2D::spinValues[lattice(row, col)] > 0)
+				{
+					m_frame[site / 64] |= Word(1) << (site % 64);
+				}
+			}
+		}
+		writeFrame(sweep);
+	}
+
+	/**
+	 *\brief Writes the frame table and completes the header, no frames can be written afterwards.
+	 */
+	void close();
+
+	/**
+	 *\brief Getter method for the number of frames written.
+	 *\return integer value representing the number of frames.
+	 */
+	int getFrames() const;
+};
+#endif /* SnapshotWriter_hpp */
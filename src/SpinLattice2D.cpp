@@ -1,59 +1,81 @@
 #include "SpinLattice2D.hpp"
+#include "binaryIO.hpp"
+#include "randomEngines.hpp"
+#include <cstdlib>
 constexpr int SpinLattice2D::spinValues[];
 
 SpinLattice2D::SpinLattice2D(int rows, int cols): 	m_rowCount{rows},
 													m_colCount{cols},
-													m_spinMatrix(m_rowCount*m_colCount,SpinLattice2D::Up)
+													m_stride{cols + 2},
+													m_spins((rows + 2) * (cols + 2), static_cast<std::int8_t>(SpinLattice2D::spinValues[SpinLattice2D::Up]))
 {
+	resetTotals();
 }
 
-SpinLattice2D::Spin& SpinLattice2D::operator()(int row, int col)
+void SpinLattice2D::resetTotals()
 {
-	// Take into account periodic boundary conditions.
-	row = (row + m_rowCount) % m_rowCount;
-	col = (col + m_colCount) % m_colCount;
+	m_bondSum = static_cast<int>(-1.0 * recomputeLatticeEnergy(1.0));
+	m_magnetisation = recomputeTotalMag();
+}
 
-	// Return 1D index of 1D array corresponding to the 2D index.
-	return m_spinMatrix[col + row * m_colCount];
+void SpinLattice2D::refreshGhosts()
+{
+	// Copy the last row above the first and the first row below the last.
+	std::copy_n(&m_spins[index(m_rowCount - 1, 0)], m_colCount, &m_spins[index(-1, 0)]);
+	std::copy_n(&m_spins[index(0, 0)], m_colCount, &m_spins[index(m_rowCount, 0)]);
+
+	// Then the last column to the left of the first and the first column to the right of the last.
+	for(int row = 0; row < m_rowCount; ++row)
+	{
+		m_spins[index(row, -1)] = m_spins[index(row, m_colCount - 1)];
+		m_spins[index(row, m_colCount)] = m_spins[index(row, 0)];
+	}
 }
 
-const SpinLattice2D::Spin& SpinLattice2D::operator()(int row, int col) const
+SpinLattice2D::Spin SpinLattice2D::operator()(int row, int col) const
 {
 	// Take into account periodic boundary conditions we add extra m_rowCount and m_colCount
 	// terms here to take into account the fact that the caller may be indexing with -1.
 	row = (row + m_rowCount) % m_rowCount;
 	col = (col + m_colCount) % m_colCount;
-
-	// Return 1D index of 1D array corresponding to the 2D index.
-	return m_spinMatrix[col + row * m_colCount];
+	return spin(row, col);
 }
 
 
-void SpinLattice2D::randomise(std::default_random_engine &generator)
+template<class Engine>
+void SpinLattice2D::randomise(Engine &generator)
 {
 	// Create a ``uniform'' integer distribution for generating the spins. By using the MAXSPINS
 	// value this distribution will automatically get updated if we add any more spins in the future.
 	// Need to subtract 1 to account for fact range is inclusive and indexes start at 0.
 	static std::uniform_int_distribution<int> distribution(0,static_cast<int>(SpinLattice2D::MAXSPINS)-1);
-	for(auto& spin : m_spinMatrix)
+	for(int row = 0; row < m_rowCount; ++row)
 	{
-		spin = static_cast<SpinLattice2D::Spin>(distribution(generator));
+		for(int col = 0; col < m_colCount; ++col)
+		{
+			m_spins[index(row, col)] = static_cast<std::int8_t>(SpinLattice2D::spinValues[distribution(generator)]);
+		}
 	}
+	refreshGhosts();
+	resetTotals();
 }
 
+// Instantiated for every engine that can be chosen with --rng.
+template void SpinLattice2D::randomise(std::default_random_engine&);
+template void SpinLattice2D::randomise(Xoshiro256StarStar&);
+template void SpinLattice2D::randomise(Philox4x32&);
+
 void SpinLattice2D::setEvenSpins()
 {
-	// Set first half of the spins up.
-	for(int i = 0; i < m_spinMatrix.size()/2; ++i)
-	{
-		m_spinMatrix[i] = SpinLattice2D::Up;
-	}
-
-	// Set second half of spins down.
-	for(int i = m_spinMatrix.size()/2; i < m_spinMatrix.size(); ++i)
+	// Set first half of the spins up and the second half down.
+	int size = getSize();
+	for(int i = 0; i < size; ++i)
 	{
-		m_spinMatrix[i] = SpinLattice2D::Down;
+		Spin spin = (i < size/2) ? SpinLattice2D::Up : SpinLattice2D::Down;
+		m_spins[index(i / m_colCount, i % m_colCount)] = static_cast<std::int8_t>(SpinLattice2D::spinValues[spin]);
 	}
+	refreshGhosts();
+	resetTotals();
 
 }
 
@@ -70,34 +92,19 @@ std::ostream& operator<<(std::ostream& out, const SpinLattice2D& spinLattice)
 	return out;
 }
 
-void SpinLattice2D::flip(int row, int col)
-{
-
-	if((*this)(row, col) == SpinLattice2D::Up)
-	{
-		(*this)(row, col) = SpinLattice2D::Down;
-	}
-	else
-	{
-		(*this)(row, col) = SpinLattice2D::Up;
-	}
-}
-
 void SpinLattice2D::swap(int row1, int col1, int row2, int col2)
 {
-	std::swap((*this)(row1,col1), (*this)(row2,col2));
+	// Swapping conserves the magnetisation so only the energy changes.
+	updateTotals(swapEnergyChange(row1, col1, row2, col2), 0);
+	std::int8_t value1 = m_spins[index(row1, col1)];
+	setSpin(row1, col1, m_spins[index(row2, col2)]);
+	setSpin(row2, col2, value1);
 }
 
 double SpinLattice2D::siteEnergy(int row, int col, double jConstant) const
 {
-	// For a single site we just sum over the nearest neighbours
-	// The operator() overload takes into account boundary conditions.
-	double sum = 0;
-	sum += SpinLattice2D::spinValues[(*this)(row, col)] * SpinLattice2D::spinValues[(*this)(row+1, col)];
-	sum += SpinLattice2D::spinValues[(*this)(row, col)] * SpinLattice2D::spinValues[(*this)(row-1, col)];
-	sum += SpinLattice2D::spinValues[(*this)(row, col)] * SpinLattice2D::spinValues[(*this)(row, col+1)];
-	sum += SpinLattice2D::spinValues[(*this)(row, col)] * SpinLattice2D::spinValues[(*this)(row, col-1)];
-	return -1.0 * jConstant * sum;
+	// For a single site we just sum over the nearest neighbours, which is the spin times its local field.
+	return -1.0 * jConstant * flipEnergyChange(row, col);
 }
 
 double SpinLattice2D::sitePairEnergy(int row1, int col1, int row2, int col2, const double jConstant) const
@@ -117,7 +124,7 @@ double SpinLattice2D::sitePairEnergy(int row1, int col1, int row2, int col2, con
 		 * directly, therefore we are over or under-counting the energy by one unit. The amount by which we
 		 * over or under count is just the product of the spins and the jConstant parameter.
 		 */
-		double overCount = -1.0 * SpinLattice2D::spinValues[(*this)(row1,col1)] * SpinLattice2D::spinValues[(*this)(row2,col2)];
+		double overCount = -1.0 * m_spins[index(row1, col1)] * m_spins[index(row2, col2)];
 	 	return siteEnergy(row1, col1, jConstant) + siteEnergy(row2, col2, jConstant) - overCount;
 
 
@@ -132,11 +139,34 @@ double SpinLattice2D::sitePairEnergy(int row1, int col1, int row2, int col2, con
 
 }
 
+int SpinLattice2D::swapEnergyChange(int row1, int col1, int row2, int col2) const
+{
+	// Swapping equal spins leaves the lattice unchanged.
+	if(m_spins[index(row1, col1)] == m_spins[index(row2, col2)])
+	{
+		return 0;
+	}
+
+	// Opposite spins are swapped by flipping both, the shared bond of nearest neighbours is anti-aligned
+	// before and after so we remove its contribution of -1 from each site's flip.
+	int energyChange = flipEnergyChange(row1, col1) + flipEnergyChange(row2, col2);
+	if(nearestNeighbours(row1, col1, row2, col2))
+	{
+		energyChange += 2;
+	}
+	return energyChange;
+}
+
 double SpinLattice2D::latticeEnergy(double jConstant) const
+{
+	return -1.0 * jConstant * m_bondSum;
+}
+
+double SpinLattice2D::recomputeLatticeEnergy(double jConstant) const
 {
 	/* In order to calculate total energy without over counting we only consider the nearest neighbours
 	 * below and to the right of each site, the periodic boundary conditions then insure that all sites
-	 * are counted once.
+	 * are counted once. This uses operator() rather than the ghost sites so it also checks them.
 	 */
 	double sum = 0;
 	for(unsigned row = 0; row < m_rowCount; ++row)
@@ -168,19 +198,16 @@ int SpinLattice2D::getSize() const
 
 bool SpinLattice2D::nearestNeighbours(int row1, int col1, int row2, int col2) const
 {
-	// Need to check above/below and right/left including the periodic boundary conditions.
-
-	// Check above and ``over the bottom'' of the lattice.
-	if( (row1 == (row2+1)%m_rowCount) && (col1 == col2) ) { return true;}
+	// Need to check above/below and right/left including the periodic boundary conditions, sites on
+	// opposite edges are neighbours ``over the edge'' of the lattice.
+	int rowDistance = std::abs(row1 - row2);
+	int colDistance = std::abs(col1 - col2);
 
-	// Check below.
-	if( (row2 == (row1+1)%m_rowCount) && (col1 == col2) ) { return true;}
+	// Check above and below.
+	if( (col1 == col2) && (rowDistance == 1 || rowDistance == m_rowCount - 1) ) { return true;}
 
-	// Check the left.
-	if( (col1 == (col2+1)%m_colCount) && (row1 == row2) ) { return true;}
-
-	// Check to the right
-	if( (col2 == (col1+1)%m_rowCount) && (row1 == row2) ) { return true;}
+	// Check the left and right.
+	if( (row1 == row2) && (colDistance == 1 || colDistance == m_colCount - 1) ) { return true;}
 
 	// If it has reached this point there are no nearest neighbours.
 	return false;
@@ -188,11 +215,51 @@ bool SpinLattice2D::nearestNeighbours(int row1, int col1, int row2, int col2) co
 }
 
 int SpinLattice2D::totalMag() const
+{
+	return m_magnetisation;
+}
+
+int SpinLattice2D::recomputeTotalMag() const
 {
 	int sum = 0;
-	for(const auto& mag : m_spinMatrix)
+	for(int row = 0; row < m_rowCount; ++row)
 	{
-		sum += SpinLattice2D::spinValues[mag];
+		for(int col = 0; col < m_colCount; ++col)
+		{
+			sum += m_spins[index(row, col)];
+		}
 	}
 	return sum;
 }
+
+void SpinLattice2D::save(std::ostream &out) const
+{
+	// One bit per spin, set for Down.
+	std::size_t size = getSize();
+	std::vector<std::uint64_t> words((size + 63) / 64, 0);
+	for(std::size_t site = 0; site < size; ++site)
+	{
+		words[site / 64] |= static_cast<std::uint64_t>(spin(site / m_colCount, site % m_colCount) == Down) << (site % 64);
+	}
+	writeVector(out, words);
+}
+
+void SpinLattice2D::load(std::istream &in)
+{
+	std::vector<std::uint64_t> words;
+	readVector(in, words);
+	std::size_t size = getSize();
+	if(words.size() != (size + 63) / 64)
+	{
+		in.setstate(std::ios::failbit);
+		return;
+	}
+
+	for(std::size_t site = 0; site < size; ++site)
+	{
+		Spin spin = ((words[site / 64] >> (site % 64)) & 1) ? Down : Up;
+		m_spins[index(site / m_colCount, site % m_colCount)] = static_cast<std::int8_t>(SpinLattice2D::spinValues[spin]);
+	}
+	refreshGhosts();
+	resetTotals();
+}
@@ -1,5 +1,6 @@
 #ifndef SpinLattice2D_hpp
 #define SpinLattice2D_hpp
+#include <cstdint>
 #include <random>
 #include <vector>
 #include <iostream>
@@ -14,6 +15,12 @@
  * A 2D spin lattice consists of a 2D array of ``spins'' which can either be ``up'' or ``'down'.
  * This class currently does not support any 1-D implementation, i.e. declaring a SpinLattice2D
  * with 1 column or 1 row will not give the expected results.
+ *
+ * The spins are stored one byte each surrounded by ghost sites holding copies of the opposite edge, so the
+ * updates (flipEnergyChange, flip, swap and the methods they use) find the neighbours of a site by pointer
+ * offsets without any modulo. They are defined in this header so the dynamics can inline them and take
+ * coordinates inside the lattice. operator() still applies the periodic boundary conditions to any
+ * coordinates and is the slow path for output and checks.
  */
 class SpinLattice2D
 {
@@ -42,10 +49,60 @@ public:
 		int m_rowCount;
 
 		/**
-		 *\brief Member variable array to represent the spins in the lattice.
-		 * 1D implementation for efficient memory use.
+		 *\brief Member variable integer holding the distance between rows in m_spins, the columns plus two ghost columns.
+		 */
+		int m_stride;
+
+		/**
+		 *\brief Member variable array holding the value of each spin, -1 or +1, row by row surrounded by ghost sites.
+		 *
+		 * Site (row, col) is stored at (row + 1) * m_stride + col + 1. The ghost rows above and below and ghost
+		 * columns either side hold copies of the sites on the opposite edge, so the neighbours of every site are
+		 * plain offsets of -m_stride, m_stride, -1 and 1 without applying the periodic boundary conditions. The
+		 * corners are never read.
+		 */
+		std::vector<std::int8_t> m_spins;
+
+		/**
+		 *\brief Member variable integer holding the running sum of S_site * S_neighbour over all bonds.
+		 *
+		 * The energy of the lattice is -J times this sum, it is kept up to date on every flip and swap.
+		 */
+		int m_bondSum;
+
+		/**
+		 *\brief Member variable integer holding the running total magnetisation.
+		 */
+		int m_magnetisation;
+
+		/**
+		 *\brief Gets the position of a site inside the lattice in m_spins.
+		 *\param row row index of site, must be in the lattice.
+		 *\param col column index of site, must be in the lattice.
+		 *\return index of the site.
+		 */
+		int index(int row, int col) const;
+
+		/**
+		 *\brief Sets the value of a site and of its copies in the ghost sites.
+		 *
+		 * Does not update the running totals so it is only used by methods that keep them consistent.
+		 *
+		 *\param row row index of site, must be in the lattice.
+		 *\param col column index of site, must be in the lattice.
+		 *\param value the value of the spin, -1 or +1.
+		 */
+		void setSpin(int row, int col, std::int8_t value);
+
+		/**
+		 *\brief Copies every edge site into the ghost sites after the whole lattice has been changed.
 		 */
-		std::vector<Spin> m_spinMatrix;
+		void refreshGhosts();
+
+		/**
+		 *\brief Recalculates the running energy and magnetisation after the whole lattice has been changed.
+		 */
+		void resetTotals();
 
 	public:
 
@@ -58,9 +115,11 @@ public:
 
 		/**
 		 *\brief Randomises all spins in array.
-		 *\param generator reference to random engine to generate uniform random numbers on [0,1]
+		 *\param generator reference to random engine to generate uniform random numbers on [0,1], std::default_random_engine,
+		 * Xoshiro256StarStar or Philox4x32.
 		 */
-		void randomise(std::default_random_engine &generator);
+		template<class Engine>
+		void randomise(Engine &generator);
 
 		/**
 		 *\brief Sets even proportions of each spin in blocks.
@@ -77,17 +136,35 @@ public:
 
 		/**
 		 *\brief flips spin at specified position.
-		 *\param row row of spin to be flipped.
-		 *\param col column of spin to be flipped.
+		 *\param row row of spin to be flipped, must be in the lattice.
+		 *\param col column of spin to be flipped, must be in the lattice.
 		 */
 		void flip(int row, int col);
 
+		/**
+		 *\brief flips spin at specified position without updating the running energy and magnetisation.
+		 *
+		 * This is for updates that flip many spins concurrently (e.g. checkerboard sweeps across threads)
+		 * which accumulate the changes themselves and then apply them once with updateTotals.
+		 *
+		 *\param row row of spin to be flipped, must be in the lattice.
+		 *\param col column of spin to be flipped, must be in the lattice.
+		 */
+		void flipUntracked(int row, int col);
+
+		/**
+		 *\brief Applies accumulated changes to the running energy and magnetisation.
+		 *\param energyChange integer energy change in units of 2J, i.e. the sum of flipEnergyChange of the flips.
+		 *\param magnetisationChange integer change in the total magnetisation.
+		 */
+		void updateTotals(int energyChange, int magnetisationChange);
+
 		/**
 		 *\brief swaps spin at specified positions.
-		 *\param row1 row of first spin to be swapped.
-		 *\param col1 column of first spin to be swapped.
-		 *\param row2 row of second spin to be swapped.
-		 *\param col2 column of second spin to be swapped.
+		 *\param row1 row of first spin to be swapped, must be in the lattice.
+		 *\param col1 column of first spin to be swapped, must be in the lattice.
+		 *\param row2 row of second spin to be swapped, must be in the lattice.
+		 *\param col2 column of second spin to be swapped, must be in the lattice.
 		 */
 		void swap(int row1, int col1, int row2, int col2);
 
@@ -98,8 +175,8 @@ public:
 		 * E_site = - J * Sum_{nearest neighbours} S_site * S_neighbour,
 		 * where S is the spin on a given site.
 		 *
-		 *\param row row of lattice site to calculate energy for.
-		 *\param col column of lattice site to calculate energy for.
+		 *\param row row of lattice site to calculate energy for, must be in the lattice.
+		 *\param col column of lattice site to calculate energy for, must be in the lattice.
 		 *\param jConstant constant floating point value representing the value of the J constant.
 		 *\return floating point value representing the energy.
 		 */
@@ -113,25 +190,72 @@ public:
 		 * This method takes into account the fact that selected sites may be nearest neighbours or
 		 * the same site and deals with those cases appropriately.
 		 *
-		 *\param row1 row of first lattice site to calculate energy for.
-		 *\param col1 column of first lattice site to calculate energy for.
-		 *\param row2 row of second lattice site to calculate energy for.
-		 *\param col2 column of second lattice site to calculate energy for.
+		 *\param row1 row of first lattice site to calculate energy for, must be in the lattice.
+		 *\param col1 column of first lattice site to calculate energy for, must be in the lattice.
+		 *\param row2 row of second lattice site to calculate energy for, must be in the lattice.
+		 *\param col2 column of second lattice site to calculate energy for, must be in the lattice.
 		 *\param jConstant constant floating point value representing the value of the J constant.
 		 *\return floating point value representing the energy.
 		 */
 		double sitePairEnergy(int row1, int col1,int row2,int col2, const double jConstant) const;
 
 		/**
-		 *\brief Calculates the total energy of the lattice.
+		 *\brief Calculates the local field at a site.
 		 *
-		 * Energy is calculated according to the formula E = -J * Sum_{all nearest neighbours} S_site * S_neighbours,
-		 * where S is the spin on a given site.
+		 * The local field is the sum of the values of the spins on the nearest neighbours of the site.
+		 *
+		 *\param row row of lattice site, must be in the lattice.
+		 *\param col column of lattice site, must be in the lattice.
+		 *\return integer value representing the local field.
+		 */
+		int localField(int row, int col) const;
+
+		/**
+		 *\brief Calculates the energy change of flipping a single spin in units of 2J.
+		 *
+		 * Flipping the spin S_site changes the energy by 2J * S_site * Sum_{nearest neighbours} S_neighbour,
+		 * this method returns the integer S_site * Sum_{nearest neighbours} S_neighbour without changing the lattice.
+		 *
+		 *\param row row of lattice site, must be in the lattice.
+		 *\param col column of lattice site, must be in the lattice.
+		 *\return integer value representing the energy change in units of 2J.
+		 */
+		int flipEnergyChange(int row, int col) const;
+
+		/**
+		 *\brief Calculates the energy change of swapping two spins in units of 2J.
+		 *
+		 * Swapping equal spins does nothing. Swapping opposite spins is the same as flipping both of them,
+		 * if the sites are nearest neighbours the bond between them stays anti-aligned and is not counted.
+		 * The lattice is not changed.
+		 *
+		 *\param row1 row of first lattice site, must be in the lattice.
+		 *\param col1 column of first lattice site.
+		 *\param row2 row of second lattice site.
+		 *\param col2 column of second lattice site.
+		 *\return integer value representing the energy change in units of 2J.
+		 */
+		int swapEnergyChange(int row1, int col1, int row2, int col2) const;
+
+		/**
+		 *\brief Gets the total energy of the lattice.
+		 *
+		 * Energy is given by the formula E = -J * Sum_{all nearest neighbours} S_site * S_neighbours,
+		 * where S is the spin on a given site. The sum is kept up to date on every flip and swap so this is O(1).
 		 *
 		 *\param jConstant constant floating point value representing the value of the J constant.
 		 */
 		double latticeEnergy(const double jConstant) const;
 
+		/**
+		 *\brief Calculates the total energy of the lattice with a full pass over the lattice.
+		 *
+		 * Should always agree with latticeEnergy, used to check the running total.
+		 *
+		 *\param jConstant constant floating point value representing the value of the J constant.
+		 */
+		double recomputeLatticeEnergy(const double jConstant) const;
+
 		/**
 		 *\brief Getter method for the number of columns in the spin lattice.
 		 *\return integer value representing number of columns.
@@ -154,10 +278,10 @@ public:
 		 *\brief Calculates whether two sites are nearest neighbours.
 		 *
 		 * This method takes into account periodic boundary conditions.
-		 *\param row1 integer value representing row index of first site.
-		 *\param col1 integer value representing column index of first site.
-		 *\param row2 integer value representing row index of second site.
-		 *\param col2 integer value representing column index of second site.
+		 *\param row1 integer value representing row index of first site, must be in the lattice.
+		 *\param col1 integer value representing column index of first site, must be in the lattice.
+		 *\param row2 integer value representing row index of second site, must be in the lattice.
+		 *\param col2 integer value representing column index of second site, must be in the lattice.
 		 *\return boolean value representing whether site are nearest neighbours or not.
 		 */
 		bool nearestNeighbours(int row1, int col1, int row2, int col2) const;
@@ -168,32 +292,124 @@ public:
 		 * This method is implemented since the spins are stored internally as a 1D vector, hence
 		 * they need to be indexed in a special way in order to get the site that would correspond to
 		 * the (i,j) site in matrix notation. This function allows the caller to treat the lattice as a
-		 * 2D matrix without having to worry about the internal implementation.
+		 * 2D matrix without having to worry about the internal implementation. Spins can only be changed
+		 * through flip and swap so that the running energy and magnetisation stay correct. Any row and column
+		 * can be given, the periodic boundary conditions are applied with a modulo.
 		 *
 		 *\param row row index of site.
 		 *\param col column index of site.
-		 *\return reference to spin stored at site so called can use it or set it.
+		 *\return the spin stored at site.
 		 */
-		Spin& operator()(int row, int col);
+		Spin operator()(int row, int col) const;
 
 		/**
-		 *\brief constant version of non-constant counterpart for use with constant SpinLattice2D object.
+		 *\brief Gets the spin at a site inside the lattice without applying the boundary conditions.
 		 *
-		 * See non-constant version for description.
+		 * One row or one column (not both) beyond an edge is also allowed, that reads the ghost copy of the
+		 * opposite edge.
 		 *
-		 *\param row row index of site.
-		 *\param col column index of site.
-		 *\return constant reference to spin stored at site so called can use it only.
+		 *\param row row index of site, from -1 to the number of rows.
+		 *\param col column index of site, from -1 to the number of columns.
+		 *\return the spin stored at site.
 		 */
-		const Spin& operator()(int row, int col) const;
+		Spin spin(int row, int col) const;
 
 		/**
-		 *\brief Calculates total magnetisation of the spin lattice.
+		 *\brief Gets total magnetisation of the spin lattice.
 		 *
-		 * Uses the formula M = Sum_{all sites} S_{site} where S is the spin at a given site.
+		 * Given by the formula M = Sum_{all sites} S_{site} where S is the spin at a given site. The sum is
+		 * kept up to date on every flip so this is O(1).
 		 *\return integer value representing the total magnetisation.
 		 */
 		int totalMag() const;
 
+		/**
+		 *\brief Calculates total magnetisation of the spin lattice with a full pass over the lattice.
+		 *
+		 * Should always agree with totalMag, used to check the running total.
+		 *\return integer value representing the total magnetisation.
+		 */
+		int recomputeTotalMag() const;
+
+		/**
+		 *\brief Writes the spins of the lattice, which must have the same dimensions when it is loaded, to a binary stream so it can be restored with load.
+		 *\param out the stream to write to.
+		 */
+		void save(std::ostream &out) const;
+
+		/**
+		 *\brief Restores the spins of the lattice, which must have the same dimensions when it is loaded, written by save.
+		 *
+		 * Failures are left in the state of the stream.
+		 *
+		 *\param in the stream to read from.
+		 */
+		void load(std::istream &in);
 };
+
+// The methods used by every update are defined here so the dynamics can inline them.
+
+inline int SpinLattice2D::index(int row, int col) const
+{
+	return (row + 1) * m_stride + col + 1;
+}
+
+inline void SpinLattice2D::setSpin(int row, int col, std::int8_t value)
+{
+	std::int8_t *site = &m_spins[index(row, col)];
+	*site = value;
+
+	// Sites on an edge are copied to the ghost site beyond the opposite edge.
+	if(row == 0)
+	{
+		site[m_rowCount * m_stride] = value;
+	}
+	if(row == m_rowCount - 1)
+	{
+		site[-m_rowCount * m_stride] = value;
+	}
+	if(col == 0)
+	{
+		site[m_colCount] = value;
+	}
+	if(col == m_colCount - 1)
+	{
+		site[-m_colCount] = value;
+	}
+}
+
+inline SpinLattice2D::Spin SpinLattice2D::spin(int row, int col) const
+{
+	// Up is stored as -1 and Down as +1.
+	return (m_spins[index(row, col)] > 0) ? SpinLattice2D::Down : SpinLattice2D::Up;
+}
+
+inline int SpinLattice2D::localField(int row, int col) const
+{
+	const std::int8_t *site = &m_spins[index(row, col)];
+	return site[-m_stride] + site[m_stride] + site[-1] + site[1];
+}
+
+inline int SpinLattice2D::flipEnergyChange(int row, int col) const
+{
+	return m_spins[index(row, col)] * localField(row, col);
+}
+
+inline void SpinLattice2D::flip(int row, int col)
+{
+	// Flipping changes the bond sum by -2 S_site * Sum S_neighbour and the magnetisation by -2 S_site.
+	updateTotals(flipEnergyChange(row, col), -2 * m_spins[index(row, col)]);
+	flipUntracked(row, col);
+}
+
+inline void SpinLattice2D::flipUntracked(int row, int col)
+{
+	setSpin(row, col, static_cast<std::int8_t>(-m_spins[index(row, col)]));
+}
+
+inline void SpinLattice2D::updateTotals(int energyChange, int magnetisationChange)
+{
+	m_bondSum -= 2 * energyChange;
+	m_magnetisation += magnetisationChange;
+}
 #endif /* SpinLattice2D_hpp */
@@ -0,0 +1,179 @@
+#include "StreamingStatistics.hpp"
+#include "binaryIO.hpp"
+#include <cmath>
+#include <algorithm>
+
+StreamingStatistics::StreamingStatistics() : m_size{0}, m_mean{0}, m_m2{0}, m_m3{0}, m_m4{0} {}
+
+void StreamingStatistics::push_back(double sample)
+{
+	// Update the central moments using the previous ones, higher moments first.
+	double n = static_cast<double>(++m_size);
+	double delta = sample - m_mean;
+	double deltaN = delta / n;
+	double deltaN2 = deltaN * deltaN;
+	double term = delta * deltaN * (n - 1);
+
+	m_mean += deltaN;
+	m_m4 += term * deltaN2 * (n * n - 3 * n + 3) + 6 * deltaN2 * m_m2 - 4 * deltaN * m_m3;
+	m_m3 += term * deltaN * (n - 2) - 3 * deltaN * m_m2;
+	m_m2 += term;
+
+	addBin(0, sample, sample * sample);
+}
+
+void StreamingStatistics::addBin(int level, double mean, double squareMean)
+{
+	while(true)
+	{
+		if(level == static_cast<int>(m_levels.size()))
+		{
+			m_levels.emplace_back();
+		}
+
+		BinLevel &bins = m_levels[level];
+		if(bins.bins == 0)
+		{
+			bins.firstA = mean;
+		}
+		else
+		{
+			bins.sumLagA += bins.lastA * mean;
+		}
+		bins.lastA = mean;
+		++bins.bins;
+		bins.sumA  += mean;
+		bins.sumB  += squareMean;
+		bins.sumAA += mean * mean;
+		bins.sumBB += squareMean * squareMean;
+		bins.sumAB += mean * squareMean;
+
+		if(!bins.pending)
+		{
+			bins.pending = true;
+			bins.pendingMean = mean;
+			bins.pendingSquareMean = squareMean;
+			return;
+		}
+
+		// Two bins of this level make one of the next.
+		bins.pending = false;
+		mean = 0.5 * (bins.pendingMean + mean);
+		squareMean = 0.5 * (bins.pendingSquareMean + squareMean);
+		++level;
+	}
+}
+
+long long StreamingStatistics::getSize() const
+{
+	return m_size;
+}
+
+double StreamingStatistics::mean() const
+{
+	return m_mean;
+}
+
+double StreamingStatistics::squareMean() const
+{
+	return m_m2 / m_size + m_mean * m_mean;
+}
+
+double StreamingStatistics::fourthMean() const
+{
+	double mean2 = m_mean * m_mean;
+	return (m_m4 + 4 * m_mean * m_m3 + 6 * mean2 * m_m2) / m_size + mean2 * mean2;
+}
+
+double StreamingStatistics::variance() const
+{
+	return m_m2 / m_size;
+}
+
+double StreamingStatistics::error() const
+{
+	return std::sqrt(variance() / (m_size - 1));
+}
+
+double StreamingStatistics::binderCumulant() const
+{
+	double squareMean_x = squareMean();
+	return 1.0 - fourthMean() / (3.0 * squareMean_x * squareMean_x);
+}
+
+double StreamingStatistics::operator()(const DataArray::IMomentFunctor &fcn) const
+{
+	return fcn(mean(), squareMean());
+}
+
+int StreamingStatistics::getLevels() const
+{
+	int levels = 0;
+	while(levels < static_cast<int>(m_levels.size()) && m_levels[levels].bins >= 2)
+	{
+		++levels;
+	}
+	return levels;
+}
+
+double StreamingStatistics::binnedError(const DataArray::IMomentFunctor &fcn, int level) const
+{
+	const BinLevel &bins = m_levels[level];
+	double n = static_cast<double>(bins.bins);
+	double meanA = bins.sumA / n;
+	double meanB = bins.sumB / n;
+
+	// Covariance matrix of the means of a and b over the bins.
+	double varianceA  = (bins.sumAA / n - meanA * meanA) / (n - 1);
+	double varianceB  = (bins.sumBB / n - meanB * meanB) / (n - 1);
+	double covariance = (bins.sumAB / n - meanA * meanB) / (n - 1);
+
+	// Gradient by central differences since the functor is only known through its values.
+	double a = mean();
+	double b = squareMean();
+	double stepA = 1e-6 * std::max(1.0, std::abs(a));
+	double stepB = 1e-6 * std::max(1.0, std::abs(b));
+	double gradientA = (fcn(a + stepA, b) - fcn(a - stepA, b)) / (2 * stepA);
+	double gradientB = (fcn(a, b + stepB) - fcn(a, b - stepB)) / (2 * stepB);
+
+	double variance = gradientA * gradientA * varianceA + gradientB * gradientB * varianceB + 2 * gradientA * gradientB * covariance;
+	return std::sqrt(std::max(0.0, variance));
+}
+
+BlockingAnalysis StreamingStatistics::blockingAnalysis() const
+{
+	std::vector<BlockingAnalysis::Level> levels;
+	for(int level = 0; level < getLevels(); ++level)
+	{
+		const BinLevel &bins = m_levels[level];
+		double n = static_cast<double>(bins.bins);
+		double meanA = bins.sumA / n;
+		double varianceA = std::max(0.0, bins.sumAA / n - meanA * meanA);
+
+		// Expand Sum_j (a_j - <a>)(a_{j+1} - <a>) in terms of the running sums, the first bin has no predecessor
+		// and the last no successor.
+		double lagCovariance = (bins.sumLagA - meanA * (2 * bins.sumA - bins.firstA - bins.lastA) + (n - 1) * meanA * meanA) / n;
+		levels.push_back(BlockingAnalysis::Level{bins.bins, varianceA, lagCovariance});
+	}
+	return BlockingAnalysis(levels);
+}
+
+void StreamingStatistics::save(std::ostream &out) const
+{
+	writeValue(out, m_size);
+	writeValue(out, m_mean);
+	writeValue(out, m_m2);
+	writeValue(out, m_m3);
+	writeValue(out, m_m4);
+	writeVector(out, m_levels);
+}
+
+void StreamingStatistics::load(std::istream &in)
+{
+	m_size = readValue<long long>(in);
+	m_mean = readValue<double>(in);
+	m_m2 = readValue<double>(in);
+	m_m3 = readValue<double>(in);
+	m_m4 = readValue<double>(in);
+	readVector(in, m_levels);
+}
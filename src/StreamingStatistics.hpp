@@ -0,0 +1,183 @@
+#ifndef StreamingStatistics_hpp
+#define StreamingStatistics_hpp
+#include <vector>
+#include "DataArray.hpp"
+#include "BlockingAnalysis.hpp"
+
+/**
+ *\file
+ *\class StreamingStatistics
+ *\brief Class for statistical analysis of sample sets too large to store.
+ *
+ * Samples are added one at a time and only running quantities are kept, so the memory used is O(log N)
+ * however many samples are added. The mean and the second, third and fourth central moments are updated
+ * with Welford's method (generalised by Pebay to higher moments), which is numerically stable even for long
+ * runs with a large mean. Alongside these the samples are averaged hierarchically into bins of 2^k samples
+ * for every k, and for each bin size the sums needed for the variance and covariance of the bin means of the
+ * samples and their squares are kept. These give error estimates for correlated samples, both of the mean and
+ * of any function of the first two moments such as the susceptibility and heat capacity.
+ */
+class StreamingStatistics
+{
+private:
+	/**
+	 *\brief Running sums over the completed bins of one size and the bin of that size being filled.
+	 */
+	struct BinLevel
+	{
+		/// Whether the first half of the next bin is waiting for its second half.
+		bool pending = false;
+		/// Mean of the samples and of their squares in the waiting half bin.
+		double pendingMean = 0;
+		double pendingSquareMean = 0;
+		/// Number of completed bins.
+		long long bins = 0;
+		/// Sums of the bin means a of the samples and b of their squares, and their products.
+		double sumA = 0;
+		double sumB = 0;
+		double sumAA = 0;
+		double sumBB = 0;
+		double sumAB = 0;
+		/// First and latest bin means of the samples and the sum of the products of neighbouring ones.
+		double firstA = 0;
+		double lastA = 0;
+		double sumLagA = 0;
+	};
+
+	/**
+	 *\brief Member variable holding the number of samples added.
+	 */
+	long long m_size;
+
+	/**
+	 *\brief Member variable holding the running mean.
+	 */
+	double m_mean;
+
+	/**
+	 *\brief Member variables holding the running sums of the second, third and fourth powers of deviations from the mean.
+	 */
+	double m_m2;
+	double m_m3;
+	double m_m4;
+
+	/**
+	 *\brief Member variable holding the bins of each size, level k holds bins of 2^k samples.
+	 */
+	std::vector<BinLevel> m_levels;
+
+	/**
+	 *\brief Adds a completed bin to a level and combines it with the waiting half bin into a bin of the next level.
+	 *\param level index of the level.
+	 *\param mean mean of the samples in the bin.
+	 *\param squareMean mean of the squares of the samples in the bin.
+	 */
+	void addBin(int level, double mean, double squareMean);
+
+public:
+	/**
+	 *\brief Default constructor, no samples.
+	 */
+	StreamingStatistics();
+
+	/**
+	 *\brief Adds a sample.
+	 *\param sample floating point instance to be added.
+	 *
+	 * Has the same name as the DataArray method so either can be filled by the same code.
+	 */
+	void push_back(double sample);
+
+	/**
+	 *\brief Getter method for the number of samples added.
+	 *\return integer value representing the number of samples.
+	 */
+	long long getSize() const;
+
+	/**
+	 *\brief Method to get the mean of the samples.
+	 *\return Floating point value representing the mean.
+	 */
+	double mean() const;
+
+	/**
+	 *\brief Method to get the mean of the squares of the samples.
+	 *\return Floating point value representing the square mean.
+	 */
+	double squareMean() const;
+
+	/**
+	 *\brief Method to get the mean of the fourth powers of the samples.
+	 *\return Floating point value representing the fourth power mean.
+	 */
+	double fourthMean() const;
+
+	/**
+	 *\brief Method to get the variance of the samples, defined as in DataArray.
+	 *\return floating point value representing the variance.
+	 */
+	double variance() const;
+
+	/**
+	 *\brief Method to get the naive error of the mean, which assumes the samples are uncorrelated.
+	 *\return Floating point value representing the naive error.
+	 */
+	double error() const;
+
+	/**
+	 *\brief Method to get the Binder cumulant U = 1 - <x^4>/(3<x^2>^2).
+	 *\return Floating point value representing the Binder cumulant.
+	 */
+	double binderCumulant() const;
+
+	/**
+	 *\brief Evaluates a function of the first two moments on the samples.
+	 *\param fcn an IMomentFunctor reference that is the function.
+	 *\return floating point value representing the function of the samples.
+	 */
+	double operator()(const DataArray::IMomentFunctor &fcn) const;
+
+	/**
+	 *\brief Getter method for the number of bin sizes that hold at least two bins.
+	 *\return integer value representing the number of levels, level k has bins of 2^k samples.
+	 */
+	int getLevels() const;
+
+	/**
+	 *\brief Method to estimate the error of a function of the first two moments from bin means of one size.
+	 *
+	 * Uses the delta method, the variance of the function is estimated from the gradient of the function with
+	 * respect to the mean and square mean and the covariance matrix of the bin means of the samples and their
+	 * squares.
+	 *
+	 *\param fcn an IMomentFunctor reference that is the function.
+	 *\param level index of the level.
+	 *\return Floating point value representing the error.
+	 */
+	double binnedError(const DataArray::IMomentFunctor &fcn, int level) const;
+
+	/**
+	 *\brief Method to carry out a blocking analysis of the samples from the bins of every size.
+	 *
+	 * Gives the same result as a BlockingAnalysis of the stored samples, apart from rounding.
+	 *
+	 *\return BlockingAnalysis instance holding the errors of every level and the plateau.
+	 */
+	BlockingAnalysis blockingAnalysis() const;
+
+	/**
+	 *\brief Writes the running moments and bins to a binary stream so it can be restored with load.
+	 *\param out the stream to write to.
+	 */
+	void save(std::ostream &out) const;
+
+	/**
+	 *\brief Restores the running moments and bins written by save.
+	 *
+	 * Failures are left in the state of the stream.
+	 *
+	 *\param in the stream to read from.
+	 */
+	void load(std::istream &in);
+};
+#endif /* StreamingStatistics_hpp */
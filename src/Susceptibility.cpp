@@ -5,5 +5,10 @@ Susceptibility::Susceptibility(double boltzmannConstant, double temperature) : m
 
 double Susceptibility::operator()(const DataArray &data) const
 {
-	return 1/(m_boltzmannConstant * m_temperature) * (data.variance());
+	return (*this)(data.mean(), data.squareMean());
+}
+
+double Susceptibility::operator()(double mean, double squareMean) const
+{
+	return 1/(m_boltzmannConstant * m_temperature) * (squareMean - mean * mean);
 }
@@ -2,7 +2,7 @@
 #define Susceptibility_hpp
 #include "DataArray.hpp"
 
-class Susceptibility : public DataArray::IDataFunctor
+class Susceptibility : public DataArray::IDataFunctor, public DataArray::IMomentFunctor
 {
 private:
 	double m_boltzmannConstant;
@@ -13,6 +13,8 @@ public:
 
 	double operator()(const DataArray &data) const;
 
+	double operator()(double mean, double squareMean) const;
+
 };
 
 #endif /* Susceptibility_hpp */
\ No newline at end of file
@@ -0,0 +1,265 @@
+#include "SwendsenWangDynamics.hpp"
+#include "binaryIO.hpp"
+#include <thread>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	// Calls work(thread, firstRow, lastRow) for contiguous blocks of rows, one per thread, and waits for all of
+	// them to finish. The calling thread does the first block itself.
+	void forEachRowBlock(int rows, int threads, const std::function<void(int, int, int)> &work)
+	{
+		std::vector<std::thread> workers;
+		workers.reserve(threads-1);
+		for(int thread = 1; thread < threads; ++thread)
+		{
+			workers.emplace_back(work, thread, (rows * thread) / threads, (rows * (thread+1)) / threads);
+		}
+
+		work(0, 0, rows / threads);
+
+		for(auto& worker : workers)
+		{
+			worker.join();
+		}
+	}
+
+	// Bits of SwendsenWangDynamics::m_bonds.
+	constexpr std::uint8_t rightBond = 1;
+	constexpr std::uint8_t belowBond = 2;
+}
+
+SwendsenWangDynamics::SwendsenWangDynamics(const SpinLattice2D &lattice,
+										   double jConstant,
+										   double boltzmannConstant,
+										   double temperature,
+										   unsigned int seed,
+										   int threads) : 	m_parents(lattice.getSize()),
+															m_bonds(lattice.getSize()),
+															m_flipRoots(lattice.getSize()),
+															m_threadCount{std::max(1, std::min(threads, lattice.getRows()))}
+{
+	// Seed every row's engine from the user seed and the row index, the extra constant keeps these streams
+	// distinct from those used for checkerboard sweeps with the same seed.
+	m_rowGenerators.reserve(lattice.getRows());
+	for(int row = 0; row < lattice.getRows(); ++row)
+	{
+		std::seed_seq sequence{seed, static_cast<unsigned int>(row), 1u};
+		m_rowGenerators.emplace_back(sequence);
+	}
+
+	double range = static_cast<double>(std::default_random_engine::max() - std::default_random_engine::min()) + 1.0;
+	double bondProbability = 1.0 - std::exp(-2.0 * jConstant / (boltzmannConstant * temperature));
+	m_bondThreshold = static_cast<std::uint64_t>(std::llround(bondProbability * range));
+}
+
+int SwendsenWangDynamics::find(int site)
+{
+	while(true)
+	{
+		int parent = m_parents[site].load(std::memory_order_relaxed);
+		if(parent == site)
+		{
+			return site;
+		}
+
+		// Point the site at its grandparent, parents only ever move towards the root so losing the race to
+		// another thread is harmless.
+		int grandParent = m_parents[parent].load(std::memory_order_relaxed);
+		if(grandParent != parent)
+		{
+			m_parents[site].compare_exchange_weak(parent, grandParent, std::memory_order_relaxed);
+		}
+		site = grandParent;
+	}
+}
+
+void SwendsenWangDynamics::unite(int site1, int site2)
+{
+	while(true)
+	{
+		int root1 = find(site1);
+		int root2 = find(site2);
+		if(root1 == root2)
+		{
+			return;
+		}
+
+		// Always link the larger root below the smaller one. If another thread has linked it in the mean
+		// time the compare-and-swap fails and we try again from the new roots.
+		if(root1 < root2)
+		{
+			std::swap(root1, root2);
+		}
+
+		int expected = root1;
+		if(m_parents[root1].compare_exchange_strong(expected, root2))
+		{
+			return;
+		}
+
+		site1 = root1;
+		site2 = root2;
+	}
+}
+
+void SwendsenWangDynamics::activateBonds(const SpinLattice2D &lattice, int firstRow, int lastRow)
+{
+	int cols = lattice.getCols();
+	for(int row = firstRow; row < lastRow; ++row)
+	{
+		std::default_random_engine &generator = m_rowGenerators[row];
+		for(int col = 0; col < cols; ++col)
+		{
+			int site = col + row * cols;
+			SpinLattice2D::Spin spin = lattice.spin(row, col);
+
+			// The neighbours one past the last row or column are read from the ghost copies of the opposite edge.
+			std::uint8_t bonds = 0;
+			if(lattice.spin(row, col+1) == spin && static_cast<std::uint64_t>(generator() - generator.min()) < m_bondThreshold)
+			{
+				bonds |= rightBond;
+			}
+			if(lattice.spin(row+1, col) == spin && static_cast<std::uint64_t>(generator() - generator.min()) < m_bondThreshold)
+			{
+				bonds |= belowBond;
+			}
+
+			m_bonds[site] = bonds;
+			m_flipRoots[site] = (generator() - generator.min()) & 1;
+			m_parents[site].store(site, std::memory_order_relaxed);
+		}
+	}
+}
+
+void SwendsenWangDynamics::labelClusters(const SpinLattice2D &lattice, int firstRow, int lastRow)
+{
+	int rows = lattice.getRows();
+	int cols = lattice.getCols();
+	for(int row = firstRow; row < lastRow; ++row)
+	{
+		// The neighbours wrap around the edges without a modulo.
+		int belowRow = (row == rows - 1) ? 0 : row + 1;
+		for(int col = 0; col < cols; ++col)
+		{
+			int site = col + row * cols;
+			if(m_bonds[site] & rightBond)
+			{
+				unite(site, ((col == cols - 1) ? 0 : col + 1) + row * cols);
+			}
+			if(m_bonds[site] & belowBond)
+			{
+				unite(site, col + belowRow * cols);
+			}
+		}
+	}
+}
+
+long long SwendsenWangDynamics::flipClusters(SpinLattice2D &lattice, int firstRow, int lastRow, int &magnetisationChange)
+{
+	int cols = lattice.getCols();
+	long long flipped = 0;
+	int rowsMagnetisationChange = 0;
+
+	// Flip sites whose cluster is flipped and reuse the bond array to remember which ones were flipped.
+	for(int row = firstRow; row < lastRow; ++row)
+	{
+		for(int col = 0; col < cols; ++col)
+		{
+			int site = col + row * cols;
+			m_bonds[site] = m_flipRoots[find(site)];
+			if(m_bonds[site])
+			{
+				rowsMagnetisationChange -= 2 * SpinLattice2D::spinValues[lattice.spin(row, col)];
+				lattice.flipUntracked(row, col);
+				++flipped;
+			}
+		}
+	}
+
+	magnetisationChange += rowsMagnetisationChange;
+	return flipped;
+}
+
+long long SwendsenWangDynamics::update(SpinLattice2D &lattice)
+{
+	int rows = lattice.getRows();
+	int cols = lattice.getCols();
+
+	forEachRowBlock(rows, m_threadCount, [&](int, int firstRow, int lastRow)
+	{
+		activateBonds(lattice, firstRow, lastRow);
+	});
+
+	forEachRowBlock(rows, m_threadCount, [&](int, int firstRow, int lastRow)
+	{
+		labelClusters(lattice, firstRow, lastRow);
+	});
+
+	std::vector<long long> threadFlipped(m_threadCount, 0);
+	std::vector<int> threadEnergyChange(m_threadCount, 0);
+	std::vector<int> threadMagnetisationChange(m_threadCount, 0);
+	forEachRowBlock(rows, m_threadCount, [&](int thread, int firstRow, int lastRow)
+	{
+		threadFlipped[thread] = flipClusters(lattice, firstRow, lastRow, threadMagnetisationChange[thread]);
+	});
+
+	// Only bonds between a flipped and an unflipped site change sign. Once all flips are done the product of the
+	// new spins across such a bond is minus the old one, which is the bond's energy change in units of 2J.
+	forEachRowBlock(rows, m_threadCount, [&](int thread, int firstRow, int lastRow)
+	{
+		int rowsEnergyChange = 0;
+		for(int row = firstRow; row < lastRow; ++row)
+		{
+			// flipUntracked has kept the ghost sites up to date, so the neighbours are read without a modulo.
+			int belowRow = (row == rows - 1) ? 0 : row + 1;
+			for(int col = 0; col < cols; ++col)
+			{
+				int site = col + row * cols;
+				int spin = SpinLattice2D::spinValues[lattice.spin(row, col)];
+				if(m_bonds[site] != m_bonds[((col == cols - 1) ? 0 : col + 1) + row * cols])
+				{
+					rowsEnergyChange -= spin * SpinLattice2D::spinValues[lattice.spin(row, col+1)];
+				}
+				if(m_bonds[site] != m_bonds[col + belowRow * cols])
+				{
+					rowsEnergyChange -= spin * SpinLattice2D::spinValues[lattice.spin(row+1, col)];
+				}
+			}
+		}
+		threadEnergyChange[thread] += rowsEnergyChange;
+	});
+
+	long long flipped = 0;
+	for(int thread = 0; thread < m_threadCount; ++thread)
+	{
+		flipped += threadFlipped[thread];
+		lattice.updateTotals(threadEnergyChange[thread], threadMagnetisationChange[thread]);
+	}
+	return flipped;
+}
+
+void SwendsenWangDynamics::save(std::ostream &out) const
+{
+	writeValue(out, static_cast<std::uint64_t>(m_rowGenerators.size()));
+	for(const auto& generator : m_rowGenerators)
+	{
+		writeEngine(out, generator);
+	}
+}
+
+void SwendsenWangDynamics::load(std::istream &in)
+{
+	// The number of rows must match, anything else means the stream is from another lattice.
+	if(readValue<std::uint64_t>(in) != m_rowGenerators.size())
+	{
+		in.setstate(std::ios::failbit);
+		return;
+	}
+	for(auto& generator : m_rowGenerators)
+	{
+		readEngine(in, generator);
+	}
+}
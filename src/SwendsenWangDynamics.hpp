@@ -0,0 +1,143 @@
+#ifndef SwendsenWangDynamics_hpp
+#define SwendsenWangDynamics_hpp
+#include <iostream>
+#include <random>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include "SpinLattice2D.hpp"
+
+/**
+ *\file
+ *\class SwendsenWangDynamics
+ *\brief Performs multithreaded Swendsen-Wang cluster updates of a SpinLattice2D.
+ *
+ * Each update activates every bond between aligned nearest neighbours with probability 1 - exp(-2J/(k_B T)),
+ * labels the clusters connected by active bonds and flips each cluster with probability 1/2. All three
+ * steps run in parallel over contiguous blocks of rows:
+ *
+ * - Bonds to the right of and below each site, and a random flip decision for each site, are drawn from a
+ *   random number engine belonging to the site's row.
+ * - Clusters are labelled with a lock-free union-find. Roots are linked with compare-and-swap, always the
+ *   larger index below the smaller, so bonds that cross between threads' blocks are merged safely and every
+ *   cluster ends up with its smallest site index as its root regardless of the order of the unions.
+ * - Every site looks up its root and is flipped if its root's flip decision is set.
+ *
+ * Since the random numbers belong to rows and the cluster roots don't depend on scheduling, the results for
+ * a given seed are identical for any number of threads. Only ferromagnetic couplings (J > 0) are supported.
+ */
+class SwendsenWangDynamics
+{
+private:
+	/**
+	 *\brief Member variable holding one random number engine per lattice row.
+	 */
+	std::vector<std::default_random_engine> m_rowGenerators;
+
+	/**
+	 *\brief Member variable holding the union-find parent of every site.
+	 */
+	std::vector<std::atomic<int> > m_parents;
+
+	/**
+	 *\brief Member variable holding the active bonds of every site, bit 0 for right and bit 1 for below.
+	 */
+	std::vector<std::uint8_t> m_bonds;
+
+	/**
+	 *\brief Member variable holding the flip decision of the cluster rooted at each site.
+	 */
+	std::vector<std::uint8_t> m_flipRoots;
+
+	/**
+	 *\brief Member variable holding the threshold on raw engine output below which a bond is active.
+	 */
+	std::uint64_t m_bondThreshold;
+
+	/**
+	 *\brief Member variable integer to represent the number of threads used.
+	 */
+	int m_threadCount;
+
+	/**
+	 *\brief Finds the root of the cluster containing a site, halving the path on the way.
+	 *\param site 1D index of the site.
+	 *\return 1D index of the root.
+	 */
+	int find(int site);
+
+	/**
+	 *\brief Merges the clusters containing two sites.
+	 *\param site1 1D index of the first site.
+	 *\param site2 1D index of the second site.
+	 */
+	void unite(int site1, int site2);
+
+	/**
+	 *\brief Draws the bonds and flip decisions for a block of rows and resets their union-find parents.
+	 *\param lattice the SpinLattice2D being updated.
+	 *\param firstRow first row of the block.
+	 *\param lastRow one past the last row of the block.
+	 */
+	void activateBonds(const SpinLattice2D &lattice, int firstRow, int lastRow);
+
+	/**
+	 *\brief Merges the clusters joined by the active bonds of a block of rows.
+	 *\param lattice the SpinLattice2D being updated.
+	 *\param firstRow first row of the block.
+	 *\param lastRow one past the last row of the block.
+	 */
+	void labelClusters(const SpinLattice2D &lattice, int firstRow, int lastRow);
+
+	/**
+	 *\brief Flips the sites of a block of rows whose clusters are flipped.
+	 *\param lattice the SpinLattice2D being updated.
+	 *\param firstRow first row of the block.
+	 *\param lastRow one past the last row of the block.
+	 *\param magnetisationChange integer reference that the magnetisation change of the flips is added to.
+	 *\return number of flipped sites.
+	 *
+	 * The energy change can only be counted once every block has been flipped, so update does that afterwards.
+	 */
+	long long flipClusters(SpinLattice2D &lattice, int firstRow, int lastRow, int &magnetisationChange);
+
+public:
+	/**
+	 *\brief Creates Swendsen-Wang dynamics for a lattice at a given temperature.
+	 *\param lattice the SpinLattice2D that will be updated, used to size the cluster labels.
+	 *\param jConstant floating point value representing the J constant.
+	 *\param boltzmannConstant floating point value representing the Boltzmann constant.
+	 *\param temperature floating point value representing the temperature of the system.
+	 *\param seed seed from which every row's random number engine is seeded.
+	 *\param threads integer representing the number of threads to use.
+	 */
+	SwendsenWangDynamics(const SpinLattice2D &lattice,
+						 double jConstant,
+						 double boltzmannConstant,
+						 double temperature,
+						 unsigned int seed,
+						 int threads);
+
+	/**
+	 *\brief Performs one Swendsen-Wang update of the whole lattice.
+	 *\param lattice the SpinLattice2D to update.
+	 *\return number of flipped sites.
+	 */
+	long long update(SpinLattice2D &lattice);
+
+	/**
+	 *\brief Writes the state of every row's random number engine to a binary stream so it can be restored with load.
+	 *\param out the stream to write to.
+	 */
+	void save(std::ostream &out) const;
+
+	/**
+	 *\brief Restores the state of every row's random number engine written by save.
+	 *
+	 * Failures are left in the state of the stream.
+	 *
+	 *\param in the stream to read from.
+	 */
+	void load(std::istream &in);
+};
+#endif /* SwendsenWangDynamics_hpp */
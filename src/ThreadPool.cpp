@@ -0,0 +1,131 @@
+#include "ThreadPool.hpp"
+#include <algorithm>
+
+namespace
+{
+	// The pool and worker index of the calling thread, so tasks submitted from a task go to its own queue.
+	thread_local const ThreadPool *currentPool = nullptr;
+	thread_local int currentWorker = -1;
+}
+
+ThreadPool::ThreadPool(int threads) : m_queued{0}, m_unfinished{0}, m_nextQueue{0}, m_stopping{false}
+{
+	threads = std::max(1, threads);
+	m_queues.reserve(threads);
+	for(int thread = 0; thread < threads; ++thread)
+	{
+		m_queues.emplace_back(new WorkerQueue);
+	}
+
+	m_workers.reserve(threads);
+	for(int thread = 0; thread < threads; ++thread)
+	{
+		m_workers.emplace_back(&ThreadPool::work, this, thread);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	wait();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_taskAvailable.notify_all();
+
+	for(auto& worker : m_workers)
+	{
+		worker.join();
+	}
+}
+
+bool ThreadPool::takeTask(int worker, std::function<void()> &task)
+{
+	int queueCount = static_cast<int>(m_queues.size());
+
+	// Start with the worker's own queue then try to steal from the others in turn.
+	for(int offset = 0; offset < queueCount; ++offset)
+	{
+		WorkerQueue &queue = *m_queues[(worker + offset) % queueCount];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if(!queue.tasks.empty())
+		{
+			task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+			return true;
+		}
+	}
+	return false;
+}
+
+void ThreadPool::work(int worker)
+{
+	currentPool = this;
+	currentWorker = worker;
+
+	while(true)
+	{
+		std::function<void()> task;
+		if(!takeTask(worker, task))
+		{
+			// Sleep until there is a task that hasn't been taken, it may not be in a queue quite yet.
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_taskAvailable.wait(lock, [this]() { return m_stopping || m_queued > 0; });
+			if(m_stopping && m_queued == 0)
+			{
+				return;
+			}
+			continue;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			--m_queued;
+		}
+
+		task();
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if(--m_unfinished == 0)
+		{
+			m_allDone.notify_all();
+		}
+	}
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+	// Count the task before it is queued so it can never finish before it has been counted.
+	int queue;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		++m_queued;
+		++m_unfinished;
+		if(currentPool == this)
+		{
+			queue = currentWorker;
+		}
+		else
+		{
+			queue = m_nextQueue;
+			m_nextQueue = (m_nextQueue + 1) % static_cast<int>(m_queues.size());
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_queues[queue]->mutex);
+		m_queues[queue]->tasks.push_back(std::move(task));
+	}
+	m_taskAvailable.notify_one();
+}
+
+void ThreadPool::wait()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_allDone.wait(lock, [this]() { return m_unfinished == 0; });
+}
+
+int ThreadPool::getThreads() const
+{
+	return static_cast<int>(m_workers.size());
+}
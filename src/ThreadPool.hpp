@@ -0,0 +1,126 @@
+#ifndef ThreadPool_hpp
+#define ThreadPool_hpp
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+#include <vector>
+#include <memory>
+
+/**
+ *\file
+ *\class ThreadPool
+ *\brief Fixed set of worker threads that run submitted tasks with work stealing.
+ *
+ * Workers are started once when the pool is created so repeatedly running short batches of work doesn't pay
+ * for creating threads each time. Every worker has its own queue of tasks. Tasks submitted from outside the
+ * pool are dealt to the queues in turn and tasks submitted by a running task go to its own worker's queue.
+ * A worker runs the tasks of its own queue in the order they were submitted and once that is empty steals the
+ * oldest task from another worker's queue, so no worker sits idle while there is work left and submitting the
+ * most expensive tasks first means they are started first.
+ */
+class ThreadPool
+{
+private:
+	/**
+	 *\brief Queue of tasks belonging to one worker, guarded by its own mutex so workers rarely contend.
+	 */
+	struct WorkerQueue
+	{
+		std::mutex mutex;
+		std::deque<std::function<void()> > tasks;
+	};
+
+	/**
+	 *\brief Member variable holding the worker threads.
+	 */
+	std::vector<std::thread> m_workers;
+
+	/**
+	 *\brief Member variable holding the queue of each worker.
+	 */
+	std::vector<std::unique_ptr<WorkerQueue> > m_queues;
+
+	/**
+	 *\brief Member variable guarding the counters.
+	 */
+	std::mutex m_mutex;
+
+	/**
+	 *\brief Signalled when a task is submitted or the pool is stopping.
+	 */
+	std::condition_variable m_taskAvailable;
+
+	/**
+	 *\brief Signalled when the last unfinished task finishes.
+	 */
+	std::condition_variable m_allDone;
+
+	/**
+	 *\brief Member variable integer counting tasks submitted but not yet taken by a worker.
+	 */
+	int m_queued;
+
+	/**
+	 *\brief Member variable integer counting tasks submitted but not yet finished.
+	 */
+	int m_unfinished;
+
+	/**
+	 *\brief Member variable integer holding the queue the next task from outside the pool is dealt to.
+	 */
+	int m_nextQueue;
+
+	/**
+	 *\brief Member variable set when the pool is being destroyed.
+	 */
+	bool m_stopping;
+
+	/**
+	 *\brief Takes the next task for a worker, from its own queue if possible otherwise from another's.
+	 *\param worker index of the worker.
+	 *\param task function that is set to the task taken.
+	 *\return true if a task was taken.
+	 */
+	bool takeTask(int worker, std::function<void()> &task);
+
+	/**
+	 *\brief Loop run by each worker thread.
+	 *\param worker index of the worker.
+	 */
+	void work(int worker);
+
+public:
+	/**
+	 *\brief Starts a pool of worker threads.
+	 *\param threads integer representing the number of worker threads, at least one is always started.
+	 */
+	explicit ThreadPool(int threads);
+
+	/**
+	 *\brief Stops the pool once all submitted tasks have finished.
+	 */
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/**
+	 *\brief Adds a task to be run by one of the workers.
+	 *\param task function to run.
+	 */
+	void submit(std::function<void()> task);
+
+	/**
+	 *\brief Blocks until every submitted task has finished.
+	 */
+	void wait();
+
+	/**
+	 *\brief Getter method for the number of worker threads.
+	 *\return integer value representing the number of worker threads.
+	 */
+	int getThreads() const;
+};
+#endif /* ThreadPool_hpp */
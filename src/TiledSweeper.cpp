@@ -0,0 +1,104 @@
+#include "TiledSweeper.hpp"
+#include <algorithm>
+
+namespace
+{
+	/**
+	 *\brief Visits every site of a lattice once in the tiled checkerboard order.
+	 *\param rows number of rows of the lattice.
+	 *\param cols number of columns of the lattice.
+	 *\param tileSize number of rows and columns of each tile.
+	 *\param visit callable taking the row and column of each site.
+	 */
+	template<class Visit>
+	void visitTiled(int rows, int cols, int tileSize, Visit visit)
+	{
+		for(int tileRow = 0; tileRow < rows; tileRow += tileSize)
+		{
+			int lastRow = std::min(tileRow + tileSize, rows);
+			for(int tileCol = 0; tileCol < cols; tileCol += tileSize)
+			{
+				int lastCol = std::min(tileCol + tileSize, cols);
+				for(int parity = 0; parity < 2; ++parity)
+				{
+					for(int row = tileRow; row < lastRow; ++row)
+					{
+						// First site of this sublattice in the tile's part of the row.
+						for(int col = tileCol + ((row + tileCol + parity) % 2); col < lastCol; col += 2)
+						{
+							visit(row, col);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+constexpr int TiledSweeper::defaultTileSize;
+
+TiledSweeper::TiledSweeper(int tileSize) : m_tileSize{std::max(1, tileSize)}
+{
+}
+
+template<class Engine>
+long long TiledSweeper::glauberSweep(SpinLattice2D &lattice, Engine &generator, const BoltzmannTable &boltzmannTable) const
+{
+	long long accepted = 0;
+	visitTiled(lattice.getRows(), lattice.getCols(), m_tileSize, [&](int row, int col)
+	{
+		if(boltzmannTable.accept(lattice.flipEnergyChange(row, col), generator))
+		{
+			lattice.flip(row, col);
+			++accepted;
+		}
+	});
+	return accepted;
+}
+
+template<class Engine>
+long long TiledSweeper::kawasakiSweep(SpinLattice2D &lattice, Engine &generator, const BoltzmannTable &boltzmannTable) const
+{
+	int rows = lattice.getRows();
+	int cols = lattice.getCols();
+	long long accepted = 0;
+
+	// Swaps the spins of a site and its right or lower neighbour if they are opposite and the swap is accepted.
+	auto proposeSwap = [&](int row1, int col1, int row2, int col2)
+	{
+		if(lattice.spin(row1, col1) == lattice.spin(row2, col2))
+		{
+			return;
+		}
+
+		// The shared bond is anti-aligned before and after, so it is taken out of each site's flip.
+		int energyChange = lattice.flipEnergyChange(row1, col1) + lattice.flipEnergyChange(row2, col2) + 2;
+		if(boltzmannTable.accept(energyChange, generator))
+		{
+			// Flipping two opposite spins swaps them, the second flip sees the first so the totals stay exact.
+			lattice.flip(row1, col1);
+			lattice.flip(row2, col2);
+			++accepted;
+		}
+	};
+
+	visitTiled(rows, cols, m_tileSize, [&](int row, int col)
+	{
+		proposeSwap(row, col, row, (col + 1 == cols) ? 0 : col + 1);
+		proposeSwap(row, col, (row + 1 == rows) ? 0 : row + 1, col);
+	});
+	return accepted;
+}
+
+int TiledSweeper::getTileSize() const
+{
+	return m_tileSize;
+}
+
+// Instantiated for every engine that can be chosen with --rng.
+template long long TiledSweeper::glauberSweep(SpinLattice2D&, std::default_random_engine&, const BoltzmannTable&) const;
+template long long TiledSweeper::glauberSweep(SpinLattice2D&, Xoshiro256StarStar&, const BoltzmannTable&) const;
+template long long TiledSweeper::glauberSweep(SpinLattice2D&, Philox4x32&, const BoltzmannTable&) const;
+template long long TiledSweeper::kawasakiSweep(SpinLattice2D&, std::default_random_engine&, const BoltzmannTable&) const;
+template long long TiledSweeper::kawasakiSweep(SpinLattice2D&, Xoshiro256StarStar&, const BoltzmannTable&) const;
+template long long TiledSweeper::kawasakiSweep(SpinLattice2D&, Philox4x32&, const BoltzmannTable&) const;
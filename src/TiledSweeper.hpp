@@ -0,0 +1,81 @@
+#ifndef TiledSweeper_hpp
+#define TiledSweeper_hpp
+#include <random>
+#include "SpinLattice2D.hpp"
+#include "BoltzmannTable.hpp"
+#include "randomEngines.hpp"
+
+/**
+ *\file
+ *\class TiledSweeper
+ *\brief Sweeps a SpinLattice2D in a fixed cache-tiled checkerboard order with Glauber or nearest neighbour Kawasaki moves.
+ *
+ * The lattice is split into square tiles which are visited row of tiles by row of tiles. Within a tile every
+ * site of one checkerboard sublattice is visited before those of the other, so the second half of a tile
+ * finds the first half, and the neighbouring rows, still in the cache. A tile of t sites each way touches
+ * about (t + 2)^2 bytes of the lattice, so the tile size should be chosen so that this fits the cache level
+ * being targeted, e.g. 64 (about 4 KiB) for L1 or 256 (about 66 KiB) for L2. A tile size as large as the
+ * lattice gives an ordinary sequential checkerboard sweep. No two sites of one sublattice of a tile are
+ * neighbours, so their updates don't depend on the order they are made in.
+ *
+ * Every move is a Metropolis update with a fixed proposal, which satisfies detailed balance on its own, so
+ * each leaves the Boltzmann distribution unchanged and so does a sweep made of them in any fixed order. The
+ * sweep as a whole satisfies balance rather than detailed balance, which is all that is needed. Odd lattice
+ * sizes are allowed, the two sublattices then meet at the periodic boundary but every site is still visited
+ * once per sweep.
+ *
+ * - Glauber sweeps propose a flip of every site once.
+ * - Kawasaki sweeps propose to swap the spins across every nearest neighbour bond once, the bonds to the right
+ *   of and below each site being proposed when the site is visited. A sweep therefore makes two proposals per
+ *   site, those across aligned bonds do nothing. It needs at least three rows and columns so no two sites are
+ *   neighbours twice.
+ *
+ * The order is fixed so there is no state to checkpoint beyond that of the engine. The sweeps are instantiated
+ * for std::default_random_engine, Xoshiro256StarStar and Philox4x32.
+ */
+class TiledSweeper
+{
+public:
+	/// Tile size used unless another is chosen, a tile then fits in the L1 cache of any current processor.
+	static constexpr int defaultTileSize = 64;
+
+private:
+	/**
+	 *\brief Member variable integer holding the number of rows and columns of a tile.
+	 */
+	int m_tileSize;
+
+public:
+	/**
+	 *\brief Creates a sweeper with a given tile size.
+	 *\param tileSize integer representing the number of rows and columns of each tile, at least 1.
+	 */
+	explicit TiledSweeper(int tileSize);
+
+	/**
+	 *\brief Proposes a flip of every site once, in the tiled order.
+	 *\param lattice the SpinLattice2D to sweep.
+	 *\param generator reference to random engine used in the acceptance tests.
+	 *\param boltzmannTable a BoltzmannTable reference holding the acceptance thresholds for the temperature of the system.
+	 *\return number of accepted flips.
+	 */
+	template<class Engine>
+	long long glauberSweep(SpinLattice2D &lattice, Engine &generator, const BoltzmannTable &boltzmannTable) const;
+
+	/**
+	 *\brief Proposes a swap across every nearest neighbour bond once, in the tiled order.
+	 *\param lattice the SpinLattice2D to sweep, with at least three rows and columns.
+	 *\param generator reference to random engine used in the acceptance tests.
+	 *\param boltzmannTable a BoltzmannTable reference holding the acceptance thresholds for the temperature of the system.
+	 *\return number of accepted swaps.
+	 */
+	template<class Engine>
+	long long kawasakiSweep(SpinLattice2D &lattice, Engine &generator, const BoltzmannTable &boltzmannTable) const;
+
+	/**
+	 *\brief Getter method for the tile size.
+	 *\return integer value representing the number of rows and columns of each tile.
+	 */
+	int getTileSize() const;
+};
+#endif /* TiledSweeper_hpp */
@@ -0,0 +1,67 @@
+#include "WolffDynamics.hpp"
+#include <cmath>
+
+WolffDynamics::WolffDynamics(const SpinLattice2D &lattice, double jConstant, double boltzmannConstant, double temperature)
+{
+	// A cluster can contain every site so this is the most the stack can ever hold.
+	m_stack.reserve(lattice.getSize());
+
+	double range = static_cast<double>(std::default_random_engine::max() - std::default_random_engine::min()) + 1.0;
+	double addProbability = 1.0 - std::exp(-2.0 * jConstant / (boltzmannConstant * temperature));
+	m_addThreshold = static_cast<std::uint64_t>(std::llround(addProbability * range));
+	m_fullRangeAddThreshold = static_cast<std::uint64_t>(std::ldexp(addProbability, 64));
+}
+
+template<class Engine>
+int WolffDynamics::update(SpinLattice2D &lattice, Engine &generator)
+{
+	int rows = lattice.getRows();
+	int cols = lattice.getCols();
+
+	// Pick the seed of the cluster.
+	int seed = randomIndex(generator, lattice.getSize());
+
+	// The add probability is below 1 so neither threshold overflows.
+	std::uint64_t addThreshold = hasFullRange64<Engine>() ? m_fullRangeAddThreshold : m_addThreshold;
+
+	// Every site added to the cluster had this spin before it was flipped.
+	SpinLattice2D::Spin clusterSpin = lattice(seed / cols, seed % cols);
+
+	lattice.flip(seed / cols, seed % cols);
+	m_stack.push_back(seed);
+	int clusterSize = 1;
+
+	while(!m_stack.empty())
+	{
+		int site = m_stack.back();
+		m_stack.pop_back();
+		int row = site / cols;
+		int col = site % cols;
+
+		// The neighbours wrap around the edges without a modulo.
+		int neighbourRows[4] = {(row == rows - 1) ? 0 : row + 1, (row == 0) ? rows - 1 : row - 1, row, row};
+		int neighbourCols[4] = {col, col, (col == cols - 1) ? 0 : col + 1, (col == 0) ? cols - 1 : col - 1};
+
+		for(int neighbour = 0; neighbour < 4; ++neighbour)
+		{
+			int neighbourRow = neighbourRows[neighbour];
+			int neighbourCol = neighbourCols[neighbour];
+
+			// Only sites that are still aligned with the unflipped cluster can join it.
+			if(lattice.spin(neighbourRow, neighbourCol) == clusterSpin
+			   && static_cast<std::uint64_t>(generator() - generator.min()) < addThreshold)
+			{
+				lattice.flip(neighbourRow, neighbourCol);
+				m_stack.push_back(neighbourCol + neighbourRow * cols);
+				++clusterSize;
+			}
+		}
+	}
+
+	return clusterSize;
+}
+
+// Instantiated for every engine that can be chosen with --rng.
+template int WolffDynamics::update(SpinLattice2D&, std::default_random_engine&);
+template int WolffDynamics::update(SpinLattice2D&, Xoshiro256StarStar&);
+template int WolffDynamics::update(SpinLattice2D&, Philox4x32&);
@@ -0,0 +1,63 @@
+#ifndef WolffDynamics_hpp
+#define WolffDynamics_hpp
+#include <random>
+#include <vector>
+#include <cstdint>
+#include "SpinLattice2D.hpp"
+#include "randomEngines.hpp"
+
+/**
+ *\file
+ *\class WolffDynamics
+ *\brief Performs Wolff single-cluster updates of a SpinLattice2D.
+ *
+ * A Wolff update picks a random seed site and grows a cluster from it, adding each aligned nearest neighbour
+ * of a cluster site with probability 1 - exp(-2J/(k_B T)), then flips the whole cluster. The update is always
+ * accepted and decorrelates the lattice much faster than single spin flips near the critical point. Sites are
+ * flipped as they are added to the cluster, so they can't be added twice and no visited marks are needed. The
+ * stack of sites waiting to have their neighbours checked is allocated once for the whole lattice so growing a
+ * cluster never allocates. Only ferromagnetic couplings (J > 0) are supported.
+ *
+ * Cluster sizes give the improved estimator of the susceptibility <M^2> / (N k_B T) = <|C|> / (k_B T) since
+ * <M^2> = N <|C|> for Wolff clusters. Unlike the usual estimator this does not subtract <|M|>^2 so it only
+ * agrees with it above the critical temperature.
+ */
+class WolffDynamics
+{
+private:
+	/**
+	 *\brief Member variable holding the 1D indices of cluster sites whose neighbours are still to be checked.
+	 */
+	std::vector<int> m_stack;
+
+	/**
+	 *\brief Member variable holding the threshold on raw engine output below which a neighbour is added.
+	 */
+	std::uint64_t m_addThreshold;
+
+	/**
+	 *\brief Member variable holding the threshold for engines whose output covers [0, 2^64).
+	 */
+	std::uint64_t m_fullRangeAddThreshold;
+
+public:
+	/**
+	 *\brief Creates Wolff dynamics for a lattice at a given temperature.
+	 *\param lattice the SpinLattice2D that will be updated, used to size the cluster stack.
+	 *\param jConstant floating point value representing the J constant.
+	 *\param boltzmannConstant floating point value representing the Boltzmann constant.
+	 *\param temperature floating point value representing the temperature of the system.
+	 */
+	WolffDynamics(const SpinLattice2D &lattice, double jConstant, double boltzmannConstant, double temperature);
+
+	/**
+	 *\brief Grows and flips a single cluster.
+	 *\param lattice the SpinLattice2D to update.
+	 *\param generator reference to random engine used for choosing the seed and adding neighbours,
+	 * std::default_random_engine, Xoshiro256StarStar or Philox4x32.
+	 *\return integer value representing the number of sites in the flipped cluster.
+	 */
+	template<class Engine>
+	int update(SpinLattice2D &lattice, Engine &generator);
+};
+#endif /* WolffDynamics_hpp */
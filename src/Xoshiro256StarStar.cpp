@@ -0,0 +1,93 @@
+#include "Xoshiro256StarStar.hpp"
+
+Xoshiro256StarStar::Xoshiro256StarStar(result_type seed)
+{
+	// splitmix64 turns any seed, even 0, into a well mixed state that isn't all zero.
+	for(auto& word : m_state)
+	{
+		result_type z = (seed += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		word = z ^ (z >> 31);
+	}
+}
+
+Xoshiro256StarStar::Xoshiro256StarStar(std::seed_seq &sequence)
+{
+	std::uint32_t words[8];
+	sequence.generate(words, words + 8);
+	for(int i = 0; i < 4; ++i)
+	{
+		m_state[i] = (static_cast<result_type>(words[2*i]) << 32) | words[2*i+1];
+	}
+
+	// The all zero state is the one state the engine can't leave.
+	if(!(m_state[0] | m_state[1] | m_state[2] | m_state[3]))
+	{
+		m_state[0] = 1;
+	}
+}
+
+void Xoshiro256StarStar::generate(result_type *first, result_type *last)
+{
+	for(; first != last; ++first)
+	{
+		*first = (*this)();
+	}
+}
+
+void Xoshiro256StarStar::discard(unsigned long long steps)
+{
+	for(; steps > 0; --steps)
+	{
+		(*this)();
+	}
+}
+
+void Xoshiro256StarStar::jump()
+{
+	static const result_type jumpPolynomial[] = {0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL};
+
+	result_type jumped[4] = {0, 0, 0, 0};
+	for(const auto& word : jumpPolynomial)
+	{
+		for(int bit = 0; bit < 64; ++bit)
+		{
+			if(word & (result_type(1) << bit))
+			{
+				for(int i = 0; i < 4; ++i)
+				{
+					jumped[i] ^= m_state[i];
+				}
+			}
+			(*this)();
+		}
+	}
+
+	for(int i = 0; i < 4; ++i)
+	{
+		m_state[i] = jumped[i];
+	}
+}
+
+std::ostream& operator<<(std::ostream &out, const Xoshiro256StarStar &engine)
+{
+	return out << engine.m_state[0] << ' ' << engine.m_state[1] << ' ' << engine.m_state[2] << ' ' << engine.m_state[3];
+}
+
+std::istream& operator>>(std::istream &in, Xoshiro256StarStar &engine)
+{
+	return in >> engine.m_state[0] >> engine.m_state[1] >> engine.m_state[2] >> engine.m_state[3];
+}
+
+bool operator==(const Xoshiro256StarStar &left, const Xoshiro256StarStar &right)
+{
+	for(int i = 0; i < 4; ++i)
+	{
+		if(left.m_state[i] != right.m_state[i])
+		{
+			return false;
+		}
+	}
+	return true;
+}
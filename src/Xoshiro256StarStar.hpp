@@ -0,0 +1,117 @@
+#ifndef Xoshiro256StarStar_hpp
+#define Xoshiro256StarStar_hpp
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+
+/**
+ *\file
+ *\class Xoshiro256StarStar
+ *\brief The xoshiro256** random number engine of Blackman and Vigna.
+ *
+ * A small and very fast generator of 64 bit numbers with a period of 2^256 - 1 which passes all the usual
+ * statistical tests, unlike the minimal standard generator behind std::default_random_engine. It meets the
+ * requirements of a random number engine so it can be used with the distributions of <random>. Independent
+ * streams for threads or replicas are made by jumping, each jump skips 2^128 numbers so streams made by
+ * repeatedly jumping one engine can never overlap.
+ */
+class Xoshiro256StarStar
+{
+public:
+	/// Type of the numbers generated.
+	using result_type = std::uint64_t;
+
+private:
+	/**
+	 *\brief Member variable holding the 256 bit state.
+	 */
+	result_type m_state[4];
+
+public:
+	/**
+	 *\brief Creates an engine from a single seed, which is expanded into the state with splitmix64.
+	 *\param seed the seed.
+	 */
+	explicit Xoshiro256StarStar(result_type seed = 1);
+
+	/**
+	 *\brief Creates an engine with its state generated by a seed sequence.
+	 *\param sequence seed sequence reference that generates the state.
+	 */
+	explicit Xoshiro256StarStar(std::seed_seq &sequence);
+
+	/**
+	 *\brief Smallest number generated.
+	 *\return 0.
+	 */
+	static constexpr result_type min() { return 0; }
+
+	/**
+	 *\brief Largest number generated.
+	 *\return 2^64 - 1.
+	 */
+	static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+	/**
+	 *\brief Generates the next number.
+	 *\return uniformly distributed 64 bit number.
+	 */
+	result_type operator()();
+
+	/**
+	 *\brief Fills a range with numbers, the same numbers as calling operator() for each element.
+	 *\param first pointer to the first element.
+	 *\param last pointer to one past the last element.
+	 */
+	void generate(result_type *first, result_type *last);
+
+	/**
+	 *\brief Advances the engine by a number of steps.
+	 *\param steps number of numbers to skip.
+	 */
+	void discard(unsigned long long steps);
+
+	/**
+	 *\brief Advances the engine by 2^128 steps in the time of 256 steps, used to make non-overlapping streams.
+	 */
+	void jump();
+
+	/**
+	 *\brief Writes the state of the engine as text.
+	 *\param out an output stream reference to write to.
+	 *\param engine the engine to write.
+	 *\return the stream so the operator can be chained.
+	 */
+	friend std::ostream& operator<<(std::ostream &out, const Xoshiro256StarStar &engine);
+
+	/**
+	 *\brief Reads the state of an engine written by operator<<.
+	 *\param in an input stream reference to read from.
+	 *\param engine the engine to restore.
+	 *\return the stream so the operator can be chained.
+	 */
+	friend std::istream& operator>>(std::istream &in, Xoshiro256StarStar &engine);
+
+	/**
+	 *\brief Engines are equal if they will generate the same numbers.
+	 */
+	friend bool operator==(const Xoshiro256StarStar &left, const Xoshiro256StarStar &right);
+};
+
+inline Xoshiro256StarStar::result_type Xoshiro256StarStar::operator()()
+{
+	result_type result = m_state[1] * 5;
+	result = ((result << 7) | (result >> 57)) * 9;
+
+	result_type shifted = m_state[1] << 17;
+	m_state[2] ^= m_state[0];
+	m_state[3] ^= m_state[1];
+	m_state[1] ^= m_state[2];
+	m_state[0] ^= m_state[3];
+	m_state[2] ^= shifted;
+	m_state[3] = (m_state[3] << 45) | (m_state[3] >> 19);
+
+	return result;
+}
+#endif /* Xoshiro256StarStar_hpp */
@@ -0,0 +1,124 @@
+#ifndef binaryIO_hpp
+#define binaryIO_hpp
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+/**
+ *\file
+ *\brief functions to write values to and read them from binary streams.
+ *
+ * Values are stored as their bytes in the byte order of the machine, so files are only portable between machines
+ * with the same byte order. Vectors and strings are preceded by their length. Failures are left in the state of the
+ * stream, so a whole record can be read and the stream checked once.
+ */
+
+/**
+ *\brief Writes the bytes of a trivially copyable value.
+ *\param out the stream to write to.
+ *\param value the value to write.
+ */
+template<class T>
+void writeValue(std::ostream &out, const T &value)
+{
+	out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/**
+ *\brief Reads the bytes of a trivially copyable value.
+ *\param in the stream to read from.
+ *\return the value read.
+ */
+template<class T>
+T readValue(std::istream &in)
+{
+	T value{};
+	in.read(reinterpret_cast<char*>(&value), sizeof(T));
+	return value;
+}
+
+/**
+ *\brief Writes a vector of trivially copyable values preceded by its length.
+ *\param out the stream to write to.
+ *\param values the vector to write.
+ */
+template<class T>
+void writeVector(std::ostream &out, const std::vector<T> &values)
+{
+	writeValue(out, static_cast<std::uint64_t>(values.size()));
+	out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+/**
+ *\brief Reads a vector written by writeVector.
+ *\param in the stream to read from.
+ *\param values the vector to fill, resized to the stored length.
+ */
+template<class T>
+void readVector(std::istream &in, std::vector<T> &values)
+{
+	std::uint64_t size = readValue<std::uint64_t>(in);
+	if(!in)
+	{
+		return;
+	}
+	values.resize(size);
+	in.read(reinterpret_cast<char*>(values.data()), size * sizeof(T));
+}
+
+/**
+ *\brief Writes a string preceded by its length.
+ *\param out the stream to write to.
+ *\param text the string to write.
+ */
+inline void writeString(std::ostream &out, const std::string &text)
+{
+	writeValue(out, static_cast<std::uint64_t>(text.size()));
+	out.write(text.data(), text.size());
+}
+
+/**
+ *\brief Reads a string written by writeString.
+ *\param in the stream to read from.
+ *\return the string read.
+ */
+inline std::string readString(std::istream &in)
+{
+	std::uint64_t size = readValue<std::uint64_t>(in);
+	std::string text(in ? size : 0, '\0');
+	in.read(&text[0], text.size());
+	return text;
+}
+
+/**
+ *\brief Writes the state of a random number engine, so it continues with the same numbers after being read.
+ *\param out the stream to write to.
+ *\param generator the engine to write.
+ */
+template<class Engine>
+inline void writeEngine(std::ostream &out, const Engine &generator)
+{
+	// The standard only guarantees the state round trips through its text form.
+	std::ostringstream state;
+	state << generator;
+	writeString(out, state.str());
+}
+
+/**
+ *\brief Reads the state of a random number engine written by writeEngine.
+ *\param in the stream to read from.
+ *\param generator the engine to restore.
+ */
+template<class Engine>
+inline void readEngine(std::istream &in, Engine &generator)
+{
+	std::istringstream state(readString(in));
+	state >> generator;
+	if(!state)
+	{
+		in.setstate(std::ios::failbit);
+	}
+}
+#endif /* binaryIO_hpp */
@@ -1,4 +1,7 @@
 #include "bootstrap.hpp"
+#include <vector>
+#include <thread>
+#include <algorithm>
 
 double bootstrap(const DataArray::IDataFunctor &fcn, const DataArray &data, std::default_random_engine &generator, int iterations)
 {
@@ -35,3 +38,72 @@ double bootstrap(const DataArray::IDataFunctor &fcn, const DataArray &data, std:
 	double error 	   = std::sqrt(meanSquared - mean * mean);
 	return error;
 }
+
+double bootstrap(const DataArray::IMomentFunctor &fcn,
+				 const DataArray &data,
+				 unsigned int seed,
+				 int iterations,
+				 int blockLength,
+				 int threads)
+{
+	int size = data.getSize();
+	blockLength = std::max(1, std::min(blockLength, size));
+	threads = std::max(1, std::min(threads, iterations));
+
+	// Prefix sums so the sum over any block of samples is a difference of two entries.
+	std::vector<double> sums(size + 1, 0.0);
+	std::vector<double> squareSums(size + 1, 0.0);
+	for(int i = 0; i < size; ++i)
+	{
+		sums[i+1] 	    = sums[i] + data[i];
+		squareSums[i+1] = squareSums[i] + data[i] * data[i];
+	}
+
+	std::vector<double> resampledFncValues(iterations);
+	auto resample = [&](int firstIteration, int lastIteration)
+	{
+		for(int iteration = firstIteration; iteration < lastIteration; ++iteration)
+		{
+			std::seed_seq sequence{seed, static_cast<unsigned int>(iteration)};
+			std::default_random_engine generator(sequence);
+			std::uniform_int_distribution<int> distribution(0, size - blockLength);
+
+			// The last block is cut short so every re-sampling holds exactly as many samples as the data.
+			double sum = 0;
+			double squareSum = 0;
+			for(int filled = 0; filled < size; filled += blockLength)
+			{
+				int length = std::min(blockLength, size - filled);
+				int start = distribution(generator);
+				sum 	  += sums[start + length] - sums[start];
+				squareSum += squareSums[start + length] - squareSums[start];
+			}
+			resampledFncValues[iteration] = fcn(sum / size, squareSum / size);
+		}
+	};
+
+	// Each thread gets a contiguous range of re-samplings and the calling thread does the first.
+	std::vector<std::thread> workers;
+	workers.reserve(threads-1);
+	for(int thread = 1; thread < threads; ++thread)
+	{
+		workers.emplace_back(resample, (iterations * thread) / threads, (iterations * (thread+1)) / threads);
+	}
+	resample(0, iterations / threads);
+	for(auto& worker : workers)
+	{
+		worker.join();
+	}
+
+	// Compute the error according to the bootstrap formula.
+	double mean = 0;
+	double meanSquared = 0;
+	for(const auto& value : resampledFncValues)
+	{
+		mean 		+= value;
+		meanSquared += value * value;
+	}
+	mean 		/= iterations;
+	meanSquared /= iterations;
+	return std::sqrt(std::max(0.0, meanSquared - mean * mean));
+}
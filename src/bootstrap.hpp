@@ -24,4 +24,27 @@ double bootstrap(const DataArray::IDataFunctor &fcn,
 				 std::default_random_engine &generator, 
 				 int iterations = 100);
 
+/**
+ *\brief Function to calculate the moving-block bootstrap error of a function of the first two moments of a DataArray.
+ *\param fcn a IMomentFunctor reference that acts on the mean and square mean of the data (this is the function).
+ *\param data a DataArray reference the function is a function of.
+ *\param seed seed from which the random number engine of every re-sampling is seeded.
+ *\param iterations integer value representing the number of re-samplings.
+ *\param blockLength integer length of the blocks of consecutive samples that are drawn, 1 for the ordinary bootstrap.
+ *\param threads integer number of threads the re-samplings are shared between.
+ *\return floating point value representing the bootstrap error.
+ *
+ * Each re-sampling draws blocks of consecutive samples starting at random positions until it holds as many samples
+ * as the data. Keeping the blocks together preserves the correlations within them, so if they are longer than the
+ * autocorrelation time the error is valid for correlated data. Nothing is copied, the sums of the re-sampled data
+ * and their squares are built from prefix sums of the data in O(1) per block. Every re-sampling has its own random
+ * number engine seeded from the seed and its index, so the error doesn't depend on the number of threads.
+ */
+double bootstrap(const DataArray::IMomentFunctor &fcn,
+				 const DataArray &data,
+				 unsigned int seed,
+				 int iterations,
+				 int blockLength,
+				 int threads);
+
 #endif /* bootstrap_hpp */
\ No newline at end of file
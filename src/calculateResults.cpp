@@ -0,0 +1,179 @@
+#include "calculateResults.hpp"
+#include "Susceptibility.hpp"
+#include "HeatCapacity.hpp"
+#include "jackKnife.hpp"
+#include "bootstrap.hpp"
+#include "BlockingAnalysis.hpp"
+#include <cmath>
+#include <thread>
+
+namespace
+{
+	/**
+	 *\brief Calculates the results from streaming statistics alone, the errors come from binned means.
+	 *
+	 * The bin size is chosen by a blocking analysis of the energy or magnetisation.
+	 *
+	 *\param data SimulationData reference holding the streaming statistics.
+	 *\param sites integer representing the number of sites in the lattice.
+	 *\param boltzmannConstant floating point value representing the Boltzmann constant.
+	 *\param temperature floating point value representing the temperature of the samples.
+	 *\return IsingResults instance, the improved susceptibility and Binder cumulant are NaN.
+	 */
+	IsingResults streamingResults(const SimulationData &data, int sites, double boltzmannConstant, double temperature)
+	{
+		const StreamingStatistics &energyStatistics = data.energyStatistics;
+		const StreamingStatistics &magnetisationStatistics = data.magnetisationStatistics;
+		BlockingAnalysis energyBlocking = energyStatistics.blockingAnalysis();
+		BlockingAnalysis magnetisationBlocking = magnetisationStatistics.blockingAnalysis();
+
+		// The errors of every quantity come from bins of the size at the start of the plateau.
+		int energyLevel = energyBlocking.getPlateauLevel();
+		int magnetisationLevel = magnetisationBlocking.getPlateauLevel();
+		double notAvailable = std::nan("");
+
+		Susceptibility susceptibilityFcn(boltzmannConstant, temperature);
+		HeatCapacity heatCapacityFcn(boltzmannConstant, temperature);
+
+		return IsingResults
+		{
+			energyStatistics.mean(),
+			energyBlocking.error(),
+			magnetisationStatistics.mean(),
+			magnetisationBlocking.error(),
+			magnetisationStatistics(susceptibilityFcn)/sites,
+			magnetisationLevel < 0 ? notAvailable : magnetisationStatistics.binnedError(susceptibilityFcn, magnetisationLevel)/sites,
+			energyStatistics(heatCapacityFcn)/sites,
+			energyLevel < 0 ? notAvailable : energyStatistics.binnedError(heatCapacityFcn, energyLevel)/sites,
+			notAvailable,
+			notAvailable,
+			notAvailable,
+			energyBlocking.error(),
+			energyBlocking.errorOfError(),
+			energyBlocking.converged(),
+			energyBlocking.effectiveSamples(),
+			magnetisationBlocking.error(),
+			magnetisationBlocking.errorOfError(),
+			magnetisationBlocking.converged(),
+			magnetisationBlocking.effectiveSamples()
+		};
+	}
+}
+
+IsingResults calculateResults(const DataArray &energyData,
+							  const DataArray &magnetisationData,
+							  int sites,
+							  double boltzmannConstant,
+							  double temperature,
+							  IsingInputParameters::ErrorTypes errorMethod,
+							  int jackKnifeBins,
+							  int bootstrapBlockLength,
+							  int threads,
+							  std::default_random_engine &generator)
+{
+	// Calculate any numerical values we need and their errors.
+	double energy 	   = energyData.mean();
+	double energyError = energyData.error();
+
+	double magnetisation 	  = magnetisationData.mean();
+	double magnetisationError = magnetisationData.error();
+
+	// Construct the susceptibility and heat capacity functors.
+	Susceptibility susceptibilityFcn(boltzmannConstant, temperature);
+	HeatCapacity heatCapacityFcn(boltzmannConstant, temperature);
+
+	double susceptibility = susceptibilityFcn(magnetisationData)/sites;
+	double heatCapacity   = heatCapacityFcn(energyData)/sites;
+	double errorSusceptibility = 0;
+	double errorHeatCapacity   = 0;
+	switch (errorMethod)
+	{
+		case IsingInputParameters::Bootstrap :
+		{
+			const int iterations = 100;
+			unsigned int magnetisationSeed = generator();
+			unsigned int energySeed 	   = generator();
+
+			// With more than one thread the magnetisation and energy are re-sampled at the same time, each with
+			// half of the threads.
+			if(threads > 1)
+			{
+				int magnetisationThreads = threads / 2;
+				std::thread magnetisationWorker([&]()
+				{
+					errorSusceptibility = bootstrap(susceptibilityFcn, magnetisationData, magnetisationSeed, iterations, bootstrapBlockLength, magnetisationThreads)/sites;
+				});
+				errorHeatCapacity = bootstrap(heatCapacityFcn, energyData, energySeed, iterations, bootstrapBlockLength, threads - magnetisationThreads)/sites;
+				magnetisationWorker.join();
+			}
+			else
+			{
+				errorSusceptibility = bootstrap(susceptibilityFcn, magnetisationData, magnetisationSeed, iterations, bootstrapBlockLength, 1)/sites;
+				errorHeatCapacity 	= bootstrap(heatCapacityFcn, energyData, energySeed, iterations, bootstrapBlockLength, 1)/sites;
+			}
+			break;
+		}
+
+		case IsingInputParameters::JackKnife :
+			errorSusceptibility = jackKnife(static_cast<const DataArray::IMomentFunctor&>(susceptibilityFcn), magnetisationData, jackKnifeBins)/sites;
+			errorHeatCapacity 	= jackKnife(static_cast<const DataArray::IMomentFunctor&>(heatCapacityFcn), energyData, jackKnifeBins)/sites;
+			break;
+	}
+
+	// Blocking errors of the energy and magnetisation which account for the autocorrelation of the samples.
+	BlockingAnalysis energyBlocking(energyData);
+	BlockingAnalysis magnetisationBlocking(magnetisationData);
+
+	return IsingResults
+	{
+		energy,
+		energyError,
+		magnetisation,
+		magnetisationError,
+		susceptibility,
+		errorSusceptibility,
+		heatCapacity,
+		errorHeatCapacity,
+		std::nan(""),
+		std::nan(""),
+		std::nan(""),
+		energyBlocking.error(),
+		energyBlocking.errorOfError(),
+		energyBlocking.converged(),
+		energyBlocking.effectiveSamples(),
+		magnetisationBlocking.error(),
+		magnetisationBlocking.errorOfError(),
+		magnetisationBlocking.converged(),
+		magnetisationBlocking.effectiveSamples()
+	};
+}
+
+IsingResults calculateResults(const SimulationData &data,
+							  int sites,
+							  double boltzmannConstant,
+							  double temperature,
+							  IsingInputParameters::ErrorTypes errorMethod,
+							  int jackKnifeBins,
+							  int bootstrapBlockLength,
+							  int threads,
+							  std::default_random_engine &generator)
+{
+	// Without the samples the errors can only come from the streaming statistics.
+	IsingResults results = data.keepSamples
+						 ? calculateResults(data.energyData, data.magnetisationData, sites, boltzmannConstant, temperature, errorMethod, jackKnifeBins, bootstrapBlockLength, threads, generator)
+						 : streamingResults(data, sites, boltzmannConstant, temperature);
+
+	if(data.magnetisationStatistics.getSize() > 0)
+	{
+		results.binderCumulant = data.magnetisationStatistics.binderCumulant();
+	}
+
+	// The improved estimator chi = <|C|>/(k_B T) is only available with cluster dynamics. The estimate uses every
+	// cluster after the burn period and its error the spread of the per-sweep means.
+	if(data.totalClusters > 0)
+	{
+		results.improvedSusceptibility      = static_cast<double>(data.totalClusterSize)/data.totalClusters/(boltzmannConstant*temperature);
+		results.improvedSusceptibilityError = data.clusterSizeStatistics.error()/(boltzmannConstant*temperature);
+	}
+	return results;
+}
@@ -0,0 +1,59 @@
+#ifndef calculateResults_hpp
+#define calculateResults_hpp
+#include <random>
+#include "DataArray.hpp"
+#include "IsingResults.hpp"
+#include "IsingInputParameters.hpp"
+#include "SimulationData.hpp"
+/**
+ *\file
+ *\brief function to calculate the results of a simulation at one temperature from its samples.
+ *\param energyData DataArray reference holding the energy samples.
+ *\param magnetisationData DataArray reference holding the absolute magnetisation samples.
+ *\param sites integer representing the number of sites in the lattice, susceptibility and heat capacity are per site.
+ *\param boltzmannConstant floating point value representing the Boltzmann constant.
+ *\param temperature floating point value representing the temperature of the samples.
+ *\param errorMethod the method used to calculate the errors of the susceptibility and heat capacity.
+ *\param jackKnifeBins number of bins used by the jack-knife method, 0 for one per sample.
+ *\param bootstrapBlockLength length of the blocks of consecutive samples drawn by the bootstrap method.
+ *\param threads number of threads the bootstrap re-samplings are shared between.
+ *\param generator reference to random engine used to seed the bootstrap re-samplings.
+ *\return IsingResults instance holding the mean energy, magnetisation, susceptibility and heat capacity and
+ * their errors, the improved susceptibility is NaN.
+ */
+IsingResults calculateResults(const DataArray &energyData,
+							  const DataArray &magnetisationData,
+							  int sites,
+							  double boltzmannConstant,
+							  double temperature,
+							  IsingInputParameters::ErrorTypes errorMethod,
+							  int jackKnifeBins,
+							  int bootstrapBlockLength,
+							  int threads,
+							  std::default_random_engine &generator);
+
+/**
+ *\brief function to calculate the results of a simulation at one temperature from its measurements.
+ *\param data SimulationData reference holding the measurements.
+ *\param sites integer representing the number of sites in the lattice, susceptibility and heat capacity are per site.
+ *\param boltzmannConstant floating point value representing the Boltzmann constant.
+ *\param temperature floating point value representing the temperature of the samples.
+ *\param errorMethod the method used to calculate the errors of the susceptibility and heat capacity.
+ *\param jackKnifeBins number of bins used by the jack-knife method, 0 for one per sample.
+ *\param bootstrapBlockLength length of the blocks of consecutive samples drawn by the bootstrap method.
+ *\param threads number of threads the bootstrap re-samplings are shared between.
+ *\param generator reference to random engine used to seed the bootstrap re-samplings.
+ *\return IsingResults instance as above with the Binder cumulant of the magnetisation, the improved susceptibility
+ * is also set if Wolff clusters were measured. If the samples weren't kept the errors come from the binned means
+ * of the streaming statistics instead of errorMethod.
+ */
+IsingResults calculateResults(const SimulationData &data,
+							  int sites,
+							  double boltzmannConstant,
+							  double temperature,
+							  IsingInputParameters::ErrorTypes errorMethod,
+							  int jackKnifeBins,
+							  int bootstrapBlockLength,
+							  int threads,
+							  std::default_random_engine &generator);
+#endif /* calculateResults_hpp */
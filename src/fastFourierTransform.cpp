@@ -0,0 +1,51 @@
+#include "fastFourierTransform.hpp"
+#include <cmath>
+#include <utility>
+
+void fastFourierTransform(std::vector<std::complex<double> > &data, bool inverse)
+{
+	const double pi = std::acos(-1.0);
+	int size = static_cast<int>(data.size());
+
+	// Put the elements in bit reversed order so the butterflies can be done in place.
+	for(int i = 1, j = 0; i < size; ++i)
+	{
+		int bit = size >> 1;
+		for(; j & bit; bit >>= 1)
+		{
+			j ^= bit;
+		}
+		j ^= bit;
+		if(i < j)
+		{
+			std::swap(data[i], data[j]);
+		}
+	}
+
+	// Combine transforms of length/2 into transforms of length.
+	for(int length = 2; length <= size; length <<= 1)
+	{
+		double angle = 2.0 * pi / length * (inverse ? 1.0 : -1.0);
+		std::complex<double> rootOfUnity(std::cos(angle), std::sin(angle));
+		for(int start = 0; start < size; start += length)
+		{
+			std::complex<double> twiddle(1.0, 0.0);
+			for(int k = 0; k < length / 2; ++k)
+			{
+				std::complex<double> even = data[start + k];
+				std::complex<double> odd  = data[start + k + length / 2] * twiddle;
+				data[start + k] 			 = even + odd;
+				data[start + k + length / 2] = even - odd;
+				twiddle *= rootOfUnity;
+			}
+		}
+	}
+
+	if(inverse)
+	{
+		for(auto& value : data)
+		{
+			value /= size;
+		}
+	}
+}
@@ -0,0 +1,14 @@
+#ifndef fastFourierTransform_hpp
+#define fastFourierTransform_hpp
+#include <complex>
+#include <vector>
+/**
+ *\file
+ *\brief function to calculate the discrete Fourier transform of a sequence in place.
+ *\param data vector of complex values whose size must be a power of two, replaced by its transform.
+ *\param inverse if true the inverse transform is calculated, including the 1/N normalisation.
+ *
+ * Uses the iterative radix-2 Cooley-Tukey algorithm so takes O(N log N) time.
+ */
+void fastFourierTransform(std::vector<std::complex<double> > &data, bool inverse);
+#endif /* fastFourierTransform_hpp */
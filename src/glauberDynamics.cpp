@@ -1,47 +1,32 @@
 #include "glauberDynamics.hpp"
+template<class Engine>
 bool glauberDynamics(SpinLattice2D& spinLattice,
-					 std::default_random_engine &generator,
-					 double jConstant,
-					 double boltzmannConstant,
-					 double temperature)
+					 Engine &generator,
+					 const BoltzmannTable& boltzmannTable)
 {
-	/*
-	 * Create distributions to get a random spin.
-	 * The arguments in the constructor give a closed interval so we have to subtract 1 off the maximum
-	 * in order to index an array.
-	 */
-	std::uniform_int_distribution<int> rowDistriubution(0,spinLattice.getRows()-1);
-	std::uniform_int_distribution<int> colDistriubution(0,spinLattice.getCols()-1);
-
-	// Draw the random spins.
-	int row = rowDistriubution(generator);
-	int col = colDistriubution(generator);
-
-	// Calculate the energy associated to the spin to be flipped before flipping.
-	double energyBefore = spinLattice.siteEnergy(row, col, jConstant);
-
-	// Flip the spin.
-	spinLattice.flip(row, col);
-
-	// Calculate the energy after the flip.
-	double energyAfter = spinLattice.siteEnergy(row, col, jConstant);
+	// Draw the random spin.
+	int row = randomIndex(generator, spinLattice.getRows());
+	int col = randomIndex(generator, spinLattice.getCols());
 
 	/*
 	 * Since the energy associated to the flip site are the only terms that contributes to the
-	 * sum in the change in energy the change in energy is just the difference between these
-	 * two energies.
+	 * sum in the change in energy the change in energy only depends on the spin and its local field.
 	 */
+	int energyChange = spinLattice.flipEnergyChange(row, col);
 
 	// Do the metropolis update.
-	if (!metropolisUpdate(energyBefore, energyAfter, generator, boltzmannConstant, temperature))
+	if(!boltzmannTable.accept(energyChange, generator))
 	{
-		// Flip the spin back if the update failed.
-		spinLattice.flip(row,col);
-
 		// Tell the caller the metropolis update failed.
 		return false;
 	}
 
-	// No need to flip the spin back if the update was successful.
+	// Only flip the spin if the update was successful.
+	spinLattice.flip(row, col);
 	return true;
 }
+
+// The dynamics are instantiated for every engine that can be chosen with --rng.
+template bool glauberDynamics(SpinLattice2D&, std::default_random_engine&, const BoltzmannTable&);
+template bool glauberDynamics(SpinLattice2D&, Xoshiro256StarStar&, const BoltzmannTable&);
+template bool glauberDynamics(SpinLattice2D&, Philox4x32&, const BoltzmannTable&);
@@ -1,25 +1,24 @@
 #ifndef glauberDynamics_hpp
 #define glauberDynamics_hpp
 #include "SpinLattice2D.hpp"
-#include "metropolisUpdate.hpp"
+#include "BoltzmannTable.hpp"
+#include "randomEngines.hpp"
 #include <random>
 /**
  *\file
  *\brief function perform Glauber dynamics on the array.
  *\param lattice a SpinLattice2D reference that has the dynamics performed on it.
- *\param generator an std::default_random_engine reference used for the random number generation in the call
- * to the metropolis update and choosing the spin to flip.
- *\param jConstant floating point value representing the J constant in the energy expression for a 2D spin lattice.
- *\param boltzmannConstant floating point value representing the Boltzmann constant
- *\param temperature floating point value representing the temperature of the system.
+ *\param generator a random engine reference used for the random number generation in the acceptance test and
+ * choosing the spin to flip, std::default_random_engine, Xoshiro256StarStar or Philox4x32.
+ *\param boltzmannTable a BoltzmannTable reference holding the acceptance thresholds for the temperature of the system.
  *\return boolean value representing whether the update was successful.
  *
- * The Glayber dynamics work by proposing a new configuration by flipping a spin and performing a Metropolis
- * update.
+ * The Glauber dynamics work by proposing a new configuration by flipping a spin and performing a Metropolis
+ * update. The energy change is calculated as an integer from the local field so the lattice is only written
+ * to if the flip is accepted.
  */
+template<class Engine>
 bool glauberDynamics(SpinLattice2D& lattice,
-					 std::default_random_engine& generator,
-					 double jConstant,
-					 double boltzmannConstant,
-					 double temperature);
+					 Engine& generator,
+					 const BoltzmannTable& boltzmannTable);
 #endif /* glauberDynamics_hpp */
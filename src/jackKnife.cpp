@@ -1,5 +1,8 @@
 #include "jackKnife.hpp"
 #include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
 
 double jackKnife(const DataArray::IDataFunctor &fcn, const DataArray &data)
 {
@@ -38,3 +41,47 @@ double jackKnife(const DataArray::IDataFunctor &fcn, const DataArray &data)
 
 
 }
+
+double jackKnife(const DataArray::IMomentFunctor &fcn, const DataArray &data, int bins)
+{
+	int size = data.getSize();
+	if(bins <= 0 || bins > size)
+	{
+		bins = size;
+	}
+
+	// Sums over every bin, bin b holds samples [b*N/bins, (b+1)*N/bins) so the sizes differ by at most one.
+	std::vector<double> binSums(bins, 0.0);
+	std::vector<double> binSquareSums(bins, 0.0);
+	std::vector<int> binSizes(bins, 0);
+	double sum = 0;
+	double squareSum = 0;
+	for(int bin = 0; bin < bins; ++bin)
+	{
+		int first = static_cast<int>(static_cast<long long>(bin) * size / bins);
+		int last  = static_cast<int>(static_cast<long long>(bin + 1) * size / bins);
+		for(int i = first; i < last; ++i)
+		{
+			binSums[bin] 	   += data[i];
+			binSquareSums[bin] += data[i] * data[i];
+		}
+		binSizes[bin] = last - first;
+		sum 	  += binSums[bin];
+		squareSum += binSquareSums[bin];
+	}
+
+	// Evaluate the function on the data with each bin removed.
+	DataArray reducedFcnValues;
+	reducedFcnValues.reserve(bins);
+	for(int bin = 0; bin < bins; ++bin)
+	{
+		double reducedSize = static_cast<double>(size - binSizes[bin]);
+		reducedFcnValues.push_back(fcn((sum - binSums[bin]) / reducedSize, (squareSum - binSquareSums[bin]) / reducedSize));
+	}
+
+	// Calculate error according to the formula for jack-knife, the variance of the reduced estimates is scaled
+	// by the number of bins less one, the standard (n - 1)/n factor applied to the sum of squared deviations.
+	double mean 	  = reducedFcnValues.mean();
+	double squareMean = reducedFcnValues.squareMean();
+	return std::sqrt(std::max(0.0, squareMean - mean * mean) * (bins - 1));
+}
@@ -16,4 +16,21 @@
  */
 double jackKnife(const DataArray::IDataFunctor &fcn, const DataArray &data);
 
+/**
+ *\brief Function to calculate the blocked jack-knife error of a function of the first two moments of a DataArray.
+ *\param fcn a IMomentFunctor reference that acts on the mean and square mean of the data (this is the function).
+ *\param data a DataArray reference the function is a function of.
+ *\param bins integer number of contiguous bins the data is split into, 0 (or the number of samples) for one bin
+ * per sample which is the ordinary jack-knife.
+ *\return floating point value representing the jack-knife error.
+ *
+ * One bin at a time is removed and the function evaluated on the moments of the rest, which are found by
+ * subtracting the sums over the bin from the sums over all the data. No reduced sample sets are copied so this
+ * is O(N) whatever the number of bins. For correlated data the bins should be longer than the autocorrelation
+ * time, otherwise the error is underestimated just like the naive error of the mean. The variance of the
+ * reduced values is multiplied by bins - 1, the standard jack-knife factor, where the version above multiplies
+ * by N, so with one bin per sample its errors are smaller by a factor sqrt((N - 1)/N).
+ */
+double jackKnife(const DataArray::IMomentFunctor &fcn, const DataArray &data, int bins);
+
 #endif /* jackKnife_hpp */
\ No newline at end of file
@@ -1,16 +1,19 @@
 #include <iostream> // For file IO.
-#include "SpinLattice2D.hpp" // For the spin lattice.
-#include "glauberDynamics.hpp" // For implementing the Glauber dynamics.
-#include "kawasakiDynamics.hpp" //  For implementing the kawasaki dynamics.
 #include "DataArray.hpp" // For holding Monte-Carlo samples and easily calculating their means and errors.
 #include "makeDirectory.hpp" // For creating output directories.
 #include "getTimeStamp.hpp" // For getting a time stamp.
 #include "IsingInputParameters.hpp" // For easily printing input variables to any output stream.
 #include "IsingResults.hpp" // For easily printing numerical results to any output stream.
-#include "HeatCapacity.hpp" // For calculating heat capacity.
-#include "Susceptibility.hpp" // For calculating susceptibility.
-#include "jackKnife.hpp" // For doing jack-knife errors.
-#include "bootstrap.hpp" // For doing bootstrap errors.
+#include "calculateResults.hpp" // For calculating the results and their errors from the samples.
+#include "parseTemperatures.hpp" // For reading a ladder of temperatures.
+#include "runReplicaExchange.hpp" // For running parallel tempering over a ladder of temperatures.
+#include "runTemperatureBatch.hpp" // For running independent simulations over a ladder of temperatures.
+#include "runSimulation.hpp" // For running the simulation at a single temperature.
+#include "SimulationData.hpp" // For holding the measurements of a simulation.
+#include "SnapshotWriter.hpp" // For recording binary trajectories.
+#include "Checkpoint.hpp" // For saving and resuming the state of a simulation.
+#include "ByteSpinLattice2D.hpp" // For choosing the kernel of the byte lattice.
+#include "TiledSweeper.hpp" // For the default tile size of tiled sweeps.
 #include <boost/filesystem.hpp> // For constructing directories for file IO.
 #include <boost/program_options.hpp> // For command line arguments.
 #include <fstream> // For file output.
@@ -19,6 +22,11 @@
 #include <random> // For generating random numbers.
 #include "Timer.hpp" // For custom timer.
 #include <cmath> // For any maths functions.
+#include <memory> // For owning the optional trajectory writer.
+#include <algorithm> // For limiting the range of the autocorrelation output.
+#ifdef ISING_USE_MPI
+#include "MpiEnvironment.hpp" // For initialising MPI for the distributed lattice.
+#endif
 
 
 
@@ -28,15 +36,14 @@ int main(int argc, char const *argv[])
 ************************************************* Preparations **********************************************************
 *************************************************************************************************************************/
 
+#ifdef ISING_USE_MPI
+    // MPI is shut down again whichever way main returns.
+    MpiEnvironment mpiEnvironment(&argc, const_cast<char***>(&argv));
+#endif
+
     // Start the clock so execution time can be calculated.
     Timer timer;
 
-    // Seed the pseudo random number generator using the system clock.
-    unsigned int seed = static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count());
-
-    // Create a generator that can be fed to any distribution to produce pseudo random numbers according to that distribution.
-    std::default_random_engine generator(seed);
-
 /*************************************************************************************************************************
 ******************************************************** Input **********************************************************
 *************************************************************************************************************************/
@@ -46,12 +53,39 @@ int main(int argc, char const *argv[])
     double temperature;
     int burnPeriod;
     int measurementInterval;
-    bool (*dynamics)(SpinLattice2D&, std::default_random_engine&, double, double, double);
     IsingInputParameters::ErrorTypes errorMethod;
+    int jackKnifeBins;
+    int bootstrapBlockLength;
     IsingInputParameters::DynamicsType dynamicsType;
+    bool localExchange;
+    IsingInputParameters::SpinModelType spinModel;
+    int spinStates;
     double jConstant;
     double boltzmannConstant;
     bool outputLattice;
+    bool checkObservables;
+    bool multiSpinCoding;
+    IsingInputParameters::VectorKernelType vectorKernel;
+    std::string vectorKernelName;
+    bool checkerboard;
+    bool tiled;
+    int tileSize;
+    bool nFoldWay;
+    bool replicaExchange;
+    bool distributed;
+    int rankCount;
+    bool streaming;
+    bool trajectory;
+    int keyFrameInterval;
+    int checkpointInterval;
+    bool resume;
+    int threadCount;
+    unsigned int seed;
+    IsingInputParameters::RandomEngineType randomEngine;
+    std::string randomEngineName;
+    std::vector<double> temperatures;
+    std::string temperatureList;
+    int swapInterval;
     int sweeps;
     int autoCorrelationRange;
     std::string outputName;
@@ -70,6 +104,40 @@ int main(int argc, char const *argv[])
         ("glauber-dynamics,g", "Choice of Glauber dynamics (is also default).")
         // Option 'kawasaki-dynamics' and 'k' are equivalent.
         ("kawasaki-dynamics,k", "Choice of Kawasaki Dynamics (will take precedence if user specialized Glauber dynamics as well).")
+        // Option 'local-exchange' only.
+        ("local-exchange", "With Kawasaki dynamics only swap nearest neighbours, the physical dynamics of coarsening with a conserved order parameter, instead of any two opposite spins (needs at least 3 rows and columns).")
+        // Option 'potts' only.
+        ("potts", boost::program_options::value<int>(), "Simulate the q-state Potts model, E = -J Sum delta(s_i, s_j), with 2 to 8 states and Metropolis dynamics proposing one of the other states at random sites (random site Glauber dynamics only). The magnetisation is the length of the sum of the unit vectors of the states.")
+        // Option 'spin-states' only.
+        ("spin-states", boost::program_options::value<int>(), "Simulate the spin-S Ising model with 2 to 5 states (spin-1/2 to spin-2), E = -J Sum s_i s_j with s = m/S in [-1, 1], with the same dynamics as --potts. Two states is the ordinary Ising model.")
+        // Option 'wolff-dynamics' and 'w' are equivalent.
+        ("wolff-dynamics,w", "Choice of Wolff cluster dynamics, one sweep flips clusters until as many sites as the lattice has have been flipped on average, calibrated during the burn period (ferromagnetic J and a burn period only).")
+        // Option 'multi-spin' and 'm' are equivalent.
+        ("multi-spin,m", "Store the lattice bit-packed and update it a word at a time with checkerboard sweeps (Glauber dynamics only, needs even row and column counts).")
+        // Option 'simd' only.
+        ("simd", boost::program_options::value<std::string>(&vectorKernelName)->implicit_value("auto"), "Store the lattice one byte per spin in checkerboard order and sweep it with a vector kernel, auto (the fastest the processor supports), avx512, avx2 or scalar. Every kernel makes the same flips (Glauber dynamics only, needs even row and column counts).")
+        // Option 'checkerboard' only.
+        ("checkerboard", "Sweep the lattice in checkerboard order instead of choosing random sites (Glauber dynamics only, needs even row and column counts).")
+        // Option 'tiled' only.
+        ("tiled", "Sweep the lattice tile by tile, visiting one checkerboard sublattice of each tile and then the other, instead of choosing random sites. Much faster than random sites on lattices larger than the cache. With Kawasaki dynamics and --local-exchange every nearest neighbour bond is proposed once per sweep instead of random anti-aligned bonds (standard lattice only).")
+        // Option 'tile-size' only.
+        ("tile-size", boost::program_options::value<int>(&tileSize)->default_value(TiledSweeper::defaultTileSize), "Number of rows and columns of each tile of --tiled sweeps, a tile touches about (tile-size + 2)^2 bytes so choose it to fit the cache.")
+        // Option 'n-fold-way' only.
+        ("n-fold-way", "Run Glauber dynamics rejection-free in continuous time with the n-fold way (BKL), every step flips a spin and advances a clock so a sweep still takes the same physical time. Much faster at low temperatures where most ordinary flips are rejected (standard lattice, random sites only).")
+        // Option 'threads' only.
+        ("threads", boost::program_options::value<int>(&threadCount)->default_value(1), "Number of threads used for checkerboard sweeps (implies --checkerboard if more than 1).")
+        // Option 'seed' only.
+        ("seed", boost::program_options::value<unsigned int>(&seed), "Seed for the random number generators (defaults to the system clock).")
+        // Option 'rng' only.
+        ("rng", boost::program_options::value<std::string>(&randomEngineName)->default_value("minstd"), "Random number engine used by the lattice dynamics, minstd (std::default_random_engine), xoshiro (xoshiro256**) or philox (counter based Philox4x32-10). The 64 bit engines are several times faster than minstd, which is kept as the default so existing seeds give the same results (not Swendsen-Wang, replica exchange or --distributed).")
+        // Option 'swendsen-wang-dynamics' only.
+        ("swendsen-wang-dynamics", "Choice of multithreaded Swendsen-Wang cluster dynamics, one sweep is one update of every cluster (ferromagnetic J only).")
+        // Option 'replica-exchange' only.
+        ("replica-exchange", "Run parallel tempering over the ladder of temperatures given by --temperatures (Glauber dynamics only).")
+        // Option 'temperatures' only.
+        ("temperatures", boost::program_options::value<std::string>(&temperatureList), "Ladder of temperatures, either a comma separated list or min:max:count. Each temperature is simulated independently with the threads sharing out the temperatures unless --replica-exchange is given.")
+        // Option 'swap-interval' only.
+        ("swap-interval", boost::program_options::value<int>(&swapInterval)->default_value(1), "Number of sweeps between attempted replica exchanges.")
         // Option 'J-constant' and 'J' are equivalent.
         ("J-constant,J", boost::program_options::value<double>(&jConstant)->default_value(1), "J constant that determines units of energy.")
         // Options 'Boltzmann-constant' and 'B' are equivalent.
@@ -86,10 +154,30 @@ int main(int argc, char const *argv[])
         ("output,o",boost::program_options::value<std::string>(&outputName)->default_value(getTimeStamp()), "Name of output directory to save output files into.")
         // 'bootstrap is the only option'
         ("bootstrap", "Use bootstrap method to calculate errors that depend on second central moment (default)")
+        // Option 'bootstrap-block-length' only.
+        ("bootstrap-block-length", boost::program_options::value<int>(&bootstrapBlockLength)->default_value(1), "Length of the blocks of consecutive samples drawn by the bootstrap (moving-block bootstrap), blocks longer than the autocorrelation time give honest errors for correlated samples.")
         // 'jackknife only option'
         ("jackknife","Use jackknife meothod to calculate the errors that depend on second moment (takes precedence if selected")
+        // Option 'jackknife-bins' only.
+        ("jackknife-bins", boost::program_options::value<int>(&jackKnifeBins)->default_value(0), "Number of contiguous bins removed one at a time by the jackknife, bins longer than the autocorrelation time give honest errors for correlated samples (0 for one bin per sample).")
+        // Option 'streaming' only.
+        ("streaming", "Keep only running moments and binned averages of the measurements instead of every sample, so memory doesn't grow with the run length. The sample files and autocorrelation functions are not written and errors come from the binned averages.")
+        // Option 'trajectory' only.
+        ("trajectory", "Record every measured configuration in the binary file trajectory.snap, one bit per spin with only the changed sites stored between keyframes. Read it with tools/snapshot-convert (make tools).")
+        // Option 'keyframe-interval' only.
+        ("keyframe-interval", boost::program_options::value<int>(&keyFrameInterval)->default_value(64), "Maximum number of trajectory frames between keyframes holding the whole lattice.")
+        // Option 'checkpoint-interval' only.
+        ("checkpoint-interval", boost::program_options::value<int>(&checkpointInterval)->default_value(0), "Number of sweeps between saving the state of the simulation to checkpoint.bin in the output directory, 0 for never (single temperature only).")
+        // Option 'resume' only.
+        ("resume", "Continue the simulation from checkpoint.bin in the existing output directory given by --output, the other options must be the same as the original run apart from the seed which can be left out.")
+        // Option 'check-observables' only.
+        ("check-observables", "Debug mode, check the running energy and magnetisation against a full recalculation at every measurement.")
         // Option 'animate' and 'a' are equivalent.
         ("animate,a","Output the lattice after each sweep for animation.")
+#ifdef ISING_USE_MPI
+        // Option 'distributed' only.
+        ("distributed", "Split the lattice into strips of rows across the MPI ranks and sweep it in checkerboard order with halo exchange (Glauber dynamics only, needs even row and column counts).")
+#endif
         // Option 'help' and 'h' are equivalent.
         ("help,h", "produce help message");
 
@@ -104,18 +192,287 @@ int main(int argc, char const *argv[])
         return 1;
     }
 
-    // Set the dynamics pointer to point at the right dynamics function.
+    // The state of the simulation is saved to and resumed from the output directory.
+    resume = vm.count("resume");
+    Checkpoint checkpoint(outputName + "/checkpoint.bin", checkpointInterval);
+    if(resume && !checkpoint.load())
+    {
+        std::cerr << "There is no complete checkpoint to resume from in " << outputName << "." << '\n';
+        return 1;
+    }
+
+    // Seed the pseudo random number generator using the system clock unless the user gave a seed, a resumed
+    // simulation keeps its original seed.
+    if(!vm.count("seed"))
+    {
+        seed = resume ? checkpoint.getSeed() : static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count());
+    }
+
+#ifdef ISING_USE_MPI
+    // Every rank must use the same seed, in particular the one chosen from the clock by rank 0.
+    MPI_Bcast(&seed, 1, MPI_UNSIGNED, 0, MPI_COMM_WORLD);
+#endif
+
+    // Create a generator that can be fed to any distribution to produce pseudo random numbers according to that distribution.
+    std::default_random_engine generator(seed);
+
     // Default to Glauber - even if Glauber specified this will work/
-    dynamics = glauberDynamics;
     dynamicsType = IsingInputParameters::Glauber;
 
     // Check if Kawasaki specified, if so this takes precedence.
     if(vm.count("kawasaki-dynamics"))
     {
-    	dynamics = kawasakiDynamics;
     	dynamicsType = IsingInputParameters::Kawasaki;
     }
 
+    // Check if Wolff specified, it can't be combined with Kawasaki since it doesn't conserve magnetisation.
+    if(vm.count("wolff-dynamics"))
+    {
+        if(dynamicsType == IsingInputParameters::Kawasaki)
+        {
+            std::cerr << "Wolff and Kawasaki dynamics can't be used together." << '\n';
+            return 1;
+        }
+
+        if(jConstant <= 0)
+        {
+            std::cerr << "Wolff dynamics needs a ferromagnetic (positive) J constant." << '\n';
+            return 1;
+        }
+
+        // The number of clusters in a measured sweep is calibrated from the cluster sizes of the burn period.
+        if(burnPeriod < 1)
+        {
+            std::cerr << "Wolff dynamics need a burn period of at least one sweep to calibrate the clusters per sweep." << '\n';
+            return 1;
+        }
+
+        dynamicsType = IsingInputParameters::Wolff;
+    }
+
+    // Check if Swendsen-Wang specified, again it can't be combined with the other dynamics.
+    if(vm.count("swendsen-wang-dynamics"))
+    {
+        if(dynamicsType != IsingInputParameters::Glauber)
+        {
+            std::cerr << "Swendsen-Wang dynamics can't be used with other dynamics." << '\n';
+            return 1;
+        }
+
+        if(jConstant <= 0)
+        {
+            std::cerr << "Swendsen-Wang dynamics needs a ferromagnetic (positive) J constant." << '\n';
+            return 1;
+        }
+
+        dynamicsType = IsingInputParameters::SwendsenWang;
+    }
+
+    // By default Kawasaki dynamics swap opposite spins anywhere on the lattice.
+    localExchange = vm.count("local-exchange");
+    if(localExchange)
+    {
+        if(dynamicsType != IsingInputParameters::Kawasaki)
+        {
+            std::cerr << "Local exchange is only available with Kawasaki dynamics." << '\n';
+            return 1;
+        }
+
+        if(rowCount < 3 || columnCount < 3)
+        {
+            std::cerr << "Local exchange needs at least 3 rows and columns." << '\n';
+            return 1;
+        }
+    }
+
+    // By default simulate the Ising model.
+    spinModel = IsingInputParameters::Ising;
+    spinStates = 2;
+    if(vm.count("potts") && vm.count("spin-states"))
+    {
+        std::cerr << "The Potts and spin-S models can't be used together." << '\n';
+        return 1;
+    }
+    if(vm.count("potts"))
+    {
+        spinModel = IsingInputParameters::Potts;
+        spinStates = vm["potts"].as<int>();
+        if(spinStates < 2 || spinStates > 8)
+        {
+            std::cerr << "The Potts model is available with 2 to 8 states." << '\n';
+            return 1;
+        }
+    }
+    if(vm.count("spin-states"))
+    {
+        spinModel = IsingInputParameters::SpinS;
+        spinStates = vm["spin-states"].as<int>();
+        if(spinStates < 2 || spinStates > 5)
+        {
+            std::cerr << "The spin-S model is available with 2 to 5 states." << '\n';
+            return 1;
+        }
+    }
+
+    // The multi-state lattices have their own random site dynamics.
+    if(spinModel != IsingInputParameters::Ising
+       && (dynamicsType != IsingInputParameters::Glauber || vm.count("multi-spin") || vm.count("simd") || vm.count("checkerboard")
+           || vm.count("n-fold-way") || vm.count("replica-exchange") || vm.count("trajectory")))
+    {
+        std::cerr << "The Potts and spin-S models only support random site Glauber dynamics on their own lattice, without trajectories." << '\n';
+        return 1;
+    }
+
+    // By default use the ordinary lattice.
+    multiSpinCoding = false;
+
+    // If the user asked for multi-spin coding make sure the lattice can be decomposed into a checkerboard.
+    if(vm.count("multi-spin"))
+    {
+        if(dynamicsType != IsingInputParameters::Glauber)
+        {
+            std::cerr << "Multi-spin coding only supports Glauber dynamics." << '\n';
+            return 1;
+        }
+
+        if((rowCount % 2) || (columnCount % 2))
+        {
+            std::cerr << "Multi-spin coding needs an even number of rows and columns." << '\n';
+            return 1;
+        }
+
+        multiSpinCoding = true;
+    }
+
+    // If the user asked for the byte lattice choose its kernel and make sure the lattice can be decomposed into a checkerboard.
+    vectorKernel = IsingInputParameters::NoVectorKernel;
+    if(vm.count("simd"))
+    {
+        ByteSpinLattice2D::Kernel kernel;
+        if(vectorKernelName == "auto")
+        {
+            kernel = ByteSpinLattice2D::fastestKernel();
+        }
+        else if(vectorKernelName == "avx512")
+        {
+            kernel = ByteSpinLattice2D::Avx512;
+        }
+        else if(vectorKernelName == "avx2")
+        {
+            kernel = ByteSpinLattice2D::Avx2;
+        }
+        else if(vectorKernelName == "scalar")
+        {
+            kernel = ByteSpinLattice2D::Scalar;
+        }
+        else
+        {
+            std::cerr << "The vector kernel must be auto, avx512, avx2 or scalar." << '\n';
+            return 1;
+        }
+
+        if(!ByteSpinLattice2D::kernelSupported(kernel))
+        {
+            std::cerr << "This processor doesn't support the " << ByteSpinLattice2D::kernelName(kernel) << " kernel." << '\n';
+            return 1;
+        }
+
+        if(dynamicsType != IsingInputParameters::Glauber || multiSpinCoding)
+        {
+            std::cerr << "The byte lattice only supports Glauber dynamics and can't be combined with multi-spin coding." << '\n';
+            return 1;
+        }
+
+        if((rowCount % 2) || (columnCount % 2))
+        {
+            std::cerr << "The byte lattice needs an even number of rows and columns." << '\n';
+            return 1;
+        }
+
+        vectorKernel = (kernel == ByteSpinLattice2D::Avx512) ? IsingInputParameters::Avx512Kernel
+                       : ((kernel == ByteSpinLattice2D::Avx2) ? IsingInputParameters::Avx2Kernel : IsingInputParameters::ScalarKernel);
+    }
+
+    // With a ladder of temperatures the threads share out the temperatures rather than the sites of one lattice.
+    bool temperatureLadder = vm.count("temperatures");
+
+    // By default the whole lattice is held by one process.
+    distributed = false;
+    rankCount = 1;
+#ifdef ISING_USE_MPI
+    distributed = vm.count("distributed");
+    rankCount = mpiEnvironment.getRankCount();
+    if(!distributed && rankCount > 1)
+    {
+        std::cerr << "Run with --distributed to use more than one MPI rank." << '\n';
+        return 1;
+    }
+#endif
+
+    // The distributed lattice has its own checkerboard sweeps.
+    if(distributed)
+    {
+        if(dynamicsType != IsingInputParameters::Glauber || spinModel != IsingInputParameters::Ising || multiSpinCoding || vectorKernel != IsingInputParameters::NoVectorKernel || temperatureLadder)
+        {
+            std::cerr << "The distributed lattice only supports Glauber dynamics at a single temperature." << '\n';
+            return 1;
+        }
+
+        if(rowCount < rankCount)
+        {
+            std::cerr << "The distributed lattice needs at least as many rows as MPI ranks." << '\n';
+            return 1;
+        }
+
+        threadCount = 1;
+    }
+
+    // The n-fold way chooses its flips from all the sites so can't be combined with other update orders.
+    nFoldWay = vm.count("n-fold-way");
+    if(nFoldWay && (dynamicsType != IsingInputParameters::Glauber || multiSpinCoding || vectorKernel != IsingInputParameters::NoVectorKernel || distributed || vm.count("checkerboard") || vm.count("replica-exchange")))
+    {
+        std::cerr << "The n-fold way only supports Glauber dynamics on the standard lattice with random sites." << '\n';
+        return 1;
+    }
+
+    // The tiled order replaces the random sites of Glauber dynamics or the random bonds of local exchange.
+    tiled = vm.count("tiled");
+    if(tiled)
+    {
+        if((dynamicsType != IsingInputParameters::Glauber && !(dynamicsType == IsingInputParameters::Kawasaki && localExchange))
+           || spinModel != IsingInputParameters::Ising || multiSpinCoding || vectorKernel != IsingInputParameters::NoVectorKernel
+           || distributed || nFoldWay || vm.count("checkerboard") || vm.count("replica-exchange"))
+        {
+            std::cerr << "Tiled sweeps only support Glauber dynamics or Kawasaki dynamics with local exchange on the standard lattice." << '\n';
+            return 1;
+        }
+
+        if(tileSize < 1)
+        {
+            std::cerr << "The tile size must be at least 1." << '\n';
+            return 1;
+        }
+    }
+
+    // By default choose sites at random, more than one thread with Glauber dynamics needs the checkerboard decomposition.
+    checkerboard = vm.count("checkerboard") || distributed || (!temperatureLadder && !nFoldWay && !tiled && threadCount > 1 && dynamicsType == IsingInputParameters::Glauber && spinModel == IsingInputParameters::Ising);
+
+    // Make sure the checkerboard is consistent with the periodic boundary conditions.
+    if(checkerboard)
+    {
+        if(dynamicsType != IsingInputParameters::Glauber || multiSpinCoding || vectorKernel != IsingInputParameters::NoVectorKernel)
+        {
+            std::cerr << "Checkerboard sweeps only support Glauber dynamics on the standard lattice." << '\n';
+            return 1;
+        }
+
+        if((rowCount % 2) || (columnCount % 2))
+        {
+            std::cerr << "Checkerboard sweeps need an even number of rows and columns." << '\n';
+            return 1;
+        }
+    }
+
     // By default don't output the lattice
     outputLattice = false;
 
@@ -125,6 +482,100 @@ int main(int argc, char const *argv[])
     	outputLattice = true;
     }
 
+    // Only check the running observables if the user asked since it makes measurements O(N) again.
+    checkObservables = vm.count("check-observables");
+
+    // A ladder of temperatures is either a batch of independent runs or coupled by replica exchange.
+    replicaExchange = vm.count("replica-exchange");
+    if(replicaExchange && !temperatureLadder)
+    {
+        std::cerr << "Replica exchange needs a ladder of temperatures given by --temperatures." << '\n';
+        return 1;
+    }
+
+    if(temperatureLadder)
+    {
+        temperatures = parseTemperatures(temperatureList);
+        if(temperatures.empty())
+        {
+            std::cerr << "The temperatures must be a comma separated list or min:max:count of positive temperatures." << '\n';
+            return 1;
+        }
+
+        if(outputLattice || vm.count("trajectory"))
+        {
+            std::cerr << "Animation and trajectories are only available for a single temperature." << '\n';
+            return 1;
+        }
+    }
+
+    // Replica exchange sweeps each replica with random site Glauber dynamics.
+    if(replicaExchange)
+    {
+        if(dynamicsType != IsingInputParameters::Glauber || multiSpinCoding || vectorKernel != IsingInputParameters::NoVectorKernel || checkerboard)
+        {
+            std::cerr << "Replica exchange only supports Glauber dynamics on the standard lattice." << '\n';
+            return 1;
+        }
+
+        if(swapInterval < 1)
+        {
+            std::cerr << "The swap interval must be at least one sweep." << '\n';
+            return 1;
+        }
+    }
+
+    // By default use the standard engine.
+    if(randomEngineName == "minstd")
+    {
+        randomEngine = IsingInputParameters::StandardEngine;
+    }
+    else if(randomEngineName == "xoshiro")
+    {
+        randomEngine = IsingInputParameters::Xoshiro;
+    }
+    else if(randomEngineName == "philox")
+    {
+        randomEngine = IsingInputParameters::Philox;
+    }
+    else
+    {
+        std::cerr << "The random number engine must be minstd, xoshiro or philox." << '\n';
+        return 1;
+    }
+
+    // Swendsen-Wang, replica exchange and the distributed lattice have their own standard engines.
+    if(randomEngine != IsingInputParameters::StandardEngine
+       && (dynamicsType == IsingInputParameters::SwendsenWang || replicaExchange || distributed))
+    {
+        std::cerr << "Other random number engines aren't available for Swendsen-Wang dynamics, replica exchange or the distributed lattice." << '\n';
+        return 1;
+    }
+
+    // By default keep every sample.
+    streaming = vm.count("streaming");
+
+    // By default don't record the trajectory.
+    trajectory = vm.count("trajectory");
+
+    // Checkpoints hold the state of a single lattice on one process, a trajectory can't be continued.
+    if((checkpointInterval != 0 || resume) && (temperatureLadder || distributed || trajectory))
+    {
+        std::cerr << "Checkpoints are only available for a single temperature without --distributed or --trajectory." << '\n';
+        return 1;
+    }
+
+    if(checkpointInterval < 0)
+    {
+        std::cerr << "The checkpoint interval can't be negative." << '\n';
+        return 1;
+    }
+    if(keyFrameInterval < 1)
+    {
+        std::cerr << "The keyframe interval must be at least one frame." << '\n';
+        return 1;
+    }
+
     // By defualt use bootstrap.
     errorMethod = IsingInputParameters::Bootstrap;
 
@@ -134,6 +585,18 @@ int main(int argc, char const *argv[])
     	errorMethod = IsingInputParameters::JackKnife;
     }
 
+    if(bootstrapBlockLength < 1)
+    {
+        std::cerr << "The bootstrap block length must be at least one sample." << '\n';
+        return 1;
+    }
+
+    if(jackKnifeBins < 0 || jackKnifeBins == 1)
+    {
+        std::cerr << "The jackknife needs at least two bins." << '\n';
+        return 1;
+    }
+
     // Construct an input parameter object, this just makes printing a lot cleaner.
     IsingInputParameters inputParameters
     {
@@ -143,26 +606,93 @@ int main(int argc, char const *argv[])
     	burnPeriod,
 		  measurementInterval,
 		  dynamicsType,
+		  localExchange,
+      spinModel,
+      spinStates,
 		  jConstant,
 		  boltzmannConstant,
 		  sweeps,
 		  autoCorrelationRange,
-      errorMethod
+      errorMethod,
+      jackKnifeBins,
+      bootstrapBlockLength,
+      multiSpinCoding,
+      vectorKernel,
+      checkerboard,
+      tiled,
+      tileSize,
+      nFoldWay,
+      threadCount,
+      seed,
+      randomEngine,
+      temperatures,
+      swapInterval,
+      replicaExchange,
+      distributed,
+      rankCount,
+      streaming,
+      trajectory,
+      keyFrameInterval,
+      checkpointInterval
 	};
 
+    // A checkpoint only holds the state of a simulation with the same parameters.
+    if(resume && !checkpoint.matches(inputParameters))
+    {
+        std::cerr << "The options differ from those of the checkpointed simulation." << '\n';
+        return 1;
+    }
+
+#ifdef ISING_USE_MPI
+    // Only rank 0 writes any output, the other ranks just take part in the simulation of the distributed lattice.
+    if(mpiEnvironment.getRank() != 0)
+    {
+        SimulationData data;
+        return runSimulation(inputParameters, generator, data, nullptr, nullptr, nullptr, nullptr, outputLattice, checkObservables) ? 0 : 1;
+    }
+#endif
+
 /*************************************************************************************************************************
 ************************************************* Create Output Files ***************************************************
 *************************************************************************************************************************/
 
-    // Create an output directory from either the default time stamp or the user defined string.
-    makeDirectory(outputName);
-
-    //Create output file for the spin array.
-    std::fstream spinsOutput(outputName+"/spins.dat",std::ios::out);
+    // Create an output directory from either the default time stamp or the user defined string, a resumed
+    // simulation writes to its original one.
+    if(!resume)
+    {
+        makeDirectory(outputName);
+    }
 
     // Create output file for the input parameters.
     std::fstream inputParameterOutput(outputName+"/input.txt",std::ios::out);
 
+    // Print input parameters to command line.
+    std::cout << inputParameters << '\n';
+
+    // Print input parameters to an output file
+    inputParameterOutput << inputParameters << '\n';
+
+    // A ladder of temperatures writes its own output for every temperature.
+    if(!temperatures.empty())
+    {
+        if(replicaExchange)
+        {
+            runReplicaExchange(inputParameters, outputName, generator);
+        }
+        else if(!runTemperatureBatch(inputParameters, outputName, checkObservables))
+        {
+            return 1;
+        }
+
+        // Report how long the program took to execute.
+        std::cout << std::setw(30) << std::setfill(' ') << std::left << "Time take to execute(s) =    " << std::right << timer.elapsed() << std::endl << std::endl;
+
+        return 0;
+    }
+
+    //Create output file for the spin array.
+    std::fstream spinsOutput(outputName+"/spins.dat",std::ios::out);
+
     // Create an output file for the output values.
     std::fstream resultsOutput(outputName+"/results.txt",std::ios::out);
 
@@ -178,162 +708,89 @@ int main(int argc, char const *argv[])
     // Create an output file for the auto-correlation of the energy.
     std::fstream energyAutoCorrelationOutput(outputName + "/energyAutoCorrelation.dat", std::ios::out);
 
-    // Create an output file for initial configuration.
-    std::fstream initialConfigOutput(outputName + "/initalConfiguration.dat", std::ios::out);
+    // Create an output file for the integrated autocorrelation times.
+    std::fstream autoCorrelationTimeOutput(outputName + "/autocorrelationTime.txt", std::ios::out);
+
+    // Create an output file for initial configuration, a resumed simulation keeps the original.
+    std::fstream initialConfigOutput;
+    if(!resume)
+    {
+        initialConfigOutput.open(outputName + "/initalConfiguration.dat", std::ios::out);
+    }
 
 /*************************************************************************************************************************
 ************************************************* Simulation Set Up *****************************************************
 *************************************************************************************************************************/
 
-    // Print input parameters to command line.
-    std::cout << inputParameters << '\n';
-
-    // Print input parameters to an output file
-    inputParameterOutput << inputParameters << '\n';
+    // Everything measured during the simulation.
+    SimulationData data;
 
-    // Create the lattice of spins.
-    SpinLattice2D spinLattice(rowCount,columnCount);
-
-    // Set lattice if Kawasaki dynamics is being used, otherwise keep it aligned.
-    if(vm.count("kawasaki-dynamics"))
+    // Binary trajectory of every measured configuration, if the user asked for one.
+    std::unique_ptr<SnapshotWriter> trajectoryOutput;
+    if(trajectory)
     {
-        // If the temperature is low we can set the lattice in the ground state.
-        if(temperature < 1.5)
-        {
-            spinLattice.setEvenSpins();
-        }
-
-        // Otherwise have it random.
-        else
-        {
-            spinLattice.randomise(generator);
-        }
+        trajectoryOutput.reset(new SnapshotWriter(outputName + "/trajectory.snap", rowCount, columnCount, temperature, keyFrameInterval));
     }
-    initialConfigOutput << spinLattice;
-
-    // Work out the number of samples we need.
-    int totalSamples = sweeps/measurementInterval;
-
-    // Create the output variables that will hold the Monte-Carlo estimates.
-    int totalSites = spinLattice.getSize();
-
-    // Since we know how many samples we will take faster to reserve the space before hand.
-    DataArray energyData;
-    energyData.reserve(totalSamples);
-
-    DataArray magnetisationData;
-    magnetisationData.reserve(totalSamples);
-
-    DataArray scaledMagnetisation;
-    scaledMagnetisation.reserve(totalSamples);
 
 /*************************************************************************************************************************
 ************************************************* The Simulation ********************************************************
 *************************************************************************************************************************/
 
-    // Main loop that actually runs the simulation.
-    for(int sweep = 0; sweep < burnPeriod+sweeps; ++sweep)
+    if(!runSimulation(inputParameters, generator, data, resume ? nullptr : &initialConfigOutput, &spinsOutput, trajectoryOutput.get(), &checkpoint, outputLattice, checkObservables))
     {
-        // 1 sweep = #col x #row = total #sites proposed flips.
-    	for(int site = 0; site < totalSites; ++site)
-    	{
-            dynamics(spinLattice, generator, jConstant, boltzmannConstant, temperature);
-    	}
-
-    	// If we are out of the burn period and on a measurement sweep then make any measurements.
-    	if((sweep >= burnPeriod) && ((sweep % measurementInterval) == 0))
-    	{
-    		double sweepEnergy = spinLattice.latticeEnergy(jConstant);
-    		energyData.push_back(sweepEnergy);
-
-    		double sweepMagnetistation = spinLattice.totalMag();
-    		magnetisationData.push_back(std::abs(sweepMagnetistation));
-    	}
-
-        // If the user plans to animate the configuration then output it here.
-        if(outputLattice && ((sweep % measurementInterval) == 0))
-        {
-            spinsOutput.seekg(0,std::ios::beg);
-            spinsOutput << spinLattice << std::flush;
-        }
+        return 1;
     }
 
 /*************************************************************************************************************************
 ****************************************************  Analysis **********************************************************
 *************************************************************************************************************************/
 
-    // Print the final configuration so it can be reused in future.
-    spinsOutput.seekg(0,std::ios::beg);
-    spinsOutput << spinLattice << std::flush;
-
-
-   	// Print data to files.
-   	energyDataOutput << energyData;
-   	magnetisationDataOutput << magnetisationData;
-
-   	// Calculate the auto-correlation in the magnetisation and energy and print it.
-   	std::vector<double> magAutoCorrelation = magnetisationData.autoCorrelation(0,autoCorrelationRange);
-   	std::vector<double> engAutoCorrelation = energyData.autoCorrelation(0,autoCorrelationRange);
-   	for(int i = 0; i < magAutoCorrelation.size(); ++i)
-   	{
-   		magnetisationAutoCorrelationOutput << i << ' ' << magAutoCorrelation[i] << '\n';
-   		energyAutoCorrelationOutput << i << ' ' << engAutoCorrelation[i] << '\n';
-   	}
+   	// Print data to files, there is nothing to print if only the streaming statistics were kept.
+    if(!streaming)
+    {
+       	energyDataOutput << data.energyData;
+       	magnetisationDataOutput << data.magnetisationData;
+        data.profile.endPhase(RunProfile::Output);
+
+       	// Calculate the auto-correlation in the magnetisation and energy at every lag, it costs the same as the
+       	// range printed and the integrated autocorrelation times below need the rest, then print the range.
+       	std::vector<double> magAutoCorrelation = data.magnetisationData.autoCorrelation(0,data.magnetisationData.getSize());
+       	std::vector<double> engAutoCorrelation = data.energyData.autoCorrelation(0,data.energyData.getSize());
+       	for(int i = 0; i < std::min(autoCorrelationRange, static_cast<int>(magAutoCorrelation.size())); ++i)
+       	{
+       		magnetisationAutoCorrelationOutput << i << ' ' << magAutoCorrelation[i] << '\n';
+       		energyAutoCorrelationOutput << i << ' ' << engAutoCorrelation[i] << '\n';
+       	}
+
+        // Calculate the integrated autocorrelation times in units of measurements and print them.
+        int energyWindow, magnetisationWindow;
+        double energyTau = data.energyData.integratedAutoCorrelationTime(engAutoCorrelation, energyWindow);
+        double magnetisationTau = data.magnetisationData.integratedAutoCorrelationTime(magAutoCorrelation, magnetisationWindow);
+        autoCorrelationTimeOutput << std::setw(30) << std::setfill(' ') << std::left << "Energy-Tau-Int: " << std::right
+                                  << energyTau << " +/- " << data.energyData.integratedAutoCorrelationTimeError(energyTau, energyWindow) << '\n';
+        autoCorrelationTimeOutput << std::setw(30) << std::setfill(' ') << std::left << "Energy-Window: " << std::right << energyWindow << '\n';
+        autoCorrelationTimeOutput << std::setw(30) << std::setfill(' ') << std::left << "Magnetisation-Tau-Int: " << std::right
+                                  << magnetisationTau << " +/- " << data.magnetisationData.integratedAutoCorrelationTimeError(magnetisationTau, magnetisationWindow) << '\n';
+        autoCorrelationTimeOutput << std::setw(30) << std::setfill(' ') << std::left << "Magnetisation-Window: " << std::right << magnetisationWindow << '\n';
+        data.profile.endPhase(RunProfile::AutoCorrelation);
+    }
 
    	// Calculate any numerical values we need and their errors.
-   	double energy 	   = energyData.mean();
-   	double energyError = energyData.error();
-
-   	double magnetisation 	  = magnetisationData.mean();
-   	double magnetisationError = magnetisationData.error();
-
-   	// Construct the susceptibility functor.
-   	Susceptibility susceptibilityFcn(boltzmannConstant, temperature);
-
-   	double susceptibility = susceptibilityFcn(magnetisationData)/(spinLattice.getSize());
-	double errorSusceptibility;
-	switch (errorMethod)
-	{
-		case IsingInputParameters::Bootstrap : errorSusceptibility = bootstrap(susceptibilityFcn, magnetisationData, generator)/(spinLattice.getSize());
-						 break;
-
-		case IsingInputParameters::JackKnife : errorSusceptibility = jackKnife(susceptibilityFcn, magnetisationData)/(spinLattice.getSize());
-						 break;
-	}
-
-   	// Construct the heat capacity functor.
-   	HeatCapacity heatCapacityFcn(boltzmannConstant, temperature);
-
-   	double heatCapacity = heatCapacityFcn(energyData)/(spinLattice.getSize());
-   	double errorHeatCapacity;
-   	switch (errorMethod)
-	{
-		case IsingInputParameters::Bootstrap : errorHeatCapacity = bootstrap(heatCapacityFcn, energyData, generator)/(spinLattice.getSize());
-						 			 break;
-
-		case IsingInputParameters::JackKnife : errorHeatCapacity = jackKnife(heatCapacityFcn, energyData)/(spinLattice.getSize());
-						 			 break;
-	}
-
-    // Construct object that holds results.
-   	IsingResults results
-   	{
-   		energy,
-   		energyError,
-   		magnetisation,
-   		magnetisationError,
-   		susceptibility,
-   		errorSusceptibility,
-   		heatCapacity,
-   		errorHeatCapacity
-   	};
+   	IsingResults results = calculateResults(data, rowCount * columnCount, boltzmannConstant, temperature, errorMethod, jackKnifeBins, bootstrapBlockLength, threadCount, generator);
+    data.profile.endPhase(RunProfile::ErrorAnalysis);
 
 /*************************************************************************************************************************
 ***********************************************  Output/Clean Up ********************************************************
 *************************************************************************************************************************/
 
-   	// Output results to file.
+   	// Output results to file, followed by where the time went.
    	resultsOutput << results << '\n';
+    resultsOutput << data.profile << '\n';
+
+    // The profile is also written as JSON so it can be read by scripts.
+    std::fstream profileOutput(outputName + "/profile.json", std::ios::out);
+    data.profile.writeJson(profileOutput);
+    profileOutput << '\n';
 
     // Output results to command line.
     std::cout << results << '\n';
@@ -0,0 +1,54 @@
+#include "parseTemperatures.hpp"
+#include <sstream>
+#include <algorithm>
+
+std::vector<double> parseTemperatures(const std::string &text)
+{
+	std::vector<double> temperatures;
+	std::istringstream stream(text);
+
+	// A range has the form min:max:count.
+	if(text.find(':') != std::string::npos)
+	{
+		double minimum, maximum;
+		int count;
+		char separator1, separator2;
+		if(!(stream >> minimum >> separator1 >> maximum >> separator2 >> count) || separator1 != ':' || separator2 != ':' || count < 1)
+		{
+			return std::vector<double>();
+		}
+
+		for(int i = 0; i < count; ++i)
+		{
+			temperatures.push_back((count == 1) ? minimum : minimum + (maximum - minimum) * i / (count - 1));
+		}
+	}
+
+	// Otherwise it's a comma separated list.
+	else
+	{
+		std::string item;
+		while(std::getline(stream, item, ','))
+		{
+			std::istringstream itemStream(item);
+			double temperature;
+			if(!(itemStream >> temperature))
+			{
+				return std::vector<double>();
+			}
+			temperatures.push_back(temperature);
+		}
+	}
+
+	// Temperatures must be positive.
+	for(const auto& temperature : temperatures)
+	{
+		if(temperature <= 0)
+		{
+			return std::vector<double>();
+		}
+	}
+
+	std::sort(temperatures.begin(), temperatures.end());
+	return temperatures;
+}
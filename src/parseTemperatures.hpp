@@ -0,0 +1,13 @@
+#ifndef parseTemperatures_hpp
+#define parseTemperatures_hpp
+#include <string>
+#include <vector>
+/**
+ *\file
+ *\brief function to parse a list or range of temperatures.
+ *\param text string that is either a comma separated list of temperatures e.g. "1.5,2.27,3" or a range
+ * "min:max:count" of count evenly spaced temperatures from min to max inclusive e.g. "1:3:21".
+ *\return vector of the temperatures sorted in increasing order, empty if the string could not be parsed.
+ */
+std::vector<double> parseTemperatures(const std::string &text);
+#endif /* parseTemperatures_hpp */
@@ -0,0 +1,161 @@
+#ifndef randomEngines_hpp
+#define randomEngines_hpp
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+#include "Xoshiro256StarStar.hpp"
+#include "Philox4x32.hpp"
+
+/**
+ *\file
+ *\brief Helpers that let the dynamics be written once for any of the random number engines.
+ *
+ * The dynamics are templates on the engine type and are instantiated for std::default_random_engine, which
+ * keeps the results of existing seeds, and for the much faster Xoshiro256StarStar and Philox4x32. Engines
+ * that return all 64 bit numbers get cheaper integer draws than the general std::uniform_int_distribution.
+ */
+
+/**
+ *\brief Whether an engine returns every 64 bit number, so its raw output can be used as a 64 bit fraction.
+ *\return true if the engine's output covers [0, 2^64).
+ */
+template<class Engine>
+constexpr bool hasFullRange64()
+{
+	return Engine::min() == 0 && Engine::max() == std::numeric_limits<std::uint64_t>::max();
+}
+
+/**
+ *\brief Draws a uniformly distributed index.
+ *
+ * For std::default_random_engine this draws exactly what a freshly constructed std::uniform_int_distribution
+ * would so existing seeds give the same results.
+ *
+ *\param generator reference to the random engine.
+ *\param count number of indices, must be positive.
+ *\return an index in [0, count).
+ */
+template<class Engine>
+inline int randomIndex(Engine &generator, int count)
+{
+	if(hasFullRange64<Engine>())
+	{
+		// Lemire's multiply-shift, the bias is below count/2^64 so there's no need to reject.
+		return static_cast<int>((static_cast<unsigned __int128>(generator()) * static_cast<unsigned int>(count)) >> 64);
+	}
+
+	std::uniform_int_distribution<int> distribution(0, count-1);
+	return distribution(generator);
+}
+
+/**
+ *\brief Fills an array with random 32 bit words for a batch of acceptance tests.
+ *
+ * For std::default_random_engine every word is one number minus min() so it lies in [0, 2^31-2), for engines
+ * that return every 64 bit number each number gives two words covering [0, 2^32). BoltzmannTable::wordThreshold
+ * gives the matching thresholds.
+ *
+ *\param generator reference to the random engine.
+ *\param first pointer to the first word to fill.
+ *\param last pointer one past the last word to fill.
+ */
+template<class Engine>
+inline void fillRandomWords(Engine &generator, std::uint32_t *first, std::uint32_t *last)
+{
+	if(hasFullRange64<Engine>())
+	{
+		for(; last - first >= 2; first += 2)
+		{
+			std::uint64_t number = generator();
+			first[0] = static_cast<std::uint32_t>(number);
+			first[1] = static_cast<std::uint32_t>(number >> 32);
+		}
+		if(first != last)
+		{
+			*first = static_cast<std::uint32_t>(generator());
+		}
+		return;
+	}
+
+	for(; first != last; ++first)
+	{
+		*first = static_cast<std::uint32_t>(generator() - generator.min());
+	}
+}
+
+/**
+ *\brief Creates an engine for a use of the random numbers identified by an index and a tag.
+ *
+ * The seeds follow std::seed_seq{seed, index, tag} used throughout, for Philox4x32 the index and tag make up
+ * the stream instead so every use has its own sequence by construction.
+ *
+ *\param seed the user seed.
+ *\param index index of the use, e.g. the replica.
+ *\param tag tag identifying the kind of use.
+ *\return the seeded engine.
+ */
+template<class Engine>
+inline Engine makeEngine(unsigned int seed, unsigned int index, unsigned int tag)
+{
+	std::seed_seq sequence{seed, index, tag};
+	return Engine(sequence);
+}
+
+template<>
+inline Philox4x32 makeEngine<Philox4x32>(unsigned int seed, unsigned int index, unsigned int tag)
+{
+	return Philox4x32(seed, (static_cast<std::uint64_t>(tag) << 32) | index);
+}
+
+/**
+ *\brief Creates a number of independent engines, e.g. one per lattice row.
+ *
+ * std::default_random_engine streams are seeded with std::seed_seq{seed, stream} as they always have been.
+ * Xoshiro256StarStar streams are made by jumping one engine so they are 2^128 numbers apart and can never
+ * overlap, and Philox4x32 streams are the streams 0, 1, ... of the seed.
+ *
+ *\param seed the user seed.
+ *\param count number of engines.
+ *\return the engines.
+ */
+template<class Engine>
+inline std::vector<Engine> makeStreams(unsigned int seed, int count)
+{
+	std::vector<Engine> streams;
+	streams.reserve(count);
+	for(int stream = 0; stream < count; ++stream)
+	{
+		std::seed_seq sequence{seed, static_cast<unsigned int>(stream)};
+		streams.emplace_back(sequence);
+	}
+	return streams;
+}
+
+template<>
+inline std::vector<Xoshiro256StarStar> makeStreams<Xoshiro256StarStar>(unsigned int seed, int count)
+{
+	std::vector<Xoshiro256StarStar> streams;
+	streams.reserve(count);
+	std::seed_seq sequence{seed};
+	Xoshiro256StarStar generator(sequence);
+	for(int stream = 0; stream < count; ++stream)
+	{
+		streams.push_back(generator);
+		generator.jump();
+	}
+	return streams;
+}
+
+template<>
+inline std::vector<Philox4x32> makeStreams<Philox4x32>(unsigned int seed, int count)
+{
+	std::vector<Philox4x32> streams;
+	streams.reserve(count);
+	for(int stream = 0; stream < count; ++stream)
+	{
+		streams.emplace_back(seed, stream);
+	}
+	return streams;
+}
+#endif /* randomEngines_hpp */
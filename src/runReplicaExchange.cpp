@@ -0,0 +1,87 @@
+#include "runReplicaExchange.hpp"
+#include "ReplicaExchange.hpp"
+#include "SimulationData.hpp"
+#include "IsingResults.hpp"
+#include "calculateResults.hpp"
+#include "writeTemperatureResults.hpp"
+#include <fstream>
+#include <cmath>
+
+void runReplicaExchange(const IsingInputParameters &params, const std::string &outputName, std::default_random_engine &generator)
+{
+	// The replicas are swept together, so every temperature shares the wall times of the ladder.
+	RunProfile profile;
+	ReplicaExchange ladder(params.rowCount, params.columnCount, params.temperatures, params.jConstant, params.boltzmannConstant, params.seed, params.threads);
+	int temperatureCount = ladder.getTemperatureCount();
+	int totalSweeps = params.burnPeriod + params.sweeps;
+
+	// One series of samples per temperature, not per replica.
+	std::vector<SimulationData> data(temperatureCount);
+	for(int i = 0; i < temperatureCount; ++i)
+	{
+		data[i].keepSamples = !params.streaming;
+		data[i].reserve(params.sweeps/params.measurementInterval);
+	}
+
+	// Measurements are made after the same sweeps as a single temperature run.
+	auto isMeasurementSweep = [&params](int sweep)
+	{
+		return (sweep >= params.burnPeriod) && ((sweep % params.measurementInterval) == 0);
+	};
+
+	profile.endPhase(RunProfile::Setup);
+
+	int completedSweeps = 0;
+	while(completedSweeps < totalSweeps)
+	{
+		// Sweep every replica concurrently up to the next swap attempt or measurement.
+		int chunk = 1;
+		while(completedSweeps + chunk < totalSweeps
+			  && (completedSweeps + chunk) % params.swapInterval != 0
+			  && !isMeasurementSweep(completedSweeps + chunk - 1))
+		{
+			++chunk;
+		}
+		ladder.sweep(chunk);
+		completedSweeps += chunk;
+		profile.endPhase(completedSweeps <= params.burnPeriod ? RunProfile::BurnIn : RunProfile::Production);
+
+		if(completedSweeps % params.swapInterval == 0)
+		{
+			ladder.attemptSwaps(generator);
+		}
+
+		if(isMeasurementSweep(completedSweeps - 1))
+		{
+			for(int i = 0; i < temperatureCount; ++i)
+			{
+				data[i].addMeasurement(ladder.lattice(i).latticeEnergy(params.jConstant), std::abs(ladder.lattice(i).totalMag()));
+			}
+			profile.endPhase(RunProfile::Measurement);
+		}
+	}
+
+	std::vector<IsingResults> results;
+	results.reserve(temperatureCount);
+	for(int i = 0; i < temperatureCount; ++i)
+	{
+		results.push_back(calculateResults(data[i], params.rowCount * params.columnCount, params.boltzmannConstant,
+										   ladder.getTemperature(i), params.errorType, params.jackKnifeBins,
+										   params.bootstrapBlockLength, params.threads, generator));
+	}
+	profile.endPhase(RunProfile::ErrorAnalysis);
+
+	long long sites = static_cast<long long>(params.rowCount) * params.columnCount;
+	for(int i = 0; i < temperatureCount; ++i)
+	{
+		data[i].profile = profile;
+		data[i].profile.addMoves(sites * totalSweeps, ladder.getAcceptedFlips(i), ladder.getAcceptedFlips(i));
+	}
+	writeTemperatureResults(outputName, params.temperatures, data, results);
+
+	std::fstream swapAcceptanceOutput(outputName + "/swapAcceptance.dat", std::ios::out);
+	for(int i = 0; i + 1 < temperatureCount; ++i)
+	{
+		swapAcceptanceOutput << ladder.getTemperature(i) << ' ' << ladder.getTemperature(i+1) << ' ' << ladder.swapAcceptanceRate(i) << '\n';
+	}
+}
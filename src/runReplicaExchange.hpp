@@ -0,0 +1,20 @@
+#ifndef runReplicaExchange_hpp
+#define runReplicaExchange_hpp
+#include <random>
+#include <string>
+#include "IsingInputParameters.hpp"
+/**
+ *\file
+ *\brief function to run a replica exchange (parallel tempering) simulation over a ladder of temperatures.
+ *\param params IsingInputParameters reference holding the simulation parameters, including the temperature
+ * ladder and the interval between swap attempts.
+ *\param outputName string holding the name of the output directory.
+ *\param generator reference to random engine used for the swap acceptance tests and bootstrap errors.
+ *
+ * The energy and magnetisation series of every temperature are written to energy-T<temperature>.dat and
+ * magnetisation-T<temperature>.dat, the acceptance rate of swaps between each neighbouring pair of temperatures
+ * to swapAcceptance.dat and the results at each temperature to results.txt and the tables TE.dat, TM.dat, TX.dat
+ * and TC.dat.
+ */
+void runReplicaExchange(const IsingInputParameters &params, const std::string &outputName, std::default_random_engine &generator);
+#endif /* runReplicaExchange_hpp */
@@ -0,0 +1,626 @@
+#include "runSimulation.hpp"
+#include "SpinLattice2D.hpp"
+#include "PackedSpinLattice2D.hpp"
+#include "ByteSpinLattice2D.hpp"
+#include "MultiStateLattice2D.hpp"
+#include "MultiStateDynamics.hpp"
+#include "CheckerboardSweeper.hpp"
+#include "TiledSweeper.hpp"
+#include "BoltzmannTable.hpp"
+#include "glauberDynamics.hpp"
+#include "KawasakiDynamics.hpp"
+#include "NFoldWayDynamics.hpp"
+#include "WolffDynamics.hpp"
+#include "SwendsenWangDynamics.hpp"
+#include "binaryIO.hpp"
+#include "randomEngines.hpp"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#ifdef ISING_USE_MPI
+#include "DistributedSpinLattice2D.hpp"
+#endif
+
+namespace
+{
+	/**
+	 *\brief Checks the running energy and magnetisation of a lattice against a full recalculation.
+	 *\param lattice the lattice to check.
+	 *\param jConstant value of the J constant.
+	 *\param sweep the current sweep, reported if the check fails.
+	 *\return true if they agree.
+	 */
+	template<class Lattice>
+	bool observablesAgree(const Lattice &lattice, double jConstant, int sweep)
+	{
+		if(lattice.latticeEnergy(jConstant) != lattice.recomputeLatticeEnergy(jConstant)
+		   || lattice.totalMag() != lattice.recomputeTotalMag())
+		{
+			std::cerr << "Running energy or magnetisation disagrees with full recalculation at sweep " << sweep << '\n';
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	 *\brief Checks the state of a loaded checkpoint was read completely.
+	 *\param state the stream the state was read from.
+	 *\return true if it was.
+	 */
+	bool stateRestored(const std::istream &state)
+	{
+		if(!state)
+		{
+			std::cerr << "The checkpoint doesn't hold the state of this simulation." << '\n';
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	 *\brief Runs the simulation of a lattice whose sweeps only need the engine, so nothing else has to be checkpointed.
+	 *
+	 * Used for the multi-spin coded, byte and multi-state lattices, the parameters are those of simulateLattice
+	 * apart from the lattice itself, which starts ordered just like the ordinary lattice, and the sweep.
+	 *
+	 *\param lattice the lattice to simulate.
+	 *\param sweepLattice callable performing one sweep of the lattice with generator and returning the number of accepted flips.
+	 */
+	template<class Lattice, class Sweep, class Engine>
+	bool simulateSweptLattice(Lattice &lattice,
+							  Sweep sweepLattice,
+							  const IsingInputParameters &params,
+							  Engine &generator,
+							  SimulationData &data,
+							  std::ostream *initialConfigOutput,
+							  std::ostream *spinsOutput,
+							  SnapshotWriter *trajectoryOutput,
+							  Checkpoint *checkpoint,
+							  bool outputLattice,
+							  bool checkObservables)
+	{
+		if(initialConfigOutput)
+		{
+			*initialConfigOutput << lattice;
+		}
+
+		// Continue from the checkpoint if there is one.
+		int firstSweep = 0;
+		if(checkpoint && checkpoint->isLoaded())
+		{
+			std::istream &state = checkpoint->state();
+			firstSweep = readValue<int>(state);
+			readEngine(state, generator);
+			data.load(state);
+			lattice.load(state);
+			if(!stateRestored(state))
+			{
+				return false;
+			}
+		}
+		data.profile.endPhase(RunProfile::Setup);
+
+		// Main loop that actually runs the simulation, each sweep proposes one flip per site.
+		int totalSites = lattice.getSize();
+		for(int sweep = firstSweep; sweep < params.burnPeriod+params.sweeps; ++sweep)
+		{
+			long long accepted = sweepLattice();
+			data.profile.addMoves(totalSites, accepted, accepted);
+			data.profile.endPhase((sweep < params.burnPeriod) ? RunProfile::BurnIn : RunProfile::Production);
+
+			// If we are out of the burn period and on a measurement sweep then make any measurements.
+			if((sweep >= params.burnPeriod) && ((sweep % params.measurementInterval) == 0))
+			{
+				if(checkObservables && !observablesAgree(lattice, params.jConstant, sweep))
+				{
+					return false;
+				}
+
+				data.addMeasurement(lattice.latticeEnergy(params.jConstant), std::abs(lattice.totalMag()));
+				data.profile.endPhase(RunProfile::Measurement);
+				if(trajectoryOutput)
+				{
+					trajectoryOutput->write(lattice, sweep);
+					data.profile.endPhase(RunProfile::Output);
+				}
+			}
+
+			// If the user plans to animate the configuration then output it here.
+			if(spinsOutput && outputLattice && ((sweep % params.measurementInterval) == 0))
+			{
+				spinsOutput->seekp(0,std::ios::beg);
+				*spinsOutput << lattice << std::flush;
+				data.profile.endPhase(RunProfile::Output);
+			}
+
+			// Save everything needed to carry on from the next sweep.
+			if(checkpoint && checkpoint->due(sweep+1))
+			{
+				std::ostringstream state;
+				writeValue(state, sweep+1);
+				writeEngine(state, generator);
+				data.save(state);
+				lattice.save(state);
+				checkpoint->save(params, state.str());
+				data.profile.endPhase(RunProfile::Output);
+			}
+		}
+
+		// Print the final configuration so it can be reused in future.
+		if(spinsOutput)
+		{
+			spinsOutput->seekp(0,std::ios::beg);
+			*spinsOutput << lattice << std::flush;
+		}
+		data.profile.endPhase(RunProfile::Output);
+		return true;
+	}
+
+	/**
+	 *\brief Runs the simulation of a multi-state lattice of a model with Metropolis dynamics.
+	 *
+	 * The parameters are those of simulateLattice apart from the table of acceptance thresholds, which the
+	 * dynamics build for the model.
+	 */
+	template<class Model, class Engine>
+	bool simulateMultiStateLattice(const IsingInputParameters &params,
+								   Engine &generator,
+								   SimulationData &data,
+								   std::ostream *initialConfigOutput,
+								   std::ostream *spinsOutput,
+								   Checkpoint *checkpoint,
+								   bool outputLattice,
+								   bool checkObservables)
+	{
+		MultiStateLattice2D<Model> lattice(params.rowCount, params.columnCount);
+		MultiStateDynamics<Model> dynamics(params.jConstant, params.boltzmannConstant, params.temperature);
+		return simulateSweptLattice(lattice, [&]() { return dynamics.sweep(lattice, generator); }, params, generator, data,
+									initialConfigOutput, spinsOutput, nullptr, checkpoint, outputLattice, checkObservables);
+	}
+
+	/**
+	 *\brief Runs the simulation of the Potts or spin-S model and number of states chosen by the parameters.
+	 *
+	 * The number of states is a template parameter of the lattice and dynamics so each one that can be chosen
+	 * is compiled separately. The parameters are those of simulateMultiStateLattice.
+	 */
+	template<class Engine>
+	bool simulateSpinModel(const IsingInputParameters &params,
+						   Engine &generator,
+						   SimulationData &data,
+						   std::ostream *initialConfigOutput,
+						   std::ostream *spinsOutput,
+						   Checkpoint *checkpoint,
+						   bool outputLattice,
+						   bool checkObservables)
+	{
+		if(params.spinModel == IsingInputParameters::Potts)
+		{
+			switch(params.spinStates)
+			{
+				case 2: return simulateMultiStateLattice<PottsModel<2>>(params, generator, data, initialConfigOutput, spinsOutput, checkpoint, outputLattice, checkObservables);
+				case 3: return simulateMultiStateLattice<PottsModel<3>>(params, generator, data, initialConfigOutput, spinsOutput, checkpoint, outputLattice, checkObservables);
+				case 4: return simulateMultiStateLattice<PottsModel<4>>(params, generator, data, initialConfigOutput, spinsOutput, checkpoint, outputLattice, checkObservables);
+				case 5: return simulateMultiStateLattice<PottsModel<5>>(params, generator, data, initialConfigOutput, spinsOutput, checkpoint, outputLattice, checkObservables);
+				case 6: return simulateMultiStateLattice<PottsModel<6>>(params, generator, data, initialConfigOutput, spinsOutput, checkpoint, outputLattice, checkObservables);
+				case 7: return simulateMultiStateLattice<PottsModel<7>>(params, generator, data, initialConfigOutput, spinsOutput, checkpoint, outputLattice, checkObservables);
+				case 8: return simulateMultiStateLattice<PottsModel<8>>(params, generator, data, initialConfigOutput, spinsOutput, checkpoint, outputLattice, checkObservables);
+			}
+		}
+		else
+		{
+			switch(params.spinStates)
+			{
+				case 2: return simulateMultiStateLattice<SpinSModel<2>>(params, generator, data, initialConfigOutput, spinsOutput, checkpoint, outputLattice, checkObservables);
+				case 3: return simulateMultiStateLattice<SpinSModel<3>>(params, generator, data, initialConfigOutput, spinsOutput, checkpoint, outputLattice, checkObservables);
+				case 4: return simulateMultiStateLattice<SpinSModel<4>>(params, generator, data, initialConfigOutput, spinsOutput, checkpoint, outputLattice, checkObservables);
+				case 5: return simulateMultiStateLattice<SpinSModel<5>>(params, generator, data, initialConfigOutput, spinsOutput, checkpoint, outputLattice, checkObservables);
+			}
+		}
+
+		std::cerr << "There is no lattice compiled for " << params.spinStates << " states." << '\n';
+		return false;
+	}
+
+	/**
+	 *\brief Gets the byte lattice kernel chosen by the parameters.
+	 *\param params the parameters, vectorKernel must not be NoVectorKernel.
+	 *\return the kernel.
+	 */
+	ByteSpinLattice2D::Kernel byteLatticeKernel(const IsingInputParameters &params)
+	{
+		switch(params.vectorKernel)
+		{
+			case IsingInputParameters::Avx512Kernel:
+				return ByteSpinLattice2D::Avx512;
+			case IsingInputParameters::Avx2Kernel:
+				return ByteSpinLattice2D::Avx2;
+			default:
+				return ByteSpinLattice2D::Scalar;
+		}
+	}
+
+	/**
+	 *\brief Runs the simulation of a multi-state, multi-spin coded, byte or standard lattice with the dynamics using a given engine.
+	 *
+	 * The parameters are those of runSimulation apart from the engine and the table of acceptance thresholds.
+	 */
+	template<class Engine>
+	bool simulateLattice(const IsingInputParameters &params,
+						 Engine &generator,
+						 const BoltzmannTable &boltzmannTable,
+						 SimulationData &data,
+						 std::ostream *initialConfigOutput,
+						 std::ostream *spinsOutput,
+						 SnapshotWriter *trajectoryOutput,
+						 Checkpoint *checkpoint,
+						 bool outputLattice,
+						 bool checkObservables)
+	{
+		if(params.spinModel != IsingInputParameters::Ising)
+		{
+			return simulateSpinModel(params, generator, data, initialConfigOutput, spinsOutput, checkpoint, outputLattice, checkObservables);
+		}
+
+		if(params.multiSpinCoding)
+		{
+			PackedSpinLattice2D packedLattice(params.rowCount, params.columnCount);
+			return simulateSweptLattice(packedLattice, [&]() { return packedLattice.sweep(generator, boltzmannTable); }, params, generator, data,
+										initialConfigOutput, spinsOutput, trajectoryOutput, checkpoint, outputLattice, checkObservables);
+		}
+
+		if(params.vectorKernel != IsingInputParameters::NoVectorKernel)
+		{
+			ByteSpinLattice2D byteLattice(params.rowCount, params.columnCount, byteLatticeKernel(params));
+			return simulateSweptLattice(byteLattice, [&]() { return byteLattice.sweep(generator, boltzmannTable); }, params, generator, data,
+										initialConfigOutput, spinsOutput, trajectoryOutput, checkpoint, outputLattice, checkObservables);
+		}
+
+		// Number of Wolff clusters flipped per sweep after the burn period. It must not depend on the sizes of
+		// the clusters being flipped or the measured configurations would be biased towards those after large
+		// clusters, so it is fixed from the mean cluster size during the burn period.
+		long long clustersPerSweep = 1;
+		int totalSites = params.rowCount * params.columnCount;
+
+		// Create the lattice of spins.
+		SpinLattice2D spinLattice(params.rowCount, params.columnCount);
+
+		// Set lattice if Kawasaki dynamics is being used, otherwise keep it aligned.
+		if(params.dynamics == IsingInputParameters::Kawasaki)
+		{
+			// If the temperature is low we can set the lattice in the ground state.
+			if(params.temperature < 1.5)
+			{
+				spinLattice.setEvenSpins();
+			}
+
+			// Otherwise have it random.
+			else
+			{
+				spinLattice.randomise(generator);
+			}
+		}
+		if(initialConfigOutput)
+		{
+			*initialConfigOutput << spinLattice;
+		}
+
+		// Each row of the checkerboard gets its own random number stream so results don't depend on the threads.
+		CheckerboardSweeper<Engine> checkerboardSweeper(params.rowCount, params.seed, params.threads);
+
+		// The tiled order is fixed so the sweeper only holds the tile size.
+		TiledSweeper tiledSweeper(params.tileSize);
+
+		// The Wolff cluster stack is as large as the lattice so is only allocated if it is used.
+		std::unique_ptr<WolffDynamics> wolffDynamics;
+		if(params.dynamics == IsingInputParameters::Wolff)
+		{
+			wolffDynamics.reset(new WolffDynamics(spinLattice, params.jConstant, params.boltzmannConstant, params.temperature));
+		}
+
+		// Swendsen-Wang has its own random number stream per row and cluster labels as large as the lattice, so
+		// they are only allocated if they are used.
+		std::unique_ptr<SwendsenWangDynamics> swendsenWangDynamics;
+		if(params.dynamics == IsingInputParameters::SwendsenWang)
+		{
+			swendsenWangDynamics.reset(new SwendsenWangDynamics(spinLattice, params.jConstant, params.boltzmannConstant, params.temperature, params.seed, params.threads));
+		}
+
+		// The Kawasaki site or bond sets are as large as the lattice so are only built if they are used, tiled
+		// sweeps visit the bonds in order so don't need them.
+		std::unique_ptr<KawasakiDynamics> kawasakiDynamics;
+		if(params.dynamics == IsingInputParameters::Kawasaki && !params.tiled)
+		{
+			kawasakiDynamics.reset(new KawasakiDynamics(spinLattice, params.localExchange, params.jConstant, params.boltzmannConstant, params.temperature));
+		}
+
+		// As are the n-fold way classes.
+		std::unique_ptr<NFoldWayDynamics> nFoldWayDynamics;
+		if(params.nFoldWay)
+		{
+			nFoldWayDynamics.reset(new NFoldWayDynamics(spinLattice, boltzmannTable));
+		}
+
+		// Continue from the checkpoint if there is one.
+		int firstSweep = 0;
+		if(checkpoint && checkpoint->isLoaded())
+		{
+			std::istream &state = checkpoint->state();
+			firstSweep = readValue<int>(state);
+			readEngine(state, generator);
+			data.load(state);
+			spinLattice.load(state);
+			checkerboardSweeper.load(state);
+			if(swendsenWangDynamics)
+			{
+				swendsenWangDynamics->load(state);
+			}
+			clustersPerSweep = readValue<long long>(state);
+			if(kawasakiDynamics)
+			{
+				kawasakiDynamics->load(state);
+			}
+			if(nFoldWayDynamics)
+			{
+				nFoldWayDynamics->load(state);
+			}
+			if(!stateRestored(state))
+			{
+				return false;
+			}
+		}
+		data.profile.endPhase(RunProfile::Setup);
+
+		// Main loop that actually runs the simulation.
+		for(int sweep = firstSweep; sweep < params.burnPeriod+params.sweeps; ++sweep)
+		{
+			// 1 sweep = #col x #row = total #sites proposed flips.
+			if(params.checkerboard)
+			{
+				long long accepted = checkerboardSweeper.sweep(spinLattice, boltzmannTable);
+				data.profile.addMoves(totalSites, accepted, accepted);
+			}
+			else if(params.tiled && params.dynamics == IsingInputParameters::Kawasaki)
+			{
+				// Every site proposes a swap with its right and lower neighbours.
+				long long accepted = tiledSweeper.kawasakiSweep(spinLattice, generator, boltzmannTable);
+				data.profile.addMoves(2 * static_cast<long long>(totalSites), accepted, 2 * accepted);
+			}
+			else if(params.tiled)
+			{
+				long long accepted = tiledSweeper.glauberSweep(spinLattice, generator, boltzmannTable);
+				data.profile.addMoves(totalSites, accepted, accepted);
+			}
+			else if(swendsenWangDynamics)
+			{
+				// One move updates every cluster.
+				data.profile.addMoves(1, 1, swendsenWangDynamics->update(spinLattice));
+			}
+			else if(wolffDynamics)
+			{
+				// During the burn period flip clusters until every site has been flipped once on average,
+				// afterwards flip the fixed number of clusters that does this on average.
+				long long sweepClusterSize = 0;
+				long long sweepClusters = 0;
+				while((sweep < params.burnPeriod) ? (sweepClusterSize < totalSites) : (sweepClusters < clustersPerSweep))
+				{
+					sweepClusterSize += wolffDynamics->update(spinLattice, generator);
+					++sweepClusters;
+				}
+
+				data.totalClusterSize += sweepClusterSize;
+				data.totalClusters += sweepClusters;
+				data.profile.addMoves(sweepClusters, sweepClusters, sweepClusterSize);
+				if(sweep < params.burnPeriod)
+				{
+					if(sweep == params.burnPeriod-1)
+					{
+						clustersPerSweep = std::max(1LL, std::llround(static_cast<double>(totalSites) * data.totalClusters / data.totalClusterSize));
+						data.totalClusterSize = 0;
+						data.totalClusters = 0;
+					}
+				}
+				else if((sweep % params.measurementInterval) == 0)
+				{
+					data.clusterSizeStatistics.push_back(static_cast<double>(sweepClusterSize)/sweepClusters);
+				}
+			}
+			else if(nFoldWayDynamics)
+			{
+				// Flip spins until the clock reaches the end of this sweep, the lattice is then measured at a
+				// fixed physical time.
+				// Every step of the n-fold way is a flip.
+				long long flips = nFoldWayDynamics->advance(spinLattice, generator, sweep + 1.0);
+				data.profile.addMoves(flips, flips, flips);
+			}
+			else if(kawasakiDynamics)
+			{
+				long long accepted = 0;
+				for(int site = 0; site < totalSites; ++site)
+				{
+					accepted += kawasakiDynamics->update(spinLattice, generator, boltzmannTable);
+				}
+				data.profile.addMoves(totalSites, accepted, 2 * accepted);
+			}
+			else
+			{
+				long long accepted = 0;
+				for(int site = 0; site < totalSites; ++site)
+				{
+					accepted += glauberDynamics(spinLattice, generator, boltzmannTable);
+				}
+				data.profile.addMoves(totalSites, accepted, accepted);
+			}
+			data.profile.endPhase((sweep < params.burnPeriod) ? RunProfile::BurnIn : RunProfile::Production);
+
+			// If we are out of the burn period and on a measurement sweep then make any measurements.
+			if((sweep >= params.burnPeriod) && ((sweep % params.measurementInterval) == 0))
+			{
+				if(checkObservables && !observablesAgree(spinLattice, params.jConstant, sweep))
+				{
+					return false;
+				}
+
+				data.addMeasurement(spinLattice.latticeEnergy(params.jConstant), std::abs(spinLattice.totalMag()));
+				data.profile.endPhase(RunProfile::Measurement);
+				if(trajectoryOutput)
+				{
+					trajectoryOutput->write(spinLattice, sweep);
+					data.profile.endPhase(RunProfile::Output);
+				}
+			}
+
+			// If the user plans to animate the configuration then output it here.
+			if(spinsOutput && outputLattice && ((sweep % params.measurementInterval) == 0))
+			{
+				spinsOutput->seekp(0,std::ios::beg);
+				*spinsOutput << spinLattice << std::flush;
+				data.profile.endPhase(RunProfile::Output);
+			}
+
+			// Save everything needed to carry on from the next sweep.
+			if(checkpoint && checkpoint->due(sweep+1))
+			{
+				std::ostringstream state;
+				writeValue(state, sweep+1);
+				writeEngine(state, generator);
+				data.save(state);
+				spinLattice.save(state);
+				checkerboardSweeper.save(state);
+				if(swendsenWangDynamics)
+				{
+					swendsenWangDynamics->save(state);
+				}
+				writeValue(state, clustersPerSweep);
+				if(kawasakiDynamics)
+				{
+					kawasakiDynamics->save(state);
+				}
+				if(nFoldWayDynamics)
+				{
+					nFoldWayDynamics->save(state);
+				}
+				checkpoint->save(params, state.str());
+				data.profile.endPhase(RunProfile::Output);
+			}
+		}
+
+		// Print the final configuration so it can be reused in future.
+		if(spinsOutput)
+		{
+			spinsOutput->seekp(0,std::ios::beg);
+			*spinsOutput << spinLattice << std::flush;
+		}
+		data.profile.endPhase(RunProfile::Output);
+		return true;
+	}
+}
+
+bool runSimulation(const IsingInputParameters &params,
+				   std::default_random_engine &generator,
+				   SimulationData &data,
+				   std::ostream *initialConfigOutput,
+				   std::ostream *spinsOutput,
+				   SnapshotWriter *trajectoryOutput,
+				   Checkpoint *checkpoint,
+				   bool outputLattice,
+				   bool checkObservables)
+{
+	// Work out the number of samples we need.
+	int totalSamples = params.sweeps/params.measurementInterval;
+
+	// The acceptance thresholds only depend on the temperature so are built once.
+	BoltzmannTable boltzmannTable(params.jConstant, params.boltzmannConstant, params.temperature);
+
+	// Since we know how many samples we will take faster to reserve the space before hand, unless only the
+	// streaming statistics are kept.
+	data.keepSamples = !params.streaming;
+	data.reserve(totalSamples);
+
+#ifdef ISING_USE_MPI
+	if(params.distributed)
+	{
+		// Every rank holds one strip of the lattice, gathering and the measurements are collective so every rank
+		// takes part even though only rank 0 has output streams.
+		DistributedSpinLattice2D distributedLattice(params.rowCount, params.columnCount, params.seed, MPI_COMM_WORLD);
+		SpinLattice2D gatheredLattice(params.rowCount, params.columnCount);
+		if(initialConfigOutput)
+		{
+			*initialConfigOutput << gatheredLattice;
+		}
+		data.profile.endPhase(RunProfile::Setup);
+
+		// The flips accepted on this rank, summed over the ranks at the end.
+		long long accepted = 0;
+		for(int sweep = 0; sweep < params.burnPeriod+params.sweeps; ++sweep)
+		{
+			accepted += distributedLattice.sweep(boltzmannTable);
+			data.profile.endPhase((sweep < params.burnPeriod) ? RunProfile::BurnIn : RunProfile::Production);
+
+			// If we are out of the burn period and on a measurement sweep then make any measurements.
+			if((sweep >= params.burnPeriod) && ((sweep % params.measurementInterval) == 0))
+			{
+				if(checkObservables && !observablesAgree(distributedLattice, params.jConstant, sweep))
+				{
+					return false;
+				}
+
+				data.addMeasurement(distributedLattice.latticeEnergy(params.jConstant), std::abs(distributedLattice.totalMag()));
+				data.profile.endPhase(RunProfile::Measurement);
+
+				// Gathering is collective so every rank takes part if the trajectory is being recorded.
+				if(params.trajectory)
+				{
+					distributedLattice.gather(gatheredLattice);
+					if(trajectoryOutput)
+					{
+						trajectoryOutput->write(gatheredLattice, sweep);
+					}
+					data.profile.endPhase(RunProfile::Output);
+				}
+			}
+
+			// If the user plans to animate the configuration then output it here.
+			if(outputLattice && ((sweep % params.measurementInterval) == 0))
+			{
+				distributedLattice.gather(gatheredLattice);
+				if(spinsOutput)
+				{
+					spinsOutput->seekp(0,std::ios::beg);
+					*spinsOutput << gatheredLattice << std::flush;
+				}
+				data.profile.endPhase(RunProfile::Output);
+			}
+		}
+
+		// Print the final configuration so it can be reused in future.
+		distributedLattice.gather(gatheredLattice);
+		if(spinsOutput)
+		{
+			spinsOutput->seekp(0,std::ios::beg);
+			*spinsOutput << gatheredLattice << std::flush;
+		}
+		data.profile.endPhase(RunProfile::Output);
+
+		long long totalAccepted = 0;
+		MPI_Allreduce(&accepted, &totalAccepted, 1, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+		long long attempted = static_cast<long long>(params.rowCount) * params.columnCount * (params.burnPeriod + params.sweeps);
+		data.profile.addMoves(attempted, totalAccepted, totalAccepted);
+		return true;
+	}
+#endif
+
+	// Only the lattice dynamics use the chosen engine, it is another stream of the seed so runs with the
+	// standard engine keep using the caller's generator and give the same results as they always have.
+	if(params.randomEngine == IsingInputParameters::Xoshiro)
+	{
+		Xoshiro256StarStar engine = makeEngine<Xoshiro256StarStar>(params.seed, 0, 4u);
+		return simulateLattice(params, engine, boltzmannTable, data, initialConfigOutput, spinsOutput, trajectoryOutput, checkpoint, outputLattice, checkObservables);
+	}
+	if(params.randomEngine == IsingInputParameters::Philox)
+	{
+		Philox4x32 engine = makeEngine<Philox4x32>(params.seed, 0, 4u);
+		return simulateLattice(params, engine, boltzmannTable, data, initialConfigOutput, spinsOutput, trajectoryOutput, checkpoint, outputLattice, checkObservables);
+	}
+	return simulateLattice(params, generator, boltzmannTable, data, initialConfigOutput, spinsOutput, trajectoryOutput, checkpoint, outputLattice, checkObservables);
+}
@@ -0,0 +1,42 @@
+#ifndef runSimulation_hpp
+#define runSimulation_hpp
+#include <random>
+#include <iostream>
+#include "IsingInputParameters.hpp"
+#include "SimulationData.hpp"
+#include "SnapshotWriter.hpp"
+#include "Checkpoint.hpp"
+/**
+ *\file
+ *\brief function to run the simulation of a lattice at a single temperature.
+ *\param params IsingInputParameters reference holding the simulation parameters.
+ *\param generator reference to random engine used by the dynamics.
+ *\param data SimulationData reference that the measurements are added to.
+ *\param initialConfigOutput pointer to stream the initial configuration is printed to, may be null.
+ *\param spinsOutput pointer to stream the final configuration is printed to, may be null.
+ *\param trajectoryOutput pointer to the SnapshotWriter every measured configuration is recorded with, may be null.
+ *\param checkpoint pointer to the Checkpoint the state is periodically saved with, may be null. If it has been
+ * loaded the simulation continues from the saved state instead of starting again.
+ *\param outputLattice if true the configuration is also printed to spinsOutput every measurement interval for animation.
+ *\param checkObservables if true the running energy and magnetisation are checked against a full recalculation
+ * at every measurement.
+ *\return false if a check of the running energy and magnetisation failed, true otherwise.
+ *
+ * Checkerboard sweeps and Swendsen-Wang dynamics use random number engines seeded from params.seed so the
+ * results are reproducible for any number of threads. The generator is only used by the dynamics if
+ * params.randomEngine is the standard engine, otherwise they use a Xoshiro256StarStar or Philox4x32 engine
+ * seeded from params.seed. Checkpoints are not supported for the distributed lattice. If params.distributed is set (only in the MPI build) the
+ * lattice is split across the ranks of MPI_COMM_WORLD and every rank must call this, only rank 0 needs to pass
+ * output streams and all ranks must agree on outputLattice and checkObservables. Every rank gathers the lattice
+ * to record it if params.trajectory is set.
+ */
+bool runSimulation(const IsingInputParameters &params,
+				   std::default_random_engine &generator,
+				   SimulationData &data,
+				   std::ostream *initialConfigOutput,
+				   std::ostream *spinsOutput,
+				   SnapshotWriter *trajectoryOutput,
+				   Checkpoint *checkpoint,
+				   bool outputLattice,
+				   bool checkObservables);
+#endif /* runSimulation_hpp */
@@ -0,0 +1,88 @@
+#include "runTemperatureBatch.hpp"
+#include "ThreadPool.hpp"
+#include "SimulationData.hpp"
+#include "IsingResults.hpp"
+#include "runSimulation.hpp"
+#include "calculateResults.hpp"
+#include "writeTemperatureResults.hpp"
+#include "BoltzmannTable.hpp"
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+namespace
+{
+	/**
+	 *\brief Estimates the relative time taken to simulate and analyse one temperature of the ladder.
+	 *
+	 * Every temperature does the same number of sweeps so the difference is in the work done per sweep, which
+	 * is dominated by the number of accepted flips and grows with the temperature. The probability of accepting
+	 * a flip that breaks two bonds is used as a measure of this, fitted to timings of all the dynamics.
+	 *
+	 *\param params IsingInputParameters reference holding the simulation parameters.
+	 *\param temperature the temperature to estimate the cost of.
+	 *\return relative cost, larger is more expensive.
+	 */
+	double estimatedCost(const IsingInputParameters &params, double temperature)
+	{
+		BoltzmannTable boltzmannTable(params.jConstant, params.boltzmannConstant, temperature);
+		return 1.0 + 2.5 * boltzmannTable.probability(2);
+	}
+}
+
+bool runTemperatureBatch(const IsingInputParameters &params, const std::string &outputName, bool checkObservables)
+{
+	int temperatureCount = static_cast<int>(params.temperatures.size());
+	std::vector<SimulationData> data(temperatureCount);
+	std::vector<IsingResults> results(temperatureCount);
+
+	// Flags are chars since std::vector<bool> can't be written to safely from different threads.
+	std::vector<char> succeeded(temperatureCount, 0);
+
+	// Submit the most expensive temperatures first.
+	std::vector<int> order(temperatureCount);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&params](int a, int b)
+	{
+		return estimatedCost(params, params.temperatures[a]) > estimatedCost(params, params.temperatures[b]);
+	});
+
+	{
+		ThreadPool pool(params.threads);
+		for(int index : order)
+		{
+			pool.submit([&params, &data, &results, &succeeded, index, checkObservables]()
+			{
+				// Each temperature is an ordinary single threaded run with its own seed.
+				IsingInputParameters pointParams = params;
+				pointParams.temperature = params.temperatures[index];
+				pointParams.threads = 1;
+				std::seed_seq sequence{params.seed, static_cast<unsigned int>(index), 3u};
+				std::vector<unsigned int> pointSeed(1);
+				sequence.generate(pointSeed.begin(), pointSeed.end());
+				pointParams.seed = pointSeed[0];
+				std::default_random_engine generator(pointParams.seed);
+
+				// The profile starts once a thread picks the temperature up rather than when it was queued.
+				data[index].profile = RunProfile();
+				if(runSimulation(pointParams, generator, data[index], nullptr, nullptr, nullptr, nullptr, false, checkObservables))
+				{
+					results[index] = calculateResults(data[index], params.rowCount * params.columnCount, params.boltzmannConstant,
+													  pointParams.temperature, params.errorType, params.jackKnifeBins,
+													  params.bootstrapBlockLength, pointParams.threads, generator);
+					data[index].profile.endPhase(RunProfile::ErrorAnalysis);
+					succeeded[index] = 1;
+				}
+			});
+		}
+		pool.wait();
+	}
+
+	if(std::find(succeeded.begin(), succeeded.end(), 0) != succeeded.end())
+	{
+		return false;
+	}
+
+	writeTemperatureResults(outputName, params.temperatures, data, results);
+	return true;
+}
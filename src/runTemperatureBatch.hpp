@@ -0,0 +1,22 @@
+#ifndef runTemperatureBatch_hpp
+#define runTemperatureBatch_hpp
+#include <string>
+#include "IsingInputParameters.hpp"
+/**
+ *\file
+ *\brief function to run independent simulations at every temperature of a ladder inside one process.
+ *\param params IsingInputParameters reference holding the simulation parameters, including the temperature ladder
+ * and the number of threads.
+ *\param outputName string holding the name of the output directory.
+ *\param checkObservables if true the running energy and magnetisation are checked against a full recalculation
+ * at every measurement.
+ *\return false if a check of the running energy and magnetisation failed, true otherwise.
+ *
+ * Every temperature is simulated and analysed as a task on a work stealing ThreadPool with params.threads workers.
+ * The temperatures expected to take longest, the hottest since they accept the most flips per sweep, are
+ * submitted first so they are not left running on their own at the end. Each temperature has its own random number engine seeded
+ * from params.seed and its index in the ladder, so the results don't depend on the number of threads. The output
+ * is written with writeTemperatureResults.
+ */
+bool runTemperatureBatch(const IsingInputParameters &params, const std::string &outputName, bool checkObservables);
+#endif /* runTemperatureBatch_hpp */
@@ -0,0 +1,165 @@
+#ifndef spinModels_hpp
+#define spinModels_hpp
+#include <cmath>
+
+/**
+ *\file
+ *\brief Models of spins with a fixed number of states for MultiStateLattice2D and MultiStateDynamics.
+ *
+ * Every model gives each site one of states states, numbered 0 to states-1, and gives each bond an integer
+ * value so the energy of the lattice is E = -J * energyScale() * Sum_{all bonds} bond(s_site, s_neighbour).
+ * The number of states is a template parameter so the lattice and dynamics are compiled separately for each
+ * model and the bond values and proposals become constants, the two state spin-S model (spin-1/2) compiles to
+ * the same code as ordinary Ising Glauber dynamics.
+ */
+
+/**
+ *\brief The q-state Potts model, E = -J * Sum_{all bonds} delta(s_site, s_neighbour).
+ *
+ * The magnetisation is the length of the sum over sites of the unit vectors at angle 2 pi s / q, which for
+ * q = 2 is the Ising magnetisation.
+ */
+template<int States>
+struct PottsModel
+{
+	static_assert(States >= 2 && States <= 255, "A Potts spin has between 2 and 255 states.");
+
+	/// Number of states of each spin.
+	static constexpr int states = States;
+
+	/// Largest magnitude of the change in the bond sum from changing one site.
+	static constexpr int maxBondChange = 4;
+
+	/**
+	 *\brief Gets the value of a bond.
+	 *\param a state of one end of the bond.
+	 *\param b state of the other end.
+	 *\return 1 if the states are equal, otherwise 0.
+	 */
+	static constexpr int bond(int a, int b) { return a == b ? 1 : 0; }
+
+	/**
+	 *\brief Gets the change in the bond sum from changing a site from one state to another.
+	 *\param from the current state of the site.
+	 *\param to the proposed state of the site.
+	 *\param up state of the neighbour above.
+	 *\param down state of the neighbour below.
+	 *\param left state of the neighbour to the left.
+	 *\param right state of the neighbour to the right.
+	 *\return the change in the bond sum.
+	 */
+	static int bondChange(int from, int to, int up, int down, int left, int right)
+	{
+		return (up == to) + (down == to) + (left == to) + (right == to) - (up == from) - (down == from) - (left == from) - (right == from);
+	}
+
+	/**
+	 *\brief Energy of a bond of value 1 in units of -J.
+	 */
+	static constexpr double energyScale() { return 1.0; }
+
+	/**
+	 *\brief Gets the magnetisation from the number of sites in each state.
+	 *\param counts the number of sites in each state.
+	 *\return the magnetisation, never negative.
+	 */
+	static double magnetisation(const int *counts)
+	{
+		const double pi = std::acos(-1.0);
+		double x = 0;
+		double y = 0;
+		for(int state = 0; state < States; ++state)
+		{
+			// Directions along the axes are snapped to them so the magnetisations for q = 2 and 4 are exact.
+			double angle = 2.0 * pi * state / States;
+			double cosine = std::cos(angle);
+			double sine = std::sin(angle);
+			x += counts[state] * (std::abs(cosine) < 1e-12 ? 0.0 : cosine);
+			y += counts[state] * (std::abs(sine) < 1e-12 ? 0.0 : sine);
+		}
+		return std::sqrt(x * x + y * y);
+	}
+
+	/**
+	 *\brief Gets the value printed for a state.
+	 *\param state the state.
+	 *\return the state itself.
+	 */
+	static constexpr int printedValue(int state) { return state; }
+};
+
+/**
+ *\brief The spin-S Ising model with 2S + 1 states, E = -J * Sum_{all bonds} s_site * s_neighbour with s = m / S.
+ *
+ * The spin m of state k is k - S, so s runs from -1 to 1 in steps of 1/S and spin-1/2 is the Ising model.
+ * Bonds are stored as the integer 2m * 2m' so the energy scale is 1/(2S)^2. The magnetisation is Sum s.
+ */
+template<int States>
+struct SpinSModel
+{
+	static_assert(States >= 2 && States <= 16, "A spin-S spin has between 2 and 16 states, the acceptance table grows with the square.");
+
+	/// Number of states of each spin.
+	static constexpr int states = States;
+
+	/// Largest magnitude of the change in the bond sum from changing one site.
+	static constexpr int maxBondChange = 8 * (States - 1) * (States - 1);
+
+	/**
+	 *\brief Gets twice the spin of a state, an integer.
+	 *\param state the state.
+	 *\return 2m.
+	 */
+	static constexpr int value(int state) { return 2 * state - (States - 1); }
+
+	/**
+	 *\brief Gets the value of a bond.
+	 *\param a state of one end of the bond.
+	 *\param b state of the other end.
+	 *\return 2m_a * 2m_b.
+	 */
+	static constexpr int bond(int a, int b) { return value(a) * value(b); }
+
+	/**
+	 *\brief Gets the change in the bond sum from changing a site from one state to another.
+	 *\param from the current state of the site.
+	 *\param to the proposed state of the site.
+	 *\param up state of the neighbour above.
+	 *\param down state of the neighbour below.
+	 *\param left state of the neighbour to the left.
+	 *\param right state of the neighbour to the right.
+	 *\return the change in the bond sum.
+	 */
+	static int bondChange(int from, int to, int up, int down, int left, int right)
+	{
+		return (value(to) - value(from)) * (value(up) + value(down) + value(left) + value(right));
+	}
+
+	/**
+	 *\brief Energy of a bond of value 1 in units of -J.
+	 */
+	static constexpr double energyScale() { return 1.0 / ((States - 1) * (States - 1)); }
+
+	/**
+	 *\brief Gets the magnetisation from the number of sites in each state.
+	 *\param counts the number of sites in each state.
+	 *\return the magnetisation.
+	 */
+	static double magnetisation(const int *counts)
+	{
+		long long sum = 0;
+		for(int state = 0; state < States; ++state)
+		{
+			sum += static_cast<long long>(counts[state]) * value(state);
+		}
+		return static_cast<double>(sum) / (States - 1);
+	}
+
+	/**
+	 *\brief Gets the value printed for a state.
+	 *\param state the state.
+	 *\return 2m, which for spin-1/2 is the +1 or -1 of the Ising lattice.
+	 */
+	static constexpr int printedValue(int state) { return value(state); }
+};
+#endif /* spinModels_hpp */
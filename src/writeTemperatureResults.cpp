@@ -0,0 +1,40 @@
+#include "writeTemperatureResults.hpp"
+#include "writeTemperatureTables.hpp"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+void writeTemperatureResults(const std::string &directory,
+							 const std::vector<double> &temperatures,
+							 const std::vector<SimulationData> &data,
+							 const std::vector<IsingResults> &results)
+{
+	std::fstream resultsOutput(directory + "/results.txt", std::ios::out);
+
+	// The profile of every temperature is also written as JSON so it can be read by scripts.
+	std::fstream profileOutput(directory + "/profile.json", std::ios::out);
+	profileOutput << "[\n";
+
+	for(int i = 0; i < static_cast<int>(temperatures.size()); ++i)
+	{
+		std::ostringstream suffix;
+		suffix << "-T" << temperatures[i] << ".dat";
+		std::fstream energyDataOutput(directory + "/energy" + suffix.str(), std::ios::out);
+		std::fstream magnetisationDataOutput(directory + "/magnetisation" + suffix.str(), std::ios::out);
+		energyDataOutput << data[i].energyData;
+		magnetisationDataOutput << data[i].magnetisationData;
+
+		resultsOutput << std::setw(30) << std::setfill(' ') << std::left << "Temperature: " << std::right << temperatures[i] << '\n';
+		resultsOutput << results[i] << '\n';
+		resultsOutput << data[i].profile << '\n';
+		profileOutput << "\t{\n\t\t\"temperature\": " << temperatures[i] << ",\n\t\t\"profile\": ";
+		data[i].profile.writeJson(profileOutput, 3);
+		profileOutput << "\n\t}" << ((i + 1 < static_cast<int>(temperatures.size())) ? "," : "") << '\n';
+		std::cout << std::setw(30) << std::setfill(' ') << std::left << "Temperature: " << std::right << temperatures[i] << '\n';
+		std::cout << results[i] << '\n';
+	}
+
+	profileOutput << "]\n";
+
+	writeTemperatureTables(directory, temperatures, results);
+}
@@ -0,0 +1,24 @@
+#ifndef writeTemperatureResults_hpp
+#define writeTemperatureResults_hpp
+#include <string>
+#include <vector>
+#include "SimulationData.hpp"
+#include "IsingResults.hpp"
+/**
+ *\file
+ *\brief function to write the measurements and results of simulations at several temperatures.
+ *\param directory string holding the name of the directory the output is written to.
+ *\param temperatures vector of the temperatures simulated.
+ *\param data vector of the measurements at each temperature.
+ *\param results vector of the results at each temperature.
+ *
+ * The energy and magnetisation series of every temperature are written to energy-T<temperature>.dat and
+ * magnetisation-T<temperature>.dat, the results at every temperature are written to results.txt and the command
+ * line each under a "Temperature:" heading followed in results.txt by the profile of the run, the profiles are also
+ * written to profile.json, and the tables of results are written with writeTemperatureTables.
+ */
+void writeTemperatureResults(const std::string &directory,
+							 const std::vector<double> &temperatures,
+							 const std::vector<SimulationData> &data,
+							 const std::vector<IsingResults> &results);
+#endif /* writeTemperatureResults_hpp */
@@ -0,0 +1,20 @@
+#include "writeTemperatureTables.hpp"
+#include <fstream>
+
+void writeTemperatureTables(const std::string &directory,
+							const std::vector<double> &temperatures,
+							const std::vector<IsingResults> &results)
+{
+	std::fstream energyTable(directory + "/TE.dat", std::ios::out);
+	std::fstream magnetisationTable(directory + "/TM.dat", std::ios::out);
+	std::fstream susceptibilityTable(directory + "/TX.dat", std::ios::out);
+	std::fstream heatCapacityTable(directory + "/TC.dat", std::ios::out);
+
+	for(int i = 0; i < static_cast<int>(temperatures.size()); ++i)
+	{
+		energyTable 		<< temperatures[i] << ' ' << results[i].energy 		   << ' ' << results[i].energyError 		<< '\n';
+		magnetisationTable 	<< temperatures[i] << ' ' << results[i].magnetisation  << ' ' << results[i].magnetisationError 	<< '\n';
+		susceptibilityTable << temperatures[i] << ' ' << results[i].susceptibility << ' ' << results[i].susceptibilityError << '\n';
+		heatCapacityTable 	<< temperatures[i] << ' ' << results[i].heatCapacity   << ' ' << results[i].heatCapacityError 	<< '\n';
+	}
+}
@@ -0,0 +1,19 @@
+#ifndef writeTemperatureTables_hpp
+#define writeTemperatureTables_hpp
+#include <string>
+#include <vector>
+#include "IsingResults.hpp"
+/**
+ *\file
+ *\brief function to write results at several temperatures as tables for plotting.
+ *\param directory string holding the name of the directory the tables are written to.
+ *\param temperatures vector of the temperatures the results were calculated at.
+ *\param results vector of the results at each temperature.
+ *
+ * Writes TE.dat, TM.dat, TX.dat and TC.dat with one line per temperature of the form "T value error", which
+ * is the same format collate.sh produces so they can be plotted directly with plots.gp.
+ */
+void writeTemperatureTables(const std::string &directory,
+							const std::vector<double> &temperatures,
+							const std::vector<IsingResults> &results);
+#endif /* writeTemperatureTables_hpp */
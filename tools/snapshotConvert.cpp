@@ -0,0 +1,95 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include "SnapshotReader.hpp"
+
+/**
+ *\file
+ *\brief Converts a binary trajectory written with --trajectory to text for plotting.
+ *
+ * snapshot-convert FILE prints the header and the frame table, snapshot-convert FILE FRAME prints one frame in
+ * the same format as spins.dat and snapshot-convert FILE all prints every frame, separated by two blank lines so
+ * gnuplot can select them with index.
+ */
+namespace
+{
+	/**
+	 *\brief Prints a frame as a matrix of +1 and -1 spins.
+	 *\param out the stream to print to.
+	 *\param spins the spin values row by row.
+	 *\param cols the number of columns.
+	 */
+	void printFrame(std::ostream &out, const std::vector<int> &spins, int cols)
+	{
+		for(int site = 0; site < static_cast<int>(spins.size()); ++site)
+		{
+			out << std::showpos << spins[site] << ' ';
+			if((site + 1) % cols == 0)
+			{
+				out << '\n';
+			}
+		}
+		out << std::noshowpos;
+	}
+}
+
+int main(int argc, char const *argv[])
+{
+	if(argc < 2 || argc > 3)
+	{
+		std::cerr << "Usage: " << argv[0] << " FILE [FRAME|all]" << '\n';
+		return 1;
+	}
+
+	SnapshotReader reader;
+	if(!reader.open(argv[1]))
+	{
+		std::cerr << argv[1] << " is not a complete snapshot file." << '\n';
+		return 1;
+	}
+
+	// Without a frame just describe the file.
+	if(argc == 2)
+	{
+		std::cout << "Rows: " << reader.getRows() << '\n';
+		std::cout << "Columns: " << reader.getCols() << '\n';
+		std::cout << "Temperature: " << reader.getTemperature() << '\n';
+		std::cout << "Frames: " << reader.getFrames() << '\n';
+		for(int frame = 0; frame < reader.getFrames(); ++frame)
+		{
+			std::cout << frame << ' ' << reader.getSweep(frame) << ' ' << (reader.isKeyFrame(frame) ? "key" : "delta") << '\n';
+		}
+		return 0;
+	}
+
+	std::string which = argv[2];
+	int first = 0;
+	int last = reader.getFrames();
+	if(which != "all")
+	{
+		first = std::atoi(which.c_str());
+		last = first + 1;
+		if(first < 0 || first >= reader.getFrames())
+		{
+			std::cerr << "Frame " << which << " is out of range, the file has " << reader.getFrames() << " frames." << '\n';
+			return 1;
+		}
+	}
+
+	std::vector<int> spins;
+	for(int frame = first; frame < last; ++frame)
+	{
+		if(!reader.readFrame(frame, spins))
+		{
+			std::cerr << "Frame " << frame << " could not be read." << '\n';
+			return 1;
+		}
+		if(frame > first)
+		{
+			std::cout << "\n\n";
+		}
+		printFrame(std::cout, spins, reader.getCols());
+	}
+	return 0;
+}